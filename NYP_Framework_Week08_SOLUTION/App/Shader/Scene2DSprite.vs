@@ -0,0 +1,36 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aColor;
+layout (location = 2) in vec2 aTexCoord;
+// The transform of each sprite. A mat4 uses locations 3 to 6.
+layout (location = 3) in mat4 aSpriteTransform;
+// The first frame, the number of frames, the columns and the rows of the sprite sheet
+layout (location = 7) in vec4 aSheet;
+// The time within the current play, and the time of each frame
+layout (location = 8) in vec2 aTime;
+// The bottom left corner and the size of the sprite sheet in the texture atlas
+layout (location = 9) in vec4 aAtlas;
+
+out vec2 TexCoord;
+out vec4 Color;
+
+uniform mat4 transform;
+
+void main()
+{
+	gl_Position = transform * aSpriteTransform * vec4(aPos, 1.0);
+	Color = aColor;
+
+	// Select the current frame from the time
+	int numFrames = max(int(aSheet.y), 1);
+	int frame = int(aSheet.x);
+	if (aTime.y > 0.0)
+		frame += min(int(aTime.x / aTime.y), numFrames - 1);
+
+	// Frames are numbered left to right, from the top row of the sprite sheet
+	int cols = max(int(aSheet.z), 1);
+	int rows = max(int(aSheet.w), 1);
+	vec2 frameSize = vec2(1.0 / float(cols), 1.0 / float(rows));
+	vec2 frameMin = vec2(float(frame % cols), float(rows - 1 - frame / cols)) * frameSize;
+	TexCoord = aAtlas.xy + (frameMin + aTexCoord * frameSize) * aAtlas.zw;
+}
\ No newline at end of file
@@ -15,11 +15,15 @@
 	#define GLEW_STATIC
 #endif
 
-#include "GameControl\Settings.h"
+#include "GameControl/Settings.h"
 
 // Inputs
-#include "Inputs\KeyboardController.h"
-#include "Inputs\MouseController.h"
+#include "Inputs/KeyboardController.h"
+#include "Inputs/MouseController.h"
+#include "Inputs/InputRecorder.h"
+
+// Include MyMath to seed the random number generator
+#include "System/MyMath.h"
 
 #include <iostream>
 using namespace std;
@@ -30,6 +34,24 @@ using namespace std;
 // Include SoundController
 #include "SoundController/SoundController.h"
 
+// Include CStreamingBuffer
+#include "RenderControl/StreamingBuffer.h"
+
+// Include CAnimationClipLibrary
+#include "Primitives/AnimationClipLibrary.h"
+
+// Include CBroadphase3D
+#include "Primitives/Broadphase3D.h"
+
+// Include CProfiler and CTraceRecorder
+#include "TimeControl/Profiler.h"
+
+// Include CAllocationTracker
+#include "System/AllocationTracker.h"
+
+// Include CFrameArena
+#include "System/FrameArena.h"
+
 /**
  @brief Define an error callback
  @param error The error code
@@ -51,6 +73,11 @@ static void error_callback(int error, const char* description)
  */
 static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
+	// The recording drives the keyboard during a replay
+	if (CInputRecorder::GetInstance()->IsReplaying())
+		return;
+	CInputRecorder::GetInstance()->RecordKey(key, action);
+
 	CKeyboardController::GetInstance()->Update(key, action);
 }
 
@@ -93,6 +120,11 @@ void resize_callback(GLFWwindow* window, int width, int height)
  */
 void MouseButtonCallbacks(GLFWwindow* window, int button, int action, int mods)
 {
+	// The recording drives the mouse during a replay
+	if (CInputRecorder::GetInstance()->IsReplaying())
+		return;
+	CInputRecorder::GetInstance()->RecordMouseButton(button, action == GLFW_PRESS);
+
 	// Send the callback to the mouse controller to handle
 	if (action == GLFW_PRESS)
 		CMouseController::GetInstance()->UpdateMouseButtonPressed(button);
@@ -108,6 +140,11 @@ void MouseButtonCallbacks(GLFWwindow* window, int button, int action, int mods)
  */
 void MouseScrollCallbacks(GLFWwindow* window, double xoffset, double yoffset)
 {
+	// The recording drives the mouse during a replay
+	if (CInputRecorder::GetInstance()->IsReplaying())
+		return;
+	CInputRecorder::GetInstance()->RecordMouseScroll(xoffset, yoffset);
+
 	CMouseController::GetInstance()->UpdateMouseScroll(xoffset, yoffset);
 }
 
@@ -125,6 +162,53 @@ Application::~Application(void)
  */
 bool Application::Init(void)
 {
+	// Get the CSettings instance
+	cSettings = CSettings::GetInstance();
+
+	// Set the file location for the digital assets
+	// This is backup, in case filesystem cannot find the current directory
+	cSettings->logl_root = "C:/Users/tohdj/Documents/2021_2022_SEM1/DM2213 2D Game Creation/Teaching Materials/NYP_Framework";
+
+	// Start the trace before anything is loaded, so that the loads are recorded too
+	if (cSettings->sTraceFile.empty() == false)
+		CTraceRecorder::GetInstance()->Start(cSettings->sTraceFile);
+
+	// Seed the random number generator before the scene uses it. A replay uses the seed of its
+	// recording, and a recording stores its seed, so that both sessions spawn the same items.
+	CInputRecorder* cInputRecorder = CInputRecorder::GetInstance();
+	if (cSettings->sReplayFile.empty() == false)
+	{
+		if (cInputRecorder->StartReplay(cSettings->sReplayFile) == false)
+		{
+			cout << "Failed to load the recording " << cSettings->sReplayFile << endl;
+			return false;
+		}
+		Math::InitRNG(cInputRecorder->GetSeed());
+	}
+	else if (cSettings->sRecordFile.empty() == false)
+	{
+		const unsigned int uiSeed = (unsigned int)time(NULL);
+		if (cInputRecorder->StartRecording(cSettings->sRecordFile, uiSeed) == false)
+		{
+			cout << "Failed to start recording to " << cSettings->sRecordFile << endl;
+			return false;
+		}
+		Math::InitRNG(uiSeed);
+	}
+
+	// In headless mode, there is no window or OpenGL context, so only the scene is set up
+	if (cSettings->bHeadless == true)
+	{
+		// Load the input script which replaces the keyboard
+		if ((cSettings->sInputScript.empty() == false)
+			&& (cInputScript.Load(cSettings->sInputScript) == false))
+		{
+			cout << "Failed to load the input script " << cSettings->sInputScript << endl;
+			return false;
+		}
+		return InitScene();
+	}
+
 	// glfw: initialize and configure
 	// ------------------------------
 	//Initialize GLFW
@@ -134,13 +218,6 @@ bool Application::Init(void)
 		return false;
 	}
 
-	// Get the CSettings instance
-	cSettings = CSettings::GetInstance();
-
-	// Set the file location for the digital assets
-	// This is backup, in case filesystem cannot find the current directory
-	cSettings->logl_root = "C:/Users/tohdj/Documents/2021_2022_SEM1/DM2213 2D Game Creation/Teaching Materials/NYP_Framework";
-
 	//Set the GLFW window creation hints - these are optional
 	if (cSettings->bUse4XAntiliasing == true)
 		glfwWindowHint(GLFW_SAMPLES, 4); //Request 4x antialiasing
@@ -207,17 +284,53 @@ bool Application::Init(void)
 		return false;
 	}
 
-	// Initialise the cScene2D instance
-	cScene2D = CScene2D::GetInstance();
-	if (cScene2D->Init() == false)
+	// Initialise the CStreamingBuffer instance, which the renderers upload their vertices to
+	if (CStreamingBuffer::GetInstance()->Init() == false)
 	{
-		cout << "Failed to load Scene2D" << endl;
+		cout << "Failed to create the streaming buffer" << endl;
 		return false;
 	}
 
+	return InitScene();
+}
+
+/**
+ @brief Initialise the scene, the FPS counter and the sound. This does not need an OpenGL context in headless mode.
+ @return true if the scene was initialised, else false
+ */
+bool Application::InitScene(void)
+{
+	// Allocate the memory for the temporary data of each frame
+	CFrameArena::GetInstance()->Init();
+
+	if (cSettings->bScene3D == true)
+	{
+		// Initialise the cScene3D instance
+		cScene3D = CScene3D::GetInstance();
+		if (cScene3D->Init() == false)
+		{
+			cout << "Failed to load Scene3D" << endl;
+			return false;
+		}
+	}
+	else
+	{
+		// Initialise the cScene2D instance
+		cScene2D = CScene2D::GetInstance();
+		if (cScene2D->Init() == false)
+		{
+			cout << "Failed to load Scene2D" << endl;
+			return false;
+		}
+	}
+
 	// Initialise the CFPSCounter instance
 	cFPSCounter = CFPSCounter::GetInstance();
 	cFPSCounter->Init();
+	// Count the frames which take more than 2 and 4 times the frame time
+	cFPSCounter->ClearHitchThresholds();
+	cFPSCounter->AddHitchThreshold(cSettings->frameTime * 2.0);
+	cFPSCounter->AddHitchThreshold(cSettings->frameTime * 4.0);
 
 	// Initialise the CSoundController singleton
 	CSoundController::GetInstance()->Init();
@@ -230,61 +343,212 @@ bool Application::Init(void)
 */ 
 void Application::Run(void)
 {
+	// There is no window to render to in headless mode
+	if (cSettings->bHeadless == true)
+	{
+		RunHeadless();
+		return;
+	}
+
 	// Start timer to calculate how long it takes to render this frame
 	cStopWatch.StartTimer();
 
 	double dElapsedTime = 0.0;
-	double dDelayTime = 0.0;
-	double dTotalFrameTime = 0.0;
+
+	// The phases of each frame are timed by the CProfiler
+	CProfiler* cProfiler = CProfiler::GetInstance();
+
+	// The input of each frame is recorded or replayed by the CInputRecorder
+	CInputRecorder* cInputRecorder = CInputRecorder::GetInstance();
 
 	// Render loop
 	while (!glfwWindowShouldClose(cSettings->pWindow)
 		&& (!CKeyboardController::GetInstance()->IsKeyReleased(GLFW_KEY_ESCAPE)))
 	{
+		cProfiler->BeginFrame();
+		CAllocationTracker::BeginFrame();
+
 		// This is to prevent the program from crashing due to long dElapsedTime
 		// Causing Physics to calculate a large jump/fall for the player
 		if (dElapsedTime > 0.0166666666666667)
 			dElapsedTime = 0.0166666666666667;
 
-		// Call the cScene2D's Update method
-		if (cScene2D->Update(dElapsedTime) == false)
+		// Call the scene's Update method
 		{
-			break;
+			PROFILE_SCOPE("Update");
+			CAllocationTracker::BeginUpdate();
+			bool bResult = cScene3D ? cScene3D->Update(dElapsedTime) : cScene2D->Update(dElapsedTime);
+			CAllocationTracker::EndUpdate();
+			if (bResult == false)
+			{
+				break;
+			}
 		}
 
-		// Call the cScene2D's Pre-Render method
-		cScene2D->PreRender();
-
-		// Call the cScene2D's Render method
-		cScene2D->Render();
-
-		// Call the cScene2D's PostRender method
-		cScene2D->PostRender();
+		{
+			PROFILE_SCOPE("Render");
+			ALLOCATION_SCOPE(CAllocationTracker::RENDER);
+
+			// Start a new segment of the streaming buffer
+			CStreamingBuffer::GetInstance()->BeginFrame();
+
+			if (cScene3D)
+			{
+				// Call the cScene3D's Pre-Render, Render and PostRender methods
+				cScene3D->PreRender();
+				cScene3D->Render();
+				cScene3D->PostRender();
+			}
+			else
+			{
+				// Call the cScene2D's Pre-Render method
+				cScene2D->PreRender();
+
+				// Call the cScene2D's Render method
+				cScene2D->Render();
+
+				// Call the cScene2D's PostRender method
+				cScene2D->PostRender();
+			}
+
+			// Fence this frame's segment of the streaming buffer
+			CStreamingBuffer::GetInstance()->EndFrame();
+		}
 
 		// glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
 		// -------------------------------------------------------------------------------
-		glfwSwapBuffers(cSettings->pWindow);
+		{
+			PROFILE_SCOPE("SwapBuffers");
+			glfwSwapBuffers(cSettings->pWindow);
+		}
+
+		double dReplayTime = 0.0;
+		{
+			PROFILE_SCOPE("Input");
+
+			// Perform Post Update Input Devices
+			PostUpdateInputDevices();
+
+			// Poll events. During a replay, the callbacks ignore them.
+			glfwPollEvents();
+
+			// Send the recorded input of this frame during a replay, and stop when it ends
+			if (cInputRecorder->IsReplaying())
+			{
+				if (cInputRecorder->ReplayFrame(dReplayTime) == false)
+					break;
+			}
+			else
+			{
+				// Update Input Devices
+				UpdateInputDevices();
+			}
+		}
+
+		// Frame rate limiter. Sleeps and then spins until the next frame is due, every frameTime ms.
+		{
+			PROFILE_SCOPE("Wait");
+			cStopWatch.WaitForNextFrame(cSettings->frameTime * 0.001);
+		}
+
+		// Calculate the elapsed time since the last frame, including the wait
+		dElapsedTime = cStopWatch.GetElapsedTime();
+
+		// Update the FPS Counter
+		cFPSCounter->Update(dElapsedTime);
+
+		// The next frame is updated with the recorded elapsed time during a replay
+		if (cInputRecorder->IsReplaying())
+			dElapsedTime = dReplayTime;
+		else
+			cInputRecorder->EndFrame(dElapsedTime);
+
+		cProfiler->EndFrame();
+		CAllocationTracker::EndFrame();
+
+		// Free the temporary data of this frame
+		CFrameArena::GetInstance()->Reset();
+	}
+}
+
+/**
+ @brief Run the scene without rendering it, as fast as possible. Each frame advances the scene by the
+		same time step, and the keyboard is driven by the input script, so every run is the same.
+ */
+void Application::RunHeadless(void)
+{
+	// Start timer to calculate how long it takes to simulate each frame
+	cStopWatch.StartTimer();
+
+	double dTotalTime = 0.0;
+	unsigned int uiFrame = 0;
+
+	// The phases of each frame are timed by the CProfiler
+	CProfiler* cProfiler = CProfiler::GetInstance();
+
+	// A replay sends the recorded input and time steps in place of the input script and the fixed
+	// time step. Like in Run, the first frame has no elapsed time.
+	CInputRecorder* cInputRecorder = CInputRecorder::GetInstance();
+	const bool bReplay = cInputRecorder->IsReplaying();
+	double dTimeStep = bReplay ? 0.0 : cSettings->dHeadlessTimeStep;
+
+	// Simulation loop
+	while ((cSettings->uiHeadlessFrames == 0) || (uiFrame < cSettings->uiHeadlessFrames))
+	{
+		cProfiler->BeginFrame();
+		CAllocationTracker::BeginFrame();
+
+		// Send this frame's key events to the keyboard controller, in place of glfwPollEvents
+		if (bReplay == false)
+			cInputScript.Update(uiFrame);
+		if (CKeyboardController::GetInstance()->IsKeyReleased(GLFW_KEY_ESCAPE))
+			break;
+
+		// Limit the recorded time step in the same way as Run
+		if (dTimeStep > 0.0166666666666667)
+			dTimeStep = 0.0166666666666667;
+
+		// Call the cScene2D's Update method
+		{
+			PROFILE_SCOPE("Update");
+			CAllocationTracker::BeginUpdate();
+			bool bResult = cScene2D->Update(dTimeStep);
+			CAllocationTracker::EndUpdate();
+			if (bResult == false)
+			{
+				break;
+			}
+		}
 
 		// Perform Post Update Input Devices
 		PostUpdateInputDevices();
 
-		// Poll events
-		glfwPollEvents();
+		// Update the FPS Counter with the time taken to simulate this frame
+		double dElapsedTime = cStopWatch.GetElapsedTime();
+		cFPSCounter->Update(dElapsedTime);
+		dTotalTime += dElapsedTime;
+		uiFrame++;
 
-		// Update Input Devices
-		UpdateInputDevices();
+		cProfiler->EndFrame();
+		CAllocationTracker::EndFrame();
 
-		// Calculate the elapsed time since the last frame
-		dElapsedTime = cStopWatch.GetElapsedTime();
+		// Free the temporary data of this frame
+		CFrameArena::GetInstance()->Reset();
 
-		// Frame rate limiter. Limits each frame to a specified time in ms by sleeping.  
-		dDelayTime = cSettings->frameTime - dElapsedTime * 1000;
-		cStopWatch.WaitUntil((const long long)dDelayTime);
-
-		// Update the FPS Counter
-		dTotalFrameTime = dElapsedTime + dDelayTime * 0.001;
-		cFPSCounter->Update(dTotalFrameTime);
+		// Send the recorded input of the next frame, and stop when the recording ends
+		if (bReplay && (cInputRecorder->ReplayFrame(dTimeStep) == false))
+			break;
 	}
+
+	cout << "Headless run: " << uiFrame << " frames in " << dTotalTime << " s";
+	if (dTotalTime > 0.0)
+		cout << " (" << uiFrame / dTotalTime << " frames per second)";
+	cout << endl;
+
+	CFPSCounter::SStatistics sStatistics = cFPSCounter->GetStatistics();
+	cout << "Frame times of the last " << sStatistics.uiCount << " frames: min " << sStatistics.fMin
+		<< " ms, p50 " << sStatistics.fP50 << " ms, p95 " << sStatistics.fP95
+		<< " ms, p99 " << sStatistics.fP99 << " ms, max " << sStatistics.fMax << " ms" << endl;
 }
 
 /**
@@ -298,6 +562,10 @@ void Application::Destroy(void)
 	// Destroy the CFPSCounter instance
 	if (cFPSCounter)
 	{
+		// Save the frame time statistics of the session
+		if (cSettings->sFrameTimeReport.empty() == false)
+			cFPSCounter->SaveReport(cSettings->sFrameTimeReport);
+
 		cFPSCounter->Destroy();
 		cFPSCounter = NULL;
 	}
@@ -309,10 +577,123 @@ void Application::Destroy(void)
 		cScene2D = NULL;
 	}
 
-	//Close OpenGL window and terminate GLFW
-	glfwDestroyWindow(cSettings->pWindow);
-	//Finalize and clean up GLFW
-	glfwTerminate();
+	// Destroy the cScene3D instance
+	if (cScene3D)
+	{
+		cScene3D->Destroy();
+		cScene3D = NULL;
+	}
+
+	// Destroy the CBroadphase3D instance, after the entities which remove themselves from it
+	CBroadphase3D::GetInstance()->Destroy();
+
+	// Destroy the CAnimationClipLibrary instance, after the sprites which share its clips
+	CAnimationClipLibrary::GetInstance()->Destroy();
+
+	// Destroy the CStreamingBuffer instance
+	CStreamingBuffer::GetInstance()->Destroy();
+
+	// Destroy the CProfiler instance
+	CProfiler::GetInstance()->Destroy();
+
+	// Print the allocations of the session
+	CAllocationTracker::PrintSummary();
+
+	// Destroy the CFrameArena instance, after the scene which uses it
+	CFrameArena::GetInstance()->Destroy();
+
+	// Destroy the CTraceRecorder instance, which completes the trace file if it is recording
+	CTraceRecorder::GetInstance()->Destroy();
+
+	// Destroy the CInputRecorder instance, which completes the recording
+	CInputRecorder::GetInstance()->Destroy();
+
+	// There is no window in headless mode
+	if (cSettings->bHeadless == false)
+	{
+		//Close OpenGL window and terminate GLFW
+		glfwDestroyWindow(cSettings->pWindow);
+		//Finalize and clean up GLFW
+		glfwTerminate();
+	}
+}
+
+/**
+ @brief Read the command line arguments into CSettings. Call this before Init.
+		--headless		Run the scene without a window, an OpenGL context or sound output
+		--frames <n>	Stop after n frames in headless mode
+		--input <file>	Drive the keyboard with the input script in a file in headless mode
+		--trace <file>	Record a trace of the session into a file, from the start
+		--frame-times <file>	Save the frame time statistics to a CSV or JSON file on exit
+		--record <file>	Record the keyboard and mouse input and the random seed into a file
+		--replay <file>	Replay a recording in place of the keyboard and mouse, with or without a window
+		--scene3d		Show the 3D field of structures instead of the 2D game. This needs a window.
+ @param argc A const int containing the number of arguments
+ @param argv A char* array containing the arguments. The first one is the name of the program.
+ @return true if the arguments are valid, else false
+ */
+bool Application::ParseArguments(const int argc, char* argv[])
+{
+	cSettings = CSettings::GetInstance();
+	for (int i = 1; i < argc; i++)
+	{
+		string sArgument = argv[i];
+		if (sArgument == "--headless")
+		{
+			cSettings->bHeadless = true;
+		}
+		else if ((sArgument == "--frames") && (i + 1 < argc))
+		{
+			cSettings->uiHeadlessFrames = (unsigned int)strtoul(argv[++i], NULL, 10);
+		}
+		else if ((sArgument == "--input") && (i + 1 < argc))
+		{
+			cSettings->sInputScript = argv[++i];
+		}
+		else if ((sArgument == "--trace") && (i + 1 < argc))
+		{
+			cSettings->sTraceFile = argv[++i];
+		}
+		else if ((sArgument == "--frame-times") && (i + 1 < argc))
+		{
+			cSettings->sFrameTimeReport = argv[++i];
+		}
+		else if ((sArgument == "--record") && (i + 1 < argc))
+		{
+			cSettings->sRecordFile = argv[++i];
+		}
+		else if ((sArgument == "--replay") && (i + 1 < argc))
+		{
+			cSettings->sReplayFile = argv[++i];
+		}
+		else if (sArgument == "--scene3d")
+		{
+			cSettings->bScene3D = true;
+		}
+		else
+		{
+			cout << "Unknown argument " << sArgument << endl;
+			cout << "Usage: " << argv[0] << " [--headless] [--frames <n>] [--input <file>] [--trace <file>]"
+				<< " [--frame-times <file>] [--record <file> | --replay <file>] [--scene3d]" << endl;
+			return false;
+		}
+	}
+
+	// The input is recorded from the window, and a session cannot be recorded while it is replayed
+	if ((cSettings->sRecordFile.empty() == false)
+		&& (cSettings->bHeadless || (cSettings->sReplayFile.empty() == false)))
+	{
+		cout << "--record cannot be used with --headless or --replay" << endl;
+		return false;
+	}
+
+	// The 3D scene loads its meshes into OpenGL buffers, so it needs a window
+	if ((cSettings->bScene3D) && (cSettings->bHeadless))
+	{
+		cout << "--scene3d cannot be used with --headless" << endl;
+		return false;
+	}
+	return true;
 }
 
 /**
@@ -335,7 +716,9 @@ int Application::GetWindowWidth(void) const
  @brief Constructor
  */
 Application::Application(void)
-	: cFPSCounter(NULL)
+	: cScene2D(NULL)
+	, cScene3D(NULL)
+	, cFPSCounter(NULL)
 {
 }
 
@@ -347,6 +730,7 @@ void Application::UpdateInputDevices(void)
 	// Update Mouse Position
 	double dMouse_X, dMouse_Y;
 	glfwGetCursorPos( cSettings->pWindow, &dMouse_X, &dMouse_Y);
+	CInputRecorder::GetInstance()->RecordMousePosition(dMouse_X, dMouse_Y);
 	CMouseController::GetInstance()->UpdateMousePosition( dMouse_X, dMouse_Y);
 }
 
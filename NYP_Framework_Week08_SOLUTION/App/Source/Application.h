@@ -6,13 +6,17 @@
 #pragma once
 
 // Include SingletonTemplate
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 
-#include "TimeControl\StopWatch.h"
-#include "Scene2D\Scene2D.h"
+#include "TimeControl/StopWatch.h"
+#include "Scene2D/Scene2D.h"
+#include "Scene3D/Scene3D.h"
 
 // FPS Counter
-#include "TimeControl\FPSCounter.h"
+#include "TimeControl/FPSCounter.h"
+
+// Input script for headless mode
+#include "Inputs/InputScript.h"
 
 struct GLFWwindow;
 
@@ -22,6 +26,8 @@ class Application : public CSingletonTemplate<Application>
 {
 	friend CSingletonTemplate<Application>;
 public:
+	// Read the command line arguments into CSettings
+	bool ParseArguments(const int argc, char* argv[]);
 	// Initialise this class instance
 	bool Init(void);
 	// Run this class instance
@@ -42,15 +48,25 @@ protected:
 	CSettings* cSettings;
 	// The handler to the CScene2D instance
 	CScene2D* cScene2D;
+	// The handler to the CScene3D instance, which replaces cScene2D if CSettings::bScene3D is set
+	CScene3D* cScene3D;
 	// The handler to the CFPSCounter instance
 	CFPSCounter* cFPSCounter;
 
+	// The keyboard input in headless mode
+	CInputScript cInputScript;
+
 	// Constructor
 	Application(void);
 
 	// Destructor
 	virtual ~Application(void);
 
+	// Initialise the scene
+	bool InitScene(void);
+	// Run the scene without rendering it
+	void RunHeadless(void);
+
 	// Update input devices
 	void UpdateInputDevices(void);
 	void PostUpdateInputDevices(void);
@@ -9,14 +9,18 @@
 using namespace std;
 
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
 
-// Include ImageLoader
-#include "System\ImageLoader.h"
+// Include SpriteBatch2D
+#include "RenderControl/SpriteBatch2D.h"
+
+// Include SpriteInstancer2D
+#include "RenderControl/SpriteInstancer2D.h"
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
 #include "Primitives/MeshBuilder.h"
+#include "Primitives/AnimationClipLibrary.h"
 
 // Include Game Manager
 #include "GameManager.h"
@@ -27,6 +31,7 @@ using namespace std;
 CBomb2D::CBomb2D(void)
 	: cMap2D(NULL)
 	, cSoundController(NULL)
+	, animatedSprites(NULL)
 {
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 
@@ -53,8 +58,16 @@ CBomb2D::~CBomb2D(void)
 	// We won't delete this since it was created elsewhere
 	cMap2D = NULL;
 
+	//CS: Delete the animated sprite. Its buffers are deleted by CMeshBuilder once no other sprite is using them.
+	if (animatedSprites)
+	{
+		delete animatedSprites;
+		animatedSprites = NULL;
+	}
+
 	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
+	if (VAO != 0)
+		glDeleteVertexArrays(1, &VAO);
 }
 
 /**
@@ -81,18 +94,29 @@ bool CBomb2D::Init(CPhysics2D::GRAVITY_DIRECTION dir, int x, int y)
 	// By default, microsteps should be zero
 	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
+	// There is no OpenGL context in headless mode
+	if (cSettings->bHeadless == false)
+	{
+		glGenVertexArrays(1, &VAO);
+		glBindVertexArray(VAO);
+	}
 	
 
-	if (LoadTexture("Image/scene2d_bomb.tga", iTextureID) == false)
+	//CS: Create the animated sprite and setup the animation 
+	animatedSprites = CMeshBuilder::GenerateSpriteAnimation(1, 1, cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT, cSettings->bGPUSpriteAnimation);
+	// The bomb uses the bomb tile's texture in the map's texture atlas
+	if (cMap2D->SetSpriteSheet(animatedSprites, std::to_string(CMap2D::BOMB_SMALL), iTextureID) == false)
 	{
 		std::cout << "Failed to bomb texture texture" << std::endl;
 	}
-	//CS: Create the animated sprite and setup the animation 
-	animatedSprites = CMeshBuilder::GenerateSpriteAnimation(1, 1, cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
-	animatedSprites->AddAnimation("idle", 0, 1);
-	animatedSprites->PlayAnimation("idle", -1, enemySpeed);
+	//CS: All the bombs share the same animation clips
+	CAnimationClipSet* cClipSet = CAnimationClipLibrary::GetInstance()->GetClipSet("Bomb2D");
+	if (cClipSet->GetNumClips() == 0)
+	{
+		cClipSet->AddClip("idle", 0, 1);
+	}
+	animatedSprites->SetClipSet(cClipSet);
+	animatedSprites->PlayAnimation(cClipSet->GetClipHandle("idle"), -1, enemySpeed);
 
 
 	
@@ -253,8 +277,7 @@ void CBomb2D::Update(const double dElapsedTime)
 	// Update the Health and Lives
 	UpdateHealthLives();
 
-	//CS: Update the animated sprite
-	animatedSprites->Update(dElapsedTime);
+	//CS: The animated sprite is updated by CEntityManager2D, together with those of the other entities
 
 	// Update the UV Coordinates
 	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, i32vec2Index.x, false, i32vec2NumMicroSteps.x*cSettings->MICRO_STEP_XAXIS);
@@ -522,43 +545,30 @@ void CBomb2D::PostRender(void)
 }
 
 /**
-@brief Load a texture, assign it a code and store it in MapOfTextureIDs.
-@param filename A const char* variable which contains the file name of the texture
-*/
-bool CBomb2D::LoadTexture(const char* filename, GLuint& iTextureID)
+ @brief Get the animated sprite of this instance
+ @return The CSpriteAnimation of this instance
+ */
+CSpriteAnimation* CBomb2D::GetAnimatedSprites(void) const
 {
-	// Variables used in loading the texture
-	int width, height, nrChannels;
-	
-	// texture 1
-	// ---------
-	glGenTextures(1, &iTextureID);
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-	// set the texture wrapping parameters
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	// set texture filtering parameters
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-	CImageLoader* cImageLoader = CImageLoader::GetInstance();
-	unsigned char *data = cImageLoader->Load(filename, width, height, nrChannels, true);
-	if (data)
-	{
-		if (nrChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-		else if (nrChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+	return animatedSprites;
+}
 
-		// Generate mipmaps
-		glGenerateMipmap(GL_TEXTURE_2D);
-	}
+/**
+ @brief Add this instance to the CSpriteBatch2D, which draws all the sprites with the same texture together
+ @return true as this instance does not need to be rendered by itself
+ */
+bool CBomb2D::SubmitSprite(void)
+{
+	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
+	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
+													vec2UVCoordinate.y,
+													0.0f));
+
+	// The vertex shader selects the frame if the sprite is a single quad
+	if (animatedSprites->IsGPUFrameSelection())
+		CSpriteInstancer2D::GetInstance()->Submit(iTextureID, animatedSprites, transform, currentColor);
 	else
-	{
-		return false;
-	}
-	// Free up the memory of the file data read in
-	free(data);
+		CSpriteBatch2D::GetInstance()->Submit(iTextureID, animatedSprites, transform, currentColor);
 
 	return true;
 }
@@ -6,7 +6,7 @@
 #pragma once
 
 // Include Singleton template
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 
 // Include GLEW
 #ifndef GLEW_STATIC
@@ -26,7 +26,7 @@
 class CMap2D;
 
 // Include Keyboard controller
-#include "Inputs\KeyboardController.h"
+#include "Inputs/KeyboardController.h"
 
 // Include Physics2D
 #include "Physics2D.h"
@@ -38,7 +38,7 @@ class CMap2D;
 #include "InventoryManager.h"
 
 // Include SoundController
-#include "..\SoundController\SoundController.h"
+#include "../SoundController/SoundController.h"
 
 class CBomb2D : public CEntity2D
 {
@@ -65,6 +65,12 @@ public:
 	// PostRender
 	void PostRender(void);
 
+	// Add this instance to the CSpriteBatch2D instead of rendering it by itself
+	bool SubmitSprite(void);
+
+	// Get the animated sprite of this instance
+	CSpriteAnimation* GetAnimatedSprites(void) const;
+
 	// Constructor
 	CBomb2D(void);
 
@@ -97,9 +103,6 @@ protected:
 	// Let enemy interact with the map
 	void InteractWithMap(void);
 
-	// Load a texture
-	bool LoadTexture(const char* filename, GLuint& iTextureID);
-
 	// Update the health and lives
 	void UpdateHealthLives(void);
 
@@ -9,14 +9,18 @@
 using namespace std;
 
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
 
-// Include ImageLoader
-#include "System\ImageLoader.h"
+// Include SpriteBatch2D
+#include "RenderControl/SpriteBatch2D.h"
+
+// Include SpriteInstancer2D
+#include "RenderControl/SpriteInstancer2D.h"
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
 #include "Primitives/MeshBuilder.h"
+#include "Primitives/AnimationClipLibrary.h"
 
 // Include Game Manager
 #include "GameManager.h"
@@ -27,6 +31,7 @@ using namespace std;
 CEnemy2D::CEnemy2D(void)
 	: cMap2D(NULL)
 	, cSoundController(NULL)
+	, animatedSprites(NULL)
 {
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 
@@ -71,8 +76,16 @@ CEnemy2D::~CEnemy2D(void)
 	// We won't delete this since it was created elsewhere
 	cMap2D = NULL;
 
+	//CS: Delete the animated sprite. Its buffers are deleted by CMeshBuilder once no other sprite is using them.
+	if (animatedSprites)
+	{
+		delete animatedSprites;
+		animatedSprites = NULL;
+	}
+
 	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
+	if (VAO != 0)
+		glDeleteVertexArrays(1, &VAO);
 }
 
 /**
@@ -104,24 +117,37 @@ bool CEnemy2D::Init(ENEMY_TYPE type)
 	// By default, microsteps should be zero
 	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
+	// There is no OpenGL context in headless mode
+	if (cSettings->bHeadless == false)
+	{
+		glGenVertexArrays(1, &VAO);
+		glBindVertexArray(VAO);
+	}
 	
 	// Load the player texture
 	switch (type)
 	{
 	case ENEMY_GOLEM:
-		if (LoadTexture("Image/scene2d_golemenemy.png", iTextureID) == false)
+		//CS: Create the animated sprite and setup the animation 
+		//CS: The map's texture atlas has the golem's 40 frames in 5 rows of 8
+		animatedSprites = CMeshBuilder::GenerateSpriteAnimation(5, 8, cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT, cSettings->bGPUSpriteAnimation);
+		if (cMap2D->SetSpriteSheet(animatedSprites, "Enemy2D_Golem", iTextureID) == false)
 		{
 			std::cout << "Failed to load golem tile texture" << std::endl;
 			return false;
 		}
-		//CS: Create the animated sprite and setup the animation 
-		animatedSprites = CMeshBuilder::GenerateSpriteAnimation(1, 40, cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
-		animatedSprites->AddAnimation("idle", 0, 11);
-		animatedSprites->AddAnimation("right", 12, 40);
-		//CS: Play the "idle" animation as default
-		animatedSprites->PlayAnimation("idle", -1, enemySpeed);
+		//CS: All the golems share the same animation clips
+		{
+			CAnimationClipSet* cClipSet = CAnimationClipLibrary::GetInstance()->GetClipSet("Enemy2D_Golem");
+			if (cClipSet->GetNumClips() == 0)
+			{
+				cClipSet->AddClip("idle", 0, 11);
+				cClipSet->AddClip("right", 12, 40);
+			}
+			animatedSprites->SetClipSet(cClipSet);
+			//CS: Play the "idle" animation as default
+			animatedSprites->PlayAnimation(cClipSet->GetClipHandle("idle"), -1, enemySpeed);
+		}
 		break;
 	default:
 		std::cout << "Failed to load enemy tile texture (None found)" << std::endl;
@@ -156,8 +182,7 @@ void CEnemy2D::Update(const double dElapsedTime)
 	// Update the Health and Lives
 	UpdateHealthLives();
 
-	//CS: Update the animated sprite
-	animatedSprites->Update(dElapsedTime);
+	//CS: The animated sprite is updated by CEntityManager2D, together with those of the other entities
 
 	// Update the UV Coordinates
 	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, i32vec2Index.x, false, i32vec2NumMicroSteps.x*cSettings->MICRO_STEP_XAXIS);
@@ -219,43 +244,30 @@ void CEnemy2D::PostRender(void)
 }
 
 /**
-@brief Load a texture, assign it a code and store it in MapOfTextureIDs.
-@param filename A const char* variable which contains the file name of the texture
-*/
-bool CEnemy2D::LoadTexture(const char* filename, GLuint& iTextureID)
+ @brief Get the animated sprite of this instance
+ @return The CSpriteAnimation of this instance
+ */
+CSpriteAnimation* CEnemy2D::GetAnimatedSprites(void) const
 {
-	// Variables used in loading the texture
-	int width, height, nrChannels;
-	
-	// texture 1
-	// ---------
-	glGenTextures(1, &iTextureID);
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-	// set the texture wrapping parameters
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	// set texture filtering parameters
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-	CImageLoader* cImageLoader = CImageLoader::GetInstance();
-	unsigned char *data = cImageLoader->Load(filename, width, height, nrChannels, true);
-	if (data)
-	{
-		if (nrChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-		else if (nrChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+	return animatedSprites;
+}
 
-		// Generate mipmaps
-		glGenerateMipmap(GL_TEXTURE_2D);
-	}
+/**
+ @brief Add this instance to the CSpriteBatch2D, which draws all the sprites with the same texture together
+ @return true as this instance does not need to be rendered by itself
+ */
+bool CEnemy2D::SubmitSprite(void)
+{
+	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
+	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
+													vec2UVCoordinate.y,
+													0.0f));
+
+	// The vertex shader selects the frame if the sprite is a single quad
+	if (animatedSprites->IsGPUFrameSelection())
+		CSpriteInstancer2D::GetInstance()->Submit(iTextureID, animatedSprites, transform, currentColor);
 	else
-	{
-		return false;
-	}
-	// Free up the memory of the file data read in
-	free(data);
+		CSpriteBatch2D::GetInstance()->Submit(iTextureID, animatedSprites, transform, currentColor);
 
 	return true;
 }
@@ -6,7 +6,7 @@
 #pragma once
 
 // Include Singleton template
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 
 // Include GLEW
 #ifndef GLEW_STATIC
@@ -26,7 +26,7 @@
 class CMap2D;
 
 // Include Keyboard controller
-#include "Inputs\KeyboardController.h"
+#include "Inputs/KeyboardController.h"
 
 // Include Physics2D
 #include "Physics2D.h"
@@ -41,7 +41,7 @@ class CMap2D;
 #include "InventoryManager.h"
 
 // Include SoundController
-#include "..\SoundController\SoundController.h"
+#include "../SoundController/SoundController.h"
 
 class CEnemy2D : public CEntity2D
 {
@@ -68,6 +68,12 @@ public:
 	// PostRender
 	void PostRender(void);
 
+	// Add this instance to the CSpriteBatch2D instead of rendering it by itself
+	bool SubmitSprite(void);
+
+	// Get the animated sprite of this instance
+	CSpriteAnimation* GetAnimatedSprites(void) const;
+
 	void CollidedWith(CEntity2D*);
 
 	// Constructor
@@ -110,9 +116,6 @@ protected:
 	// Let enemy interact with the map
 	void InteractWithMap(void);
 
-	// Load a texture
-	bool LoadTexture(const char* filename, GLuint& iTextureID);
-
 	// Update the health and lives
 	void UpdateHealthLives(void);
 };
@@ -9,10 +9,10 @@
 using namespace std;
 
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
 
 // Include ImageLoader
-#include "System\ImageLoader.h"
+#include "System/ImageLoader.h"
 
 // Include Math
 #include "System/MyMath.h"
@@ -24,15 +24,24 @@ using namespace std;
 // Include Game Manager
 #include "GameManager.h"
 
+// Include CProfiler
+#include "TimeControl/Profiler.h"
+
+// Include CAllocationTracker
+#include "System/AllocationTracker.h"
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
 CEntityManager2D::CEntityManager2D(void)
-	: cMap2D(NULL)
+	: cAABBBatch(2, false)
+	, cMap2D(NULL)
 	, cKeyboardController(NULL)
 	, cInventoryManager(NULL)
 	, cInventoryItem(NULL)
 	, cSoundController(NULL)
+	, cSpriteBatch2D(NULL)
+	, cSpriteInstancer2D(NULL)
 {
 }
 
@@ -41,6 +50,12 @@ CEntityManager2D::CEntityManager2D(void)
  */
 CEntityManager2D::~CEntityManager2D(void)
 {
+	// We won't delete this since it was created elsewhere
+	cSpriteBatch2D = NULL;
+
+	// We won't delete this since it was created elsewhere
+	cSpriteInstancer2D = NULL;
+
 	// We won't delete this since it was created elsewhere
 	cSoundController = NULL;
 
@@ -70,6 +85,26 @@ bool CEntityManager2D::Init(void)
 
 	cMap2D = CMap2D::GetInstance();
 
+	// The entities are not drawn in headless mode, so the renderers are not needed
+	if (cSettings->bHeadless == false)
+	{
+		// Get the handler to the CSpriteBatch2D
+		cSpriteBatch2D = CSpriteBatch2D::GetInstance();
+		if (cSpriteBatch2D->Init() == false)
+		{
+			cout << "Failed to initialise CSpriteBatch2D" << endl;
+			return false;
+		}
+
+		// Get the handler to the CSpriteInstancer2D
+		cSpriteInstancer2D = CSpriteInstancer2D::GetInstance();
+		if (cSpriteInstancer2D->Init() == false)
+		{
+			cout << "Failed to initialise CSpriteInstancer2D" << endl;
+			return false;
+		}
+	}
+
 	for (int i = 0; i < 100; ++i)
 	{
 		entities.push_back(nullptr);
@@ -84,49 +119,96 @@ bool CEntityManager2D::Init(void)
  */
 void CEntityManager2D::Update(const double dElapsedTime)
 {
+	PROFILE_SCOPE("EntityManager2D::Update");
+	ALLOCATION_SCOPE(CAllocationTracker::ENTITIES);
+
+	// Store the boxes of all the entities, so that each entity is tested against all of them at once
+	cAABBBatch.Resize((unsigned int)entities.size());
+	for (unsigned int i = 0; i < entities.size(); ++i)
+		UpdateEntityBox(i);
 
-	std::vector<CEntity2D*>::iterator it;
-	for (it = entities.begin(); it != entities.end(); ++it)
+	for (unsigned int i = 0; i < entities.size(); ++i)
 	{
-		if ((*it) == nullptr) continue;
-		if ((*it)->dead)
+		CEntity2D* entity = entities[i];
+		if (entity == nullptr) continue;
+		if (entity->dead)
 		{
-			delete (*it);
-			(*it) = nullptr;
+			delete entity;
+			entities[i] = nullptr;
+			cAABBBatch.SetEmpty(i);
 			continue;
 		}
 
-		(*it)->Update(dElapsedTime);
+		{
+			PROFILE_SCOPE("Entity2D::Update");
+			entity->Update(dElapsedTime);
+		}
+		UpdateEntityBox(i);
 
 		//Collision
-		for (auto& coll : entities)
+		PROFILE_SCOPE("Collision");
+		float arrMin[2] = { entity->i32vec2Index.x + entity->i32vec2NumMicroSteps.x * 0.25f,
+							entity->i32vec2Index.y + entity->i32vec2NumMicroSteps.y * 0.25f };
+		float arrMax[2] = { arrMin[0] + 1.0f, arrMin[1] + 1.0f };
+		cAABBBatch.Test(arrMin, arrMax, vCollisionMask, vCollisionIndices);
+
+		for (unsigned int j = 0; j < vCollisionIndices.size(); ++j)
 		{
-			if (coll != nullptr && coll != (*it))
+			CEntity2D* coll = entities[vCollisionIndices[j]];
+			if (coll != nullptr && coll != entity)
 			{
-				float entity_x = (*it)->i32vec2Index.x + (*it)->i32vec2NumMicroSteps.x * 0.25f;
-				float entity_y = (*it)->i32vec2Index.y + (*it)->i32vec2NumMicroSteps.y * 0.25f;
-				float coll_x = coll->i32vec2Index.x + coll->i32vec2NumMicroSteps.x * 0.25f;
-				float coll_y = coll->i32vec2Index.y + coll->i32vec2NumMicroSteps.y * 0.25f;
-				float width = 1.0f;
-				if (entity_x <= coll_x + width &&
-					entity_x + width > coll_x &&
-					entity_y <= coll_y + width &&
-					entity_y + width > coll_y)
-				{
-					//Collision Detected
-					coll->CollidedWith((*it));
-					(*it)->CollidedWith(coll);
-				}
+				//Collision Detected
+				coll->CollidedWith(entity);
+				entity->CollidedWith(coll);
+
+				// The response may have moved the other entity
+				UpdateEntityBox(vCollisionIndices[j]);
 			}
 		}
+		UpdateEntityBox(i);
 	}
+
+	// Update the animated sprites of all the entities in one pass
+	PROFILE_SCOPE("Animation");
+	vAnimatedSprites.clear();
+	for (unsigned int i = 0; i < entities.size(); ++i)
+	{
+		if (entities[i] != nullptr && !entities[i]->dead)
+			vAnimatedSprites.push_back(entities[i]->GetAnimatedSprites());
+	}
+	if (!vAnimatedSprites.empty())
+		CSpriteAnimation::UpdateBatch(&vAnimatedSprites[0], (unsigned int)vAnimatedSprites.size(), dElapsedTime);
+}
+
+/**
+ @brief Update the box of the entity at an index in entities. Each entity is 1 tile wide.
+ @param uiIndex A const unsigned int containing the index of the entity
+ */
+void CEntityManager2D::UpdateEntityBox(const unsigned int uiIndex)
+{
+	if (uiIndex >= cAABBBatch.GetSize())
+		return;
+
+	CEntity2D* entity = entities[uiIndex];
+	if (entity == nullptr)
+	{
+		cAABBBatch.SetEmpty(uiIndex);
+		return;
+	}
+
+	float arrMin[2] = { entity->i32vec2Index.x + entity->i32vec2NumMicroSteps.x * 0.25f,
+						entity->i32vec2Index.y + entity->i32vec2NumMicroSteps.y * 0.25f };
+	float arrMax[2] = { arrMin[0] + 1.0f, arrMin[1] + 1.0f };
+	cAABBBatch.SetBox(uiIndex, arrMin, arrMax);
 }
 
 void CEntityManager2D::AddEntity(CEntity2D* entity)
 {
-	for (auto& tE : entities) {
-		if (tE == nullptr) {
-			tE = entity;
+	for (unsigned int i = 0; i < entities.size(); ++i) {
+		if (entities[i] == nullptr) {
+			entities[i] = entity;
+			// Entities added during Update can be collided with straight away
+			UpdateEntityBox(i);
 			break;
 		}
 	}
@@ -134,15 +216,26 @@ void CEntityManager2D::AddEntity(CEntity2D* entity)
 
 void CEntityManager2D::RenderEntities()
 {
+	PROFILE_SCOPE("EntityManager2D::RenderEntities");
+
+	// Animated entities are collected into the sprite batch and drawn together, one draw call per texture
+	// Sprites whose frames are selected by the vertex shader are drawn with instancing instead
+	cSpriteBatch2D->Begin();
+	cSpriteInstancer2D->Begin();
 	for (auto& entity : entities)
 	{
 		if (entity != nullptr && !entity->dead)
 		{
+			if (entity->SubmitSprite())
+				continue;
+
 			entity->PreRender();
 			entity->Render();
 			entity->PostRender();
 		}
 	}
+	cSpriteBatch2D->Render();
+	cSpriteInstancer2D->Render();
 }
 
 void CEntityManager2D::Exit()
@@ -6,7 +6,7 @@
 #pragma once
 
 // Include Singleton template
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 
 // Include GLEW
 #ifndef GLEW_STATIC
@@ -23,7 +23,7 @@
 class CMap2D;
 
 // Include Keyboard controller
-#include "Inputs\KeyboardController.h"
+#include "Inputs/KeyboardController.h"
 
 // Include Physics2D
 #include "Physics2D.h"
@@ -41,7 +41,19 @@ class CMap2D;
 #include "InventoryManager.h"
 
 // Include SoundController
-#include "..\SoundController\SoundController.h"
+#include "../SoundController/SoundController.h"
+
+// Include AABBBatch
+#include "Primitives/AABBBatch.h"
+
+// Include CAllocationTracker for the tagged containers
+#include "System/AllocationTracker.h"
+
+// Include SpriteBatch2D
+#include "RenderControl/SpriteBatch2D.h"
+
+// Include SpriteInstancer2D
+#include "RenderControl/SpriteInstancer2D.h"
 
 
 class CEntityManager2D : public CSingletonTemplate<CEntityManager2D>
@@ -63,7 +75,18 @@ public:
 protected:
 
 	//Collider Codes - To be moved into Collider singleton class when have time
-	std::vector<CEntity2D*> entities;
+	CTaggedVector<CEntity2D*, CAllocationTracker::ENTITIES> entities;
+
+	// The boxes of the entities, with the same index as in entities
+	CAABBBatch cAABBBatch;
+	// Scratch space for the results of cAABBBatch
+	std::vector<unsigned int> vCollisionMask;
+	std::vector<unsigned int> vCollisionIndices;
+	// Scratch space for the animated sprites of the entities, which are updated together
+	CTaggedVector<CSpriteAnimation*, CAllocationTracker::ENTITIES> vAnimatedSprites;
+
+	// Update the box of the entity at an index in entities
+	void UpdateEntityBox(const unsigned int uiIndex);
 
 	// Handler to the CMap2D instance
 	CMap2D* cMap2D;
@@ -90,6 +113,12 @@ protected:
 	// Handler to the CSoundController
 	CSoundController* cSoundController;
 
+	// Handler to the CSpriteBatch2D
+	CSpriteBatch2D* cSpriteBatch2D;
+
+	// Handler to the CSpriteInstancer2D
+	CSpriteInstancer2D* cSpriteInstancer2D;
+
 	// Constructor
 	CEntityManager2D(void);
 
@@ -5,6 +5,17 @@
  */
 #include "GUI_Scene2D.h"
 
+// Include Keyboard controller
+#include "Inputs/KeyboardController.h"
+
+// Include CAllocationTracker
+#include "System/AllocationTracker.h"
+
+// Include CMap2D, whose texture atlas has the inventory icons and which counts the tiles it draws
+#include "Map2D.h"
+
+#include <cmath>
+#include <cstdio>
 #include <iostream>
 using namespace std;
 
@@ -16,6 +27,8 @@ CGUI_Scene2D::CGUI_Scene2D(void)
 	, m_fProgressBar(0.0f)
 	, cInventoryManager(NULL)
 	, cInventoryItem(NULL)
+	, cProfiler(NULL)
+	, bShowProfiler(false)
 {
 }
 
@@ -43,6 +56,9 @@ CGUI_Scene2D::~CGUI_Scene2D(void)
 		if (cSettings->bShowMousePointer == false)
 			glfwSetInputMode(cSettings->pWindow, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
 
+	// We won't delete this since it was created elsewhere
+	cProfiler = NULL;
+
 	// We won't delete this since it was created elsewhere
 	cSettings = NULL;
 }
@@ -58,6 +74,9 @@ bool CGUI_Scene2D::Init(void)
 	// Store the CFPSCounter singleton instance here
 	cFPSCounter = CFPSCounter::GetInstance();
 
+	// Store the CProfiler singleton instance here
+	cProfiler = CProfiler::GetInstance();
+
 	// Setup Dear ImGui context
 	IMGUI_CHECKVERSION();
 	ImGui::CreateContext();
@@ -86,17 +105,23 @@ bool CGUI_Scene2D::Init(void)
 	// Initialise the cInventoryManager
 	cInventoryManager = CInventoryManager::GetInstance();
 	// Add a Tree as one of the inventory items
-	cInventoryItem = cInventoryManager->Add("Tree", "Image/Scene2D_TreeTile.tga", 5, 0);
+	// The icons are drawn from the map's texture atlas, and the Tree, Bomb and DoubleJump icons use the tiles' textures
+	CMap2D* cMap2D = CMap2D::GetInstance();
+	cInventoryItem = cInventoryManager->Add("Tree", NULL, 5, 0);
 	cInventoryItem->vec2Size = glm::vec2(25, 25);
+	cMap2D->SetInventoryIcon(cInventoryItem, std::to_string(2));
 
-	cInventoryItem = cInventoryManager->Add("Bomb", "Image/scene2d_bomb.tga", 5, 0);
+	cInventoryItem = cInventoryManager->Add("Bomb", NULL, 5, 0);
 	cInventoryItem->vec2Size = glm::vec2(25, 25);
+	cMap2D->SetInventoryIcon(cInventoryItem, std::to_string(CMap2D::BOMB_SMALL));
 
-	cInventoryItem = cInventoryManager->Add("EnemyHealth", "Image/scene2d_golemenemy_icon.png", 100, 100);
+	cInventoryItem = cInventoryManager->Add("EnemyHealth", NULL, 100, 100);
 	cInventoryItem->vec2Size = glm::vec2(25, 25);
+	cMap2D->SetInventoryIcon(cInventoryItem, "EnemyHealth");
 
-	cInventoryItem = cInventoryManager->Add("DoubleJump", "Image/scene2d_jumpboost.png", 100, 0);
+	cInventoryItem = cInventoryManager->Add("DoubleJump", NULL, 100, 0);
 	cInventoryItem->vec2Size = glm::vec2(25, 25);
+	cMap2D->SetInventoryIcon(cInventoryItem, std::to_string(CMap2D::POWERUP_DOUBLEJUMP));
 
 	return true;
 }
@@ -106,6 +131,9 @@ bool CGUI_Scene2D::Init(void)
  */
 void CGUI_Scene2D::Update(const double dElapsedTime)
 {
+	PROFILE_SCOPE("GUI_Scene2D::Update");
+	ALLOCATION_SCOPE(CAllocationTracker::GUI);
+
 	// Start the Dear ImGui frame
 	ImGui_ImplOpenGL3_NewFrame();
 	ImGui_ImplGlfw_NewFrame();
@@ -146,7 +174,8 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 	cInventoryItem = cInventoryManager->GetItem("Health");
 	ImGui::Image((void*)(intptr_t)cInventoryItem->GetTextureID(),
 		ImVec2(cInventoryItem->vec2Size.x, cInventoryItem->vec2Size.y),
-		ImVec2(0, 1), ImVec2(1, 0));
+		ImVec2(cInventoryItem->vec2UVMin.x, cInventoryItem->vec2UVMax.y),
+		ImVec2(cInventoryItem->vec2UVMax.x, cInventoryItem->vec2UVMin.y));
 	ImGui::SameLine();
 	ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.0f, 1.0f, 0.0f, 1.0f));
 		ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.1f, 0.1f, 0.1f, 1.0f));
@@ -162,7 +191,8 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 	cInventoryItem = cInventoryManager->GetItem("EnemyHealth");
 	ImGui::Image((void*)(intptr_t)cInventoryItem->GetTextureID(),
 		ImVec2(cInventoryItem->vec2Size.x, cInventoryItem->vec2Size.y),
-		ImVec2(0, 1), ImVec2(1, 0));
+		ImVec2(cInventoryItem->vec2UVMin.x, cInventoryItem->vec2UVMax.y),
+		ImVec2(cInventoryItem->vec2UVMax.x, cInventoryItem->vec2UVMin.y));
 	ImGui::SameLine();
 	ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
 	ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.1f, 0.1f, 0.1f, 1.0f));
@@ -180,7 +210,8 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 		ImGui::SetWindowSize(ImVec2(100.0f, 25.0f));
 		ImGui::Image((void*)(intptr_t)cInventoryItem->GetTextureID(),
 			ImVec2(cInventoryItem->vec2Size.x, cInventoryItem->vec2Size.y),
-			ImVec2(0, 1), ImVec2(1, 0));
+			ImVec2(cInventoryItem->vec2UVMin.x, cInventoryItem->vec2UVMax.y),
+			ImVec2(cInventoryItem->vec2UVMax.x, cInventoryItem->vec2UVMin.y));
 		ImGui::SameLine();
 		ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
 		ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.1f, 0.1f, 0.1f, 1.0f));
@@ -206,7 +237,8 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 	ImGui::SetWindowSize(ImVec2(200.0f, 25.0f));
 	ImGui::Image((void*)(intptr_t)cInventoryItem->GetTextureID(),
 		ImVec2(cInventoryItem->vec2Size.x, cInventoryItem->vec2Size.y),
-		ImVec2(0, 1), ImVec2(1, 0));
+		ImVec2(cInventoryItem->vec2UVMin.x, cInventoryItem->vec2UVMax.y),
+		ImVec2(cInventoryItem->vec2UVMax.x, cInventoryItem->vec2UVMin.y));
 	ImGui::SameLine();
 	ImGui::SetWindowFontScale(1.5f);
 	ImGui::TextColored(ImVec4(1, 1, 0, 1), "Bombs: %d / %d",
@@ -234,9 +266,143 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 	//ImGui::End();
 	//ImGui::PopStyleColor();
 
+	// Show or hide the profiler window
+	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_F3))
+		bShowProfiler = !bShowProfiler;
+	if (bShowProfiler)
+		UpdateProfiler();
+
 	ImGui::End();
 }
 
+/**
+ @brief Show the times of the phases of the frames in the profiler window. The times are from the
+		frames before this one, as this frame is still being measured.
+ */
+void CGUI_Scene2D::UpdateProfiler(void)
+{
+	ImGuiWindowFlags profilerWindowFlags = ImGuiWindowFlags_AlwaysAutoResize |
+		ImGuiWindowFlags_NoCollapse |
+		ImGuiWindowFlags_NoFocusOnAppearing;
+	ImGui::SetNextWindowPos(ImVec2((float)cSettings->iWindowWidth - 420.0f, 100.0f), ImGuiCond_FirstUseEver);
+	ImGui::SetNextWindowBgAlpha(0.8f);
+	ImGui::Begin("Profiler", NULL, profilerWindowFlags);
+
+	// The frame times of the last frames
+	char sOverlay[64];
+	snprintf(sOverlay, sizeof(sOverlay), "Frame: %.2f ms", cProfiler->GetLastTime(CProfiler::ROOT));
+	ImGui::PlotLines("##FrameTimes", cProfiler->GetSamples(CProfiler::ROOT), CProfiler::NUM_SAMPLES,
+		cProfiler->GetSampleOffset(), sOverlay, 0.0f, FLT_MAX, ImVec2(400.0f, 60.0f));
+
+	// The statistics of each phase, in milliseconds
+	if (ImGui::BeginTable("ProfilerTable", 8, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingPolicyFixed))
+	{
+		ImGui::TableSetupColumn("Scope");
+		ImGui::TableSetupColumn("Calls");
+		ImGui::TableSetupColumn("Last");
+		ImGui::TableSetupColumn("Avg");
+		ImGui::TableSetupColumn("p50");
+		ImGui::TableSetupColumn("p95");
+		ImGui::TableSetupColumn("p99");
+		ImGui::TableSetupColumn("Max");
+		ImGui::TableHeadersRow();
+		UpdateProfilerNode(CProfiler::ROOT);
+		ImGui::EndTable();
+	}
+
+	// The timeline of the last frame. Each row is one level deeper than the row above it.
+	const float fTimelineWidth = 400.0f;
+	const float fRowHeight = ImGui::GetTextLineHeight() + 2.0f;
+	const float fFrameTime = cProfiler->GetLastTime(CProfiler::ROOT);
+	const std::vector<CProfiler::SEvent>& vEvents = cProfiler->GetLastFrameEvents();
+	ImDrawList* pDrawList = ImGui::GetWindowDrawList();
+	ImVec2 vec2Origin = ImGui::GetCursorScreenPos();
+	int iNumRows = 1;
+	for (size_t i = 0; (i < vEvents.size()) && (fFrameTime > 0.0f); i++)
+	{
+		const CProfiler::SEvent& sEvent = vEvents[i];
+		int iRow = cProfiler->GetDepth(sEvent.iNode) - 1;
+		if (iRow + 1 > iNumRows)
+			iNumRows = iRow + 1;
+
+		ImVec2 vec2Min(vec2Origin.x + sEvent.fStart / fFrameTime * fTimelineWidth, vec2Origin.y + iRow * fRowHeight);
+		ImVec2 vec2Max(vec2Min.x + sEvent.fDuration / fFrameTime * fTimelineWidth, vec2Min.y + fRowHeight - 1.0f);
+		if (vec2Max.x < vec2Min.x + 1.0f)
+			vec2Max.x = vec2Min.x + 1.0f;
+
+		// Each node keeps its colour from frame to frame
+		ImU32 iColor = ImColor::HSV(fmodf(sEvent.iNode * 0.13f, 1.0f), 0.6f, 0.7f);
+		pDrawList->AddRectFilled(vec2Min, vec2Max, iColor);
+
+		const char* sName = cProfiler->GetName(sEvent.iNode);
+		if (ImGui::CalcTextSize(sName).x < vec2Max.x - vec2Min.x - 4.0f)
+			pDrawList->AddText(ImVec2(vec2Min.x + 2.0f, vec2Min.y + 1.0f), IM_COL32_WHITE, sName);
+	}
+	ImGui::Dummy(ImVec2(fTimelineWidth, iNumRows * fRowHeight));
+
+	// The tiles of the map which were drawn and culled in the last frame
+	CMap2D* cMap2D = CMap2D::GetInstance();
+	ImGui::Text("Tiles: %u rendered, %u culled", cMap2D->GetNumTilesRendered(), cMap2D->GetNumTilesCulled());
+
+	// The allocations of the last frame, by subsystem
+	ImGui::Text("Allocations: %u in the update (%u bytes), %u frees. Flagged frames: %u%s",
+		CAllocationTracker::GetLastUpdateCount(), (unsigned int)CAllocationTracker::GetLastUpdateBytes(),
+		CAllocationTracker::GetLastFrees(), CAllocationTracker::GetNumFlaggedFrames(),
+		CAllocationTracker::IsSteady() ? "" : " (warming up)");
+	if (ImGui::BeginTable("AllocationTable", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingPolicyFixed))
+	{
+		ImGui::TableSetupColumn("Subsystem");
+		ImGui::TableSetupColumn("Allocations");
+		ImGui::TableSetupColumn("Bytes");
+		ImGui::TableHeadersRow();
+		for (int i = 0; i < CAllocationTracker::NUM_TAGS; i++)
+		{
+			CAllocationTracker::TAG eTag = (CAllocationTracker::TAG)i;
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(CAllocationTracker::GetTagName(eTag));
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", CAllocationTracker::GetLastCount(eTag));
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", (unsigned int)CAllocationTracker::GetLastBytes(eTag));
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
+/**
+ @brief Show a row of the profiler table for a node, followed by the rows of its children
+ @param iNode A const int containing the index of the node in the CProfiler
+ */
+void CGUI_Scene2D::UpdateProfilerNode(const int iNode)
+{
+	CProfiler::SStatistics sStatistics = cProfiler->GetStatistics(iNode);
+
+	ImGui::TableNextRow();
+	ImGui::TableNextColumn();
+	ImGui::Text("%*s%s", cProfiler->GetDepth(iNode) * 2, "", cProfiler->GetName(iNode));
+	ImGui::TableNextColumn();
+	ImGui::Text("%u", cProfiler->GetLastCalls(iNode));
+	ImGui::TableNextColumn();
+	ImGui::Text("%.2f", cProfiler->GetLastTime(iNode));
+	ImGui::TableNextColumn();
+	ImGui::Text("%.2f", sStatistics.fAverage);
+	ImGui::TableNextColumn();
+	ImGui::Text("%.2f", sStatistics.fP50);
+	ImGui::TableNextColumn();
+	ImGui::Text("%.2f", sStatistics.fP95);
+	ImGui::TableNextColumn();
+	ImGui::Text("%.2f", sStatistics.fP99);
+	ImGui::TableNextColumn();
+	ImGui::Text("%.2f", sStatistics.fMax);
+
+	const std::vector<int>& vChildren = cProfiler->GetChildren(iNode);
+	for (size_t i = 0; i < vChildren.size(); i++)
+		UpdateProfilerNode(vChildren[i]);
+}
+
 /**
  @brief Set up the OpenGL display environment before rendering
  */
@@ -249,6 +415,9 @@ void CGUI_Scene2D::PreRender(void)
  */
 void CGUI_Scene2D::Render(void)
 {
+	PROFILE_SCOPE("GUI_Scene2D::Render");
+	ALLOCATION_SCOPE(CAllocationTracker::GUI);
+
 	// Rendering
 	ImGui::Render();
 	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
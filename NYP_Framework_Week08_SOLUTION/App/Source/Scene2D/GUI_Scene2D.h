@@ -12,7 +12,7 @@
 #include "Primitives/Entity2D.h"
 
 // FPS Counter
-#include "TimeControl\FPSCounter.h"
+#include "TimeControl/FPSCounter.h"
 
 // Include CInventoryManager
 #include "InventoryManager.h"
@@ -31,14 +31,17 @@
 // Include IMGUI
 // Important: GLEW and GLFW must be included before IMGUI
 #ifndef IMGUI_ACTIVE
-#include "GUI\imgui.h"
-#include "GUI\backends\imgui_impl_glfw.h"
-#include "GUI\backends\imgui_impl_opengl3.h"
+#include "GUI/imgui.h"
+#include "GUI/backends/imgui_impl_glfw.h"
+#include "GUI/backends/imgui_impl_opengl3.h"
 #define IMGUI_ACTIVE
 #endif
 
 #include "GameControl/Settings.h"
 
+// Include CProfiler
+#include "TimeControl/Profiler.h"
+
 #include <string>
 using namespace std;
 
@@ -81,4 +84,14 @@ protected:
 	CInventoryManager* cInventoryManager;
 	// The handler containing the instance of CInventoryItem
 	CInventoryItem* cInventoryItem;
+
+	// The handler containing the instance of CProfiler
+	CProfiler* cProfiler;
+	// Whether the profiler window is shown. Toggle it with F3.
+	bool bShowProfiler;
+
+	// Show the times of the phases of the frames in the profiler window
+	void UpdateProfiler(void);
+	// Show a row of the profiler table for a node and its children
+	void UpdateProfilerNode(const int iNode);
 };
@@ -7,7 +7,7 @@ Date: May 2021
 #pragma once
 
 // Include SingletonTemplate
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 
 #include <map>
 #include <string>
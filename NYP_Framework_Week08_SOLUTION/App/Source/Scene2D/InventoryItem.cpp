@@ -10,6 +10,8 @@ CInventoryItem::CInventoryItem(const char* imagePath)
 	: iItemCount(0)
 	, iItemMaxCount(0)
 	, vec2Size(glm::vec2(0.0f))
+	, vec2UVMin(glm::vec2(0.0f))
+	, vec2UVMax(glm::vec2(1.0f))
 {
 	if ((imagePath) && (LoadTexture(imagePath) == false))
 	{
@@ -66,4 +68,14 @@ int CInventoryItem::GetMaxCount(void) const
 unsigned int CInventoryItem::GetTextureID(void) const
 {
 	return iTextureID;
+}
+
+/**
+@brief Set the texture, and the region of the icon in it, e.g. in a texture atlas
+*/
+void CInventoryItem::SetTexture(const unsigned int iTextureID, const glm::vec2& vec2UVMin, const glm::vec2& vec2UVMax)
+{
+	this->iTextureID = iTextureID;
+	this->vec2UVMin = vec2UVMin;
+	this->vec2UVMax = vec2UVMax;
 }
\ No newline at end of file
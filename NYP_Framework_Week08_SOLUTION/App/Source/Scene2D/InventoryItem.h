@@ -31,11 +31,16 @@ public:
 
 	// Get the texture ID
 	unsigned int GetTextureID(void) const;
+	// Set the texture, and the region of the icon in it, e.g. in a texture atlas
+	void SetTexture(const unsigned int iTextureID, const glm::vec2& vec2UVMin, const glm::vec2& vec2UVMax);
 
 	// Name of the inventory item
 	std::string sName;
 	// The size of the image to render in the GUI
 	glm::vec2 vec2Size;
+	// The texture coordinates of the bottom left and top right corners of the image
+	glm::vec2 vec2UVMin;
+	glm::vec2 vec2UVMax;
 
 	// The amount of this item
 	int iItemCount;
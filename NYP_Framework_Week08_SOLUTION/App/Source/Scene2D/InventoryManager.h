@@ -6,7 +6,7 @@ Date: Mar 2020
 #pragma once
 
 // Include SingletonTemplate
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 
 #include <map>
 #include <string>
@@ -9,14 +9,19 @@
 using namespace std;
 
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
 
 // Include ImageLoader
-#include "System\ImageLoader.h"
+#include "System/ImageLoader.h"
 
 // Include Math
 #include "System/MyMath.h"
 
+// Include CAllocationTracker
+#include "System/AllocationTracker.h"
+// Include CFrameArena
+#include "System/FrameArena.h"
+
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
 #include "Primitives/MeshBuilder.h"
@@ -90,14 +95,38 @@ void CItemSpawner2D::Update(const double dElapsedTime)
 	
 }
 
+/**
+ @brief Spawn an object on a random platform tile, i.e. tiles 100 to 199.
+		CMap2D keeps the empty tiles next to the platforms of each level and direction, so this does not search the map.
+ @param type A CMap2D::TILE_ID containing the object to spawn
+ @param dir A glm::vec2 containing the direction from the platform to the object
+ */
 void CItemSpawner2D::SpawnObjectOnRandomPlatform(CMap2D::TILE_ID type, glm::vec2 dir)
 {
-	SpawnObjectOnRandomPlatform(type, dir, static_cast<CMap2D::TILE_ID>(100), static_cast<CMap2D::TILE_ID>(199));
+	ALLOCATION_SCOPE(CAllocationTracker::SPAWNER);
+
+	unsigned int uiRow, uiCol;
+	// There is nowhere to spawn
+	if (cMap2D->GetRandomSpawnTile(glm::i32vec2(dir), uiRow, uiCol) == false)
+		return;
+
+	cMap2D->SetMapInfo(uiRow, uiCol, type);
 }
 
+/**
+ @brief Spawn an object on a random tile in a range of tiles. This searches the whole map, so use the other
+		overload to spawn on the platforms.
+ @param type A CMap2D::TILE_ID containing the object to spawn
+ @param dir A glm::vec2 containing the direction from the tile to the object
+ @param idStart A CMap2D::TILE_ID containing the first tile of the range
+ @param idEnd A CMap2D::TILE_ID containing the last tile of the range
+ */
 void CItemSpawner2D::SpawnObjectOnRandomPlatform(CMap2D::TILE_ID type, glm::vec2 dir, CMap2D::TILE_ID idStart, CMap2D::TILE_ID idEnd)
 {
-	vector<CCoord2D*> spaceToSpawn;
+	ALLOCATION_SCOPE(CAllocationTracker::SPAWNER);
+
+	// The candidates only live for this call, so they are kept in the frame arena
+	CFrameVector<CCoord2D> spaceToSpawn;
 	for (int x = 1; x < cSettings->NUM_TILES_XAXIS - 1; ++x)
 	{
 		for (int y = 1; y < cSettings->NUM_TILES_YAXIS - 1; ++y)
@@ -107,17 +136,15 @@ void CItemSpawner2D::SpawnObjectOnRandomPlatform(CMap2D::TILE_ID type, glm::vec2
 			if (tileID >= (int)idStart && tileID <= (int)idEnd 
 				&& tileUPID == 0)
 			{
-				spaceToSpawn.push_back(new CCoord2D(x + dir.x, y + dir.y));
+				spaceToSpawn.push_back(CCoord2D(x + dir.x, y + dir.y));
 			}
 		}
 	}
-	CCoord2D* selected = spaceToSpawn.at(Math::RandIntMinMax(0, spaceToSpawn.size() - 1));
-	cMap2D->SetMapInfo(selected->y, selected->x, type);
+	// There is nowhere to spawn
+	if (spaceToSpawn.empty())
+		return;
 
-	for (int i = 0; i < spaceToSpawn.size(); ++i)
-	{
-		delete spaceToSpawn.at(i);
-		spaceToSpawn.at(i) = nullptr;
-	}
+	const CCoord2D& selected = spaceToSpawn.at(Math::RandIntMinMax(0, spaceToSpawn.size() - 1));
+	cMap2D->SetMapInfo(selected.y, selected.x, type);
 }
 
@@ -6,7 +6,7 @@
 #pragma once
 
 // Include Singleton template
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 
 // Include GLEW
 #ifndef GLEW_STATIC
@@ -23,7 +23,7 @@
 class CMap2D;
 
 // Include Keyboard controller
-#include "Inputs\KeyboardController.h"
+#include "Inputs/KeyboardController.h"
 
 // Include Physics2D
 #include "Physics2D.h"
@@ -41,7 +41,7 @@ class CMap2D;
 #include "InventoryManager.h"
 
 // Include SoundController
-#include "..\SoundController\SoundController.h"
+#include "../SoundController/SoundController.h"
 
 struct CCoord2D {
 	int x;
@@ -6,25 +6,49 @@
 #include "Map2D.h"
 
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
 
 // Include Filesystem
-#include "System\filesystem.h"
+#include "System/filesystem.h"
 // Include ImageLoader
-#include "System\ImageLoader.h"
+#include "System/ImageLoader.h"
+// Include BufferedWriter
+#include "System/BufferedWriter.h"
 #include "Primitives/MeshBuilder.h"
+#include "System/MyMath.h"
+// Include CProfiler
+#include "TimeControl/Profiler.h"
+
+// Include CAllocationTracker
+#include "System/AllocationTracker.h"
+
+// Include CSpriteAnimation and CInventoryItem, which are drawn from the texture atlas
+#include "Primitives/SpriteAnimation.h"
+#include "InventoryItem.h"
 
 #include <iostream>
 #include <vector>
 #include <functional>
+#include <algorithm>
 using namespace std;
 
+// The offsets from a platform to its spawn tile in arrMapInfo, for up, down, right and left.
+// The rows of arrMapInfo are inverted, so up is the row before the platform.
+static const int arrSpawnRowOffsets[] = { -1, 1, 0, 0 };
+static const int arrSpawnColOffsets[] = { 0, 0, 1, -1 };
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
 CMap2D::CMap2D(void)
 	: uiCurLevel(0)
+	, vec2ViewMin(-1.0f, -1.0f)
+	, vec2ViewMax(1.0f, 1.0f)
+	, uiNumTilesRendered(0)
+	, uiNumTilesCulled(0)
 {
+	for (int i = 0; i < TILE_COUNT; ++i)
+		arrTileRegions[i] = NULL;
 }
 
 /**
@@ -44,9 +68,12 @@ CMap2D::~CMap2D(void)
 	delete[] arrMapInfo;
 
 	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-	glDeleteBuffers(1, &EBO);
+	if (VAO != 0)
+	{
+		glDeleteVertexArrays(1, &VAO);
+		glDeleteBuffers(1, &VBO);
+		glDeleteBuffers(1, &EBO);
+	}
 
 	// Delete AStar lists
 	DeleteAStarLists();
@@ -86,6 +113,14 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 		blockColor[i] = glm::vec4(1.0f, 1.0f, 1.f, 1.f);
 	}
 
+	// Create the spawn tiles, sized for the whole map. The map is empty, so they are empty.
+	vSpawnTiles.resize(uiNumLevels * NUM_SPAWN_DIRECTIONS);
+	for (unsigned int i = 0; i < vSpawnTiles.size(); i++)
+	{
+		vSpawnTiles[i].vTiles.reserve(uiNumRows * uiNumCols);
+		vSpawnTiles[i].vPositions.assign(uiNumRows * uiNumCols, -1);
+	}
+
 	// Initialise the variables for AStar
 	m_weight = 1;
 	m_startPos = glm::i32vec2(0, 0);
@@ -107,13 +142,15 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 	cSettings->NUM_TILES_YAXIS = uiNumRows;
 	cSettings->UpdateSpecifications();
 
+	// There is no OpenGL context in headless mode, so the tile textures are not loaded
+	if (cSettings->bHeadless)
+		return true;
+
 	glGenVertexArrays(1, &VAO);
 	glBindVertexArray(VAO);
 
-	//CS: Create the Quad Mesh using the mesh builder
-	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
-
-	// Load and create textures
+	// Load the textures into the texture atlas
+	cTextureAtlas.Clear();
 	// Load the ground texture
 	if (LoadTexture("Image/Scene2D_GroundTile.png", COLOUR_BLOCK_UP) == false)
 	{
@@ -198,6 +235,40 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 		return false;
 	}
 
+	// Load the sprite sheets of the entities. The bombs use the bomb tile's texture.
+	if (cTextureAtlas.AddImage("Player2D", "Image/scene2d_player.png") == false)
+	{
+		std::cout << "Failed to load player tile texture" << std::endl;
+		return false;
+	}
+	// The golem's 40 frames are in one row, which is wider than a page, so they are rearranged into 8 columns
+	if (cTextureAtlas.AddSpriteSheet("Enemy2D_Golem", "Image/scene2d_golemenemy.png", 1, 40, 8) == false)
+	{
+		std::cout << "Failed to load golem tile texture" << std::endl;
+		return false;
+	}
+
+	// Load the inventory icons. The others use the tiles' textures.
+	if (cTextureAtlas.AddImage("Health", "Image/Scene2D_Health.tga") == false)
+	{
+		std::cout << "Failed to load Scene2D_Health texture" << std::endl;
+		return false;
+	}
+	if (cTextureAtlas.AddImage("EnemyHealth", "Image/scene2d_golemenemy_icon.png") == false)
+	{
+		std::cout << "Failed to load scene2d_golemenemy_icon texture" << std::endl;
+		return false;
+	}
+
+	// Pack the textures into the atlas and look up where each tile went
+	if ((cTextureAtlas.Build() == false) || (cTextureAtlas.UploadToGPU() == false))
+	{
+		std::cout << "Failed to build the texture atlas" << std::endl;
+		return false;
+	}
+	for (int i = 0; i < TILE_COUNT; ++i)
+		arrTileRegions[i] = cTextureAtlas.GetRegion(std::to_string(i));
+
 	return true;
 }
 
@@ -217,7 +288,7 @@ void CMap2D::ClearInteractables()
 			int id = arrMapInfo[uiCurLevel][uiRow][uiCol].value;
 			if (id > CMap2D::TILE_ID::INTERACTABLES_START && id <= CMap2D::TILE_ID::POWERUP_DOUBLEJUMP)
 			{
-				arrMapInfo[uiCurLevel][uiRow][uiCol].value = 0;
+				SetTile(uiCurLevel, uiRow, uiCol, 0);
 			}
 		}
 	}
@@ -244,28 +315,48 @@ void CMap2D::PreRender(void)
  */
 void CMap2D::Render(void)
 {
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
-	// Render
-	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
+	PROFILE_SCOPE("Map2D::Render");
+	ALLOCATION_SCOPE(CAllocationTracker::MAP);
+
+	// Find the range of tiles which overlap the view rectangle.
+	// Column uiCol spans x from -1 + uiCol * TILE_WIDTH, and row uiRow spans y down from 1 - uiRow * TILE_HEIGHT.
+	int iFirstCol = (int)floor((vec2ViewMin.x + 1.0f) / cSettings->TILE_WIDTH);
+	int iLastCol = (int)ceil((vec2ViewMax.x + 1.0f) / cSettings->TILE_WIDTH) - 1;
+	int iFirstRow = (int)floor((1.0f - vec2ViewMax.y) / cSettings->TILE_HEIGHT);
+	int iLastRow = (int)ceil((1.0f - vec2ViewMin.y) / cSettings->TILE_HEIGHT) - 1;
+	iFirstCol = Math::Max(iFirstCol, 0);
+	iFirstRow = Math::Max(iFirstRow, 0);
+	iLastCol = Math::Min(iLastCol, (int)cSettings->NUM_TILES_XAXIS - 1);
+	iLastRow = Math::Min(iLastRow, (int)cSettings->NUM_TILES_YAXIS - 1);
+
+	uiNumTilesRendered = 0;
+	uiNumTilesCulled = cSettings->NUM_TILES_XAXIS * cSettings->NUM_TILES_YAXIS;
+
+	// Collect the tiles into the sprite batch. They share the tile atlas, so they are drawn with one draw call.
+	CSpriteBatch2D* cSpriteBatch2D = CSpriteBatch2D::GetInstance();
+	cSpriteBatch2D->Begin();
+	for (int iRow = iFirstRow; iRow <= iLastRow; iRow++)
 	{
-		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
+		for (int iCol = iFirstCol; iCol <= iLastCol; iCol++)
 		{
+			uiNumTilesCulled--;
+
+			// Empty tiles and entities are not drawn
+			if (arrMapInfo[uiCurLevel][iRow][iCol].value <= ENTITIES_END)
+				continue;
+
 			transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-			transform = glm::translate(transform, glm::vec3(cSettings->ConvertIndexToUVSpace(cSettings->x, uiCol, false, 0),
-															cSettings->ConvertIndexToUVSpace(cSettings->y, uiRow, true, 0),
+			transform = glm::translate(transform, glm::vec3(cSettings->ConvertIndexToUVSpace(cSettings->x, iCol, false, 0),
+															cSettings->ConvertIndexToUVSpace(cSettings->y, iRow, true, 0),
 															0.0f));
 			//transform = glm::rotate(transform, (float)glfwGetTime(), glm::vec3(0.0f, 0.0f, 1.0f));
 
-			// Update the shaders with the latest transform
-			glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
 			// Render a tile
-			RenderTile(uiRow, uiCol);
+			RenderTile(iRow, iCol);
+			uiNumTilesRendered++;
 		}
 	}
+	cSpriteBatch2D->Render();
 }
 
 /**
@@ -342,13 +433,14 @@ void CMap2D::SetNumSteps(const CSettings::AXIS sAxis, const unsigned int uiValue
  @param iRow A const int variable containing the row index of the element to set to
  @param iCol A const int variable containing the column index of the element to set to
  @param iValue A const int variable containing the value to assign to this arrMapInfo
+ @param bInvert A const bool variable which indicates if the row information is inverted
  */
 void CMap2D::SetMapInfo(const unsigned int uiRow, const unsigned int uiCol, const int iValue, const bool bInvert)
 {
 	if (bInvert)
-		arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value = iValue;
+		SetTile(uiCurLevel, cSettings->NUM_TILES_YAXIS - uiRow - 1, uiCol, iValue);
 	else
-		arrMapInfo[uiCurLevel][uiRow][uiCol].value = iValue;
+		SetTile(uiCurLevel, uiRow, uiCol, iValue);
 }
 
 /**
@@ -381,6 +473,8 @@ int CMap2D::GetMapInfo(const unsigned int uiRow, const int unsigned uiCol, const
  */ 
 bool CMap2D::LoadMap(string filename, const unsigned int uiCurLevel)
 {
+	PROFILE_SCOPE("Map2D::LoadMap");
+
 	doc = rapidcsv::Document(FileSystem::getPath(filename).c_str());
 
 	// Check if the sizes of CSV data matches the declared arrMapInfo sizes
@@ -404,6 +498,9 @@ bool CMap2D::LoadMap(string filename, const unsigned int uiCurLevel)
 		}
 	}
 
+	// The tiles were read directly into arrMapInfo, so build the spawn tiles of this level from them
+	BuildSpawnTiles(uiCurLevel);
+
 	return true;
 }
 
@@ -413,20 +510,46 @@ bool CMap2D::LoadMap(string filename, const unsigned int uiCurLevel)
  */
 bool CMap2D::SaveMap(string filename, const unsigned int uiCurLevel)
 {
-	// Update the rapidcsv::Document from arrMapInfo
+	PROFILE_SCOPE("Map2D::SaveMap");
+
+	// Each row is written through a scratch array of ints
+	vector<int> vRow(cSettings->NUM_TILES_XAXIS);
+
+	// Size the buffer for the whole map, so that it is written to the file in one call
+	size_t uiEstimatedSize = (cSettings->NUM_TILES_YAXIS + 1) * (cSettings->NUM_TILES_XAXIS * 4 + 1);
+
+	CBufferedWriter cBufferedWriter;
+	if (cBufferedWriter.Open(FileSystem::getPath(filename), uiEstimatedSize) == false)
+	{
+		cout << "Unable to open " << filename << " to save the map." << endl;
+		return false;
+	}
+
+	// Write the column labels which were read in by LoadMap
+	std::vector<std::string> vColumnNames = doc.GetColumnNames();
+	for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
+	{
+		if (uiCol != 0)
+			cBufferedWriter.WriteChar(',');
+		if (uiCol < vColumnNames.size())
+			cBufferedWriter.WriteString(vColumnNames[uiCol]);
+		else
+			cBufferedWriter.WriteInt(uiCol + 1);
+	}
+	cBufferedWriter.WriteChar('\n');
+
+	// Write arrMapInfo row by row
 	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
 	{
 		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
 		{
-			doc.SetCell(uiCol, uiRow, arrMapInfo[uiCurLevel][uiRow][uiCol].value);
+			vRow[uiCol] = arrMapInfo[uiCurLevel][uiRow][uiCol].value;
 		}
-		cout << endl;
+		cBufferedWriter.WriteRow(&vRow[0], vRow.size());
 	}
 
-	// Save the rapidcsv::Document to a file
-	doc.Save(FileSystem::getPath(filename).c_str());
-
-	return true;
+	// Write the buffer to the file
+	return cBufferedWriter.Close();
 }
 
 /**
@@ -474,92 +597,279 @@ unsigned int CMap2D::GetCurrentLevel(void) const
 	return uiCurLevel;
 }
 
+/**
+ @brief Get a random empty tile next to a platform, in a direction from the platform, on the current level.
+		The spawn tiles are kept up to date as the map changes, so this does not search the map.
+ @param i32vec2Dir A const glm::i32vec2& containing the direction from the platform, e.g. (0, 1) for the tiles above the platforms
+ @param uirRow A unsigned int& which is set to the row index of the tile
+ @param uirCol A unsigned int& which is set to the column index of the tile
+ @param bInvert A const bool variable which indicates if the row information is inverted
+ @return true if a tile was found, else false
+ */
+bool CMap2D::GetRandomSpawnTile(const glm::i32vec2& i32vec2Dir, unsigned int& uirRow, unsigned int& uirCol, const bool bInvert) const
+{
+	int iDirection = GetSpawnDirection(i32vec2Dir);
+	if (iDirection < 0)
+		return false;
 
-void CMap2D::SetColorOfTile(TILE_ID id, glm::vec4 tileColor)
+	const SSpawnTiles& sSpawnTiles = vSpawnTiles[uiCurLevel * NUM_SPAWN_DIRECTIONS + iDirection];
+	if (sSpawnTiles.vTiles.empty())
+		return false;
+
+	int iTile = sSpawnTiles.vTiles[Math::RandIntMinMax(0, (int)sSpawnTiles.vTiles.size() - 1)];
+	uirRow = iTile / cSettings->NUM_TILES_XAXIS;
+	uirCol = iTile % cSettings->NUM_TILES_XAXIS;
+	if (bInvert)
+		uirRow = cSettings->NUM_TILES_YAXIS - uirRow - 1;
+	return true;
+}
+
+/**
+ @brief Get the number of empty tiles next to a platform, in a direction from the platform, on the current level
+ @param i32vec2Dir A const glm::i32vec2& containing the direction from the platform
+ */
+unsigned int CMap2D::GetNumSpawnTiles(const glm::i32vec2& i32vec2Dir) const
 {
-	blockColor[id] = tileColor;
+	int iDirection = GetSpawnDirection(i32vec2Dir);
+	if (iDirection < 0)
+		return 0;
+
+	return (unsigned int)vSpawnTiles[uiCurLevel * NUM_SPAWN_DIRECTIONS + iDirection].vTiles.size();
 }
 
 /**
- @brief Load a texture, assign it a code and store it in MapOfTextureIDs.
- @param filename A const char* variable which contains the file name of the texture
- @param iTextureCode A const int variable which is the texture code.
+ @brief Set the value of a tile, and update the spawn tiles which it and the tiles around it belong to
+ @param uiLevel A const unsigned int containing the level
+ @param uiRow A const unsigned int containing the row index in arrMapInfo, which is not inverted
+ @param uiCol A const unsigned int containing the column index
+ @param iValue A const int containing the new value
  */
-bool CMap2D::LoadTexture(const char* filename, const int iTextureCode)
+void CMap2D::SetTile(const unsigned int uiLevel, const unsigned int uiRow, const unsigned int uiCol, const int iValue)
 {
-	// Variables used in loading the texture
-	int width, height, nrChannels;
-	unsigned int textureID;
+	if (arrMapInfo[uiLevel][uiRow][uiCol].value == (unsigned int)iValue)
+		return;
+	arrMapInfo[uiLevel][uiRow][uiCol].value = iValue;
 
-	// texture 1
-	// ---------
-	glGenTextures(1, &textureID);
-	glBindTexture(GL_TEXTURE_2D, textureID);
-	// set the texture wrapping parameters
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	// set texture filtering parameters
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	// The tile may have become, or stopped being, a spawn tile or the platform of one
+	for (int iDirection = 0; iDirection < NUM_SPAWN_DIRECTIONS; iDirection++)
+	{
+		UpdateSpawnTile(uiLevel, iDirection, uiRow, uiCol);
+		UpdateSpawnTile(uiLevel, iDirection, (int)uiRow + arrSpawnRowOffsets[iDirection], (int)uiCol + arrSpawnColOffsets[iDirection]);
+	}
+}
 
-	CImageLoader* cImageLoader = CImageLoader::GetInstance();
-	unsigned char *data = cImageLoader->Load(filename, width, height, nrChannels, true);
-	if (data)
+/**
+ @brief Build the spawn tiles of a level from its tiles
+ @param uiLevel A const unsigned int containing the level
+ */
+void CMap2D::BuildSpawnTiles(const unsigned int uiLevel)
+{
+	for (int iDirection = 0; iDirection < NUM_SPAWN_DIRECTIONS; iDirection++)
 	{
-		if (nrChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-		else if (nrChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+		SSpawnTiles& sSpawnTiles = vSpawnTiles[uiLevel * NUM_SPAWN_DIRECTIONS + iDirection];
+		sSpawnTiles.vTiles.clear();
+		std::fill(sSpawnTiles.vPositions.begin(), sSpawnTiles.vPositions.end(), -1);
+
+		for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
+		{
+			for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
+			{
+				UpdateSpawnTile(uiLevel, iDirection, uiRow, uiCol);
+			}
+		}
+	}
+}
+
+/**
+ @brief Add a tile to, or remove it from, the spawn tiles of a level and direction, depending on the tiles around it
+ @param uiLevel A const unsigned int containing the level
+ @param iDirection A const int containing the index of the direction
+ @param iRow A const int containing the row index in arrMapInfo, which is not inverted
+ @param iCol A const int containing the column index
+ */
+void CMap2D::UpdateSpawnTile(const unsigned int uiLevel, const int iDirection, const int iRow, const int iCol)
+{
+	if ((iRow < 0) || (iRow >= (int)cSettings->NUM_TILES_YAXIS) ||
+		(iCol < 0) || (iCol >= (int)cSettings->NUM_TILES_XAXIS))
+		return;
 
-		// Generate mipmaps
-		glGenerateMipmap(GL_TEXTURE_2D);
+	SSpawnTiles& sSpawnTiles = vSpawnTiles[uiLevel * NUM_SPAWN_DIRECTIONS + iDirection];
+	int iTile = iRow * cSettings->NUM_TILES_XAXIS + iCol;
+	int iPosition = sSpawnTiles.vPositions[iTile];
+	bool bIsSpawnTile = IsSpawnTile(uiLevel, iDirection, iRow, iCol);
 
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(iTextureCode, textureID));
+	if (bIsSpawnTile && (iPosition < 0))
+	{
+		// Add it to the end of the set
+		sSpawnTiles.vPositions[iTile] = (int)sSpawnTiles.vTiles.size();
+		sSpawnTiles.vTiles.push_back(iTile);
 	}
-	else
+	else if (!bIsSpawnTile && (iPosition >= 0))
 	{
+		// Move the last tile of the set into its place
+		int iLastTile = sSpawnTiles.vTiles.back();
+		sSpawnTiles.vTiles[iPosition] = iLastTile;
+		sSpawnTiles.vPositions[iLastTile] = iPosition;
+		sSpawnTiles.vTiles.pop_back();
+		sSpawnTiles.vPositions[iTile] = -1;
+	}
+}
+
+/**
+ @brief Check if a tile is empty and next to a platform, in a direction from the platform.
+		The platforms on the border of the map are skipped, as they are the walls of the level.
+ @param uiLevel A const unsigned int containing the level
+ @param iDirection A const int containing the index of the direction
+ @param iRow A const int containing the row index in arrMapInfo, which is not inverted
+ @param iCol A const int containing the column index
+ */
+bool CMap2D::IsSpawnTile(const unsigned int uiLevel, const int iDirection, const int iRow, const int iCol) const
+{
+	int iPlatformRow = iRow - arrSpawnRowOffsets[iDirection];
+	int iPlatformCol = iCol - arrSpawnColOffsets[iDirection];
+	if ((iPlatformRow < 1) || (iPlatformRow >= (int)cSettings->NUM_TILES_YAXIS - 1) ||
+		(iPlatformCol < 1) || (iPlatformCol >= (int)cSettings->NUM_TILES_XAXIS - 1))
+		return false;
+
+	if (arrMapInfo[uiLevel][iRow][iCol].value != 0)
 		return false;
+
+	unsigned int uiPlatform = arrMapInfo[uiLevel][iPlatformRow][iPlatformCol].value;
+	return (uiPlatform >= 100) && (uiPlatform < 200);
+}
+
+/**
+ @brief Get the index of a direction in vSpawnTiles
+ @param i32vec2Dir A const glm::i32vec2& containing the direction, where y is up
+ @return The index, or -1 if the direction is not up, down, right or left
+ */
+int CMap2D::GetSpawnDirection(const glm::i32vec2& i32vec2Dir) const
+{
+	for (int iDirection = 0; iDirection < NUM_SPAWN_DIRECTIONS; iDirection++)
+	{
+		if ((i32vec2Dir.x == arrSpawnColOffsets[iDirection]) && (i32vec2Dir.y == -arrSpawnRowOffsets[iDirection]))
+			return iDirection;
 	}
-	// Free up the memory of the file data read in
-	free(data);
+	return -1;
+}
+
+
+void CMap2D::SetColorOfTile(TILE_ID id, glm::vec4 tileColor)
+{
+	blockColor[id] = tileColor;
+}
 
+/**
+ @brief Set the area of the screen which is visible. Tiles outside of it are not rendered.
+ @param vec2Min A const glm::vec2& containing the bottom left corner, in the same space as the tile transforms
+ @param vec2Max A const glm::vec2& containing the top right corner, in the same space as the tile transforms
+ */
+void CMap2D::SetViewRect(const glm::vec2& vec2Min, const glm::vec2& vec2Max)
+{
+	vec2ViewMin = vec2Min;
+	vec2ViewMax = vec2Max;
+}
+
+/**
+ @brief Get the number of tiles drawn in the last frame
+ */
+unsigned int CMap2D::GetNumTilesRendered(void) const
+{
+	return uiNumTilesRendered;
+}
+
+/**
+ @brief Get the number of tiles skipped in the last frame because they were outside the view rectangle
+ */
+unsigned int CMap2D::GetNumTilesCulled(void) const
+{
+	return uiNumTilesCulled;
+}
+
+/**
+ @brief Draw a sprite sheet from the texture atlas. Its frames are selected within its region of the atlas.
+ @param cSpriteAnimation A CSpriteAnimation* which has the same rows and columns as the sprite sheet in the atlas
+ @param sName A const std::string& containing the name of the sprite sheet, or the code of a tile
+ @param iTextureID A GLuint& which is set to the texture of the page which the sprite sheet is in
+ @return true if the sprite sheet is in the atlas, or in headless mode where there are no textures, else false
+ */
+bool CMap2D::SetSpriteSheet(CSpriteAnimation* cSpriteAnimation, const std::string& sName, GLuint& iTextureID) const
+{
+	if (cSettings->bHeadless)
+		return true;
+
+	const CTextureAtlas::SRegion* sRegion = cTextureAtlas.GetRegion(sName);
+	if ((cSpriteAnimation == NULL) || (sRegion == NULL))
+		return false;
+
+	cSpriteAnimation->SetAtlasRegion(sRegion->vec2UVMin, sRegion->vec2UVMax);
+	iTextureID = cTextureAtlas.GetTextureID(sRegion->iPage);
 	return true;
 }
 
 /**
- @brief Render a tile at a position based on its tile index
+ @brief Draw an inventory icon from the texture atlas
+ @param cInventoryItem A CInventoryItem* which was added without an image
+ @param sName A const std::string& containing the name of the icon, or the code of a tile
+ @return true if the icon is in the atlas, or in headless mode where there are no textures, else false
+ */
+bool CMap2D::SetInventoryIcon(CInventoryItem* cInventoryItem, const std::string& sName) const
+{
+	if (cSettings->bHeadless)
+		return true;
+
+	const CTextureAtlas::SRegion* sRegion = cTextureAtlas.GetRegion(sName);
+	if ((cInventoryItem == NULL) || (sRegion == NULL))
+		return false;
+
+	cInventoryItem->SetTexture(cTextureAtlas.GetTextureID(sRegion->iPage), sRegion->vec2UVMin, sRegion->vec2UVMax);
+	return true;
+}
+
+/**
+ @brief Load a texture and add it to the texture atlas, with its code as its name.
+		The atlas is built after all the textures are loaded.
+ @param filename A const char* variable which contains the file name of the texture
+ @param iTextureCode A const int variable which is the texture code.
+ */
+bool CMap2D::LoadTexture(const char* filename, const int iTextureCode)
+{
+	return cTextureAtlas.AddImage(std::to_string(iTextureCode), filename);
+}
+
+/**
+ @brief Add a tile to the sprite batch at a position based on its tile index
  @param iRow A const int variable containing the row index of the tile
  @param iCol A const int variable containing the column index of the tile
  */
 void CMap2D::RenderTile(const unsigned int uiRow, const unsigned int uiCol)
 {
-	if (arrMapInfo[uiCurLevel][uiRow][uiCol].value > ENTITIES_END)
-	{
-		//if (arrMapInfo[uiCurLevel][uiRow][uiCol].value < 3)
-		unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtime_color");
-		glUniform4fv(colorLoc, 1, glm::value_ptr(blockColor[arrMapInfo[uiCurLevel][uiRow][uiCol].value]));
-		glBindTexture(GL_TEXTURE_2D, MapOfTextureIDs.at(arrMapInfo[uiCurLevel][uiRow][uiCol].value));
+	const unsigned int uiValue = arrMapInfo[uiCurLevel][uiRow][uiCol].value;
+	if ((uiValue <= ENTITIES_END) || (uiValue >= TILE_COUNT) || (arrTileRegions[uiValue] == NULL))
+		return;
 
-		glBindVertexArray(VAO);
-		//CS: Render the tile
-		quadMesh->Render();
-		glBindVertexArray(0);
-	}
+	const CTextureAtlas::SRegion* sRegion = arrTileRegions[uiValue];
+	CSpriteBatch2D::GetInstance()->Submit(cTextureAtlas.GetTextureID(sRegion->iPage),
+										  glm::vec2(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT),
+										  sRegion->vec2UVMin, sRegion->vec2UVMax,
+										  transform, blockColor[uiValue]);
 }
 
 /**
  @brief Find a path
  */
-std::vector<glm::i32vec2> CMap2D::PathFind(const glm::i32vec2& startPos, const glm::i32vec2& targetPos, HeuristicFunction heuristicFunc, int weight)
+CFrameVector<glm::i32vec2> CMap2D::PathFind(const glm::i32vec2& startPos, const glm::i32vec2& targetPos, HeuristicFunction heuristicFunc, int weight)
 {
+	PROFILE_SCOPE("Map2D::PathFind");
+	ALLOCATION_SCOPE(CAllocationTracker::MAP);
+
 	// Check if the startPos and targetPost are blocked
 	if (isBlocked(startPos.y, startPos.x) ||
 		(isBlocked(targetPos.y, targetPos.x)))
 	{
 		cout << "Invalid start or target position." << endl;
 		// Return an empty path
-		std::vector<glm::i32vec2> path;
+		CFrameVector<glm::i32vec2> path;
 		return path;
 	}
 	using namespace std::placeholders;
@@ -621,7 +931,7 @@ std::vector<glm::i32vec2> CMap2D::PathFind(const glm::i32vec2& startPos, const g
 			if (m_cameFromList[neighborIndex].f == 0 || fNew < m_cameFromList[neighborIndex].f)
 			{
 				//cout << "Adding to Open List: " << neighborPos.x << ", " << neighborPos.y;
-				cout << ". [ f : " << fNew << ", g : " << gNew << ", h : " << hNew << "]" << endl;
+				//cout << ". [ f : " << fNew << ", g : " << gNew << ", h : " << hNew << "]" << endl;
 				m_openList.push(Grid(neighborPos, fNew));
 				m_cameFromList[neighborIndex] = { neighborPos, currentPos, fNew, gNew, hNew };
 			}
@@ -639,9 +949,9 @@ std::vector<glm::i32vec2> CMap2D::PathFind(const glm::i32vec2& startPos, const g
 /**
  @brief Build a path
  */
-std::vector<glm::i32vec2> CMap2D::BuildPath() const
+CFrameVector<glm::i32vec2> CMap2D::BuildPath() const
 {
-	std::vector<glm::i32vec2> path;
+	CFrameVector<glm::i32vec2> path;
 	auto currentPos = m_targetPos;
 	auto currentIndex = ConvertTo1D(currentPos);
 
@@ -808,7 +1118,7 @@ bool CMap2D::ResetAStarLists(void)
 unsigned int heuristic::manhattan(const glm::i32vec2& v1, const glm::i32vec2& v2, int weight)
 {
 	glm::i32vec2 delta = v2 - v1;
-	return static_cast<unsigned int>(weight * (delta.x + delta.y));
+	return static_cast<unsigned int>(weight * (abs(delta.x) + abs(delta.y)));
 }
 
 /**
@@ -6,7 +6,7 @@
 #pragma once
 
 // Include SingletonTemplate
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 
 // Include GLEW
 #ifndef GLEW_STATIC
@@ -25,11 +25,16 @@
 #include <map>
 
 // Include Settings
-#include "GameControl\Settings.h"
+#include "GameControl/Settings.h"
 
 // Include Entity2D
 #include "Primitives/Entity2D.h"
 
+// Include TextureAtlas to pack the tile, sprite sheet and icon textures together
+#include "RenderControl/TextureAtlas.h"
+// Include SpriteBatch2D to draw the tiles together
+#include "RenderControl/SpriteBatch2D.h"
+
 // A structure storing information about Map Sizes
 struct MapSize {
 	unsigned int uiRowSize;
@@ -40,6 +45,11 @@ struct MapSize {
 #include <queue>
 #include <functional>
 
+// Include CFrameArena for the paths
+#include "System/FrameArena.h"
+// Include CAllocationTracker for the tagged containers
+#include "System/AllocationTracker.h"
+
 // A structure storing information about a map grid
 // It includes data to be used for A* Path Finding
 struct Grid {
@@ -67,6 +77,9 @@ namespace heuristic
 	
 }
 
+class CSpriteAnimation;
+class CInventoryItem;
+
 class CMap2D : public CSingletonTemplate<CMap2D>, public CEntity2D
 {
 
@@ -79,9 +92,9 @@ protected:
 	glm::i32vec2 m_startPos;
 	glm::i32vec2 m_targetPos;
 
-	std::priority_queue<Grid> m_openList;
-	std::vector<bool> m_closedList;
-	std::vector<Grid> m_cameFromList;
+	std::priority_queue<Grid, CTaggedVector<Grid, CAllocationTracker::MAP> > m_openList;
+	CTaggedVector<bool, CAllocationTracker::MAP> m_closedList;
+	CTaggedVector<Grid, CAllocationTracker::MAP> m_cameFromList;
 	//std::vector<int> m_grid;
 	std::vector<glm::i32vec2> m_directions;
 	HeuristicFunction m_heuristic;
@@ -159,6 +172,11 @@ public:
 
 	void ClearInteractables();
 
+	// Get a random empty tile next to a platform, in a direction from the platform, on the current level
+	bool GetRandomSpawnTile(const glm::i32vec2& i32vec2Dir, unsigned int& uirRow, unsigned int& uirCol, const bool bInvert = true) const;
+	// Get the number of empty tiles next to a platform, in a direction from the platform, on the current level
+	unsigned int GetNumSpawnTiles(const glm::i32vec2& i32vec2Dir) const;
+
 	// Set current level
 	void SetCurrentLevel(unsigned int uiCurLevel);
 	// Get current level
@@ -167,8 +185,21 @@ public:
 	// Set Color of tile
 	void SetColorOfTile(TILE_ID id, glm::vec4 color);
 
-	std::vector<glm::i32vec2> PathFind(const glm::i32vec2& startPos, const glm::i32vec2& targetPos, HeuristicFunction heuristicFunc, int weight);
-	std::vector<glm::i32vec2> BuildPath() const;
+	// Set the area of the screen which is visible, in the same space as the tile transforms
+	void SetViewRect(const glm::vec2& vec2Min, const glm::vec2& vec2Max);
+	// Get the number of tiles drawn in the last frame
+	unsigned int GetNumTilesRendered(void) const;
+	// Get the number of tiles skipped in the last frame because they were outside the view rectangle
+	unsigned int GetNumTilesCulled(void) const;
+
+	// Draw a sprite sheet from the texture atlas, e.g. "Player2D", or a tile's texture by its code
+	bool SetSpriteSheet(CSpriteAnimation* cSpriteAnimation, const std::string& sName, GLuint& iTextureID) const;
+	// Draw an inventory icon from the texture atlas, e.g. "Health", or a tile's texture by its code
+	bool SetInventoryIcon(CInventoryItem* cInventoryItem, const std::string& sName) const;
+
+	// The paths are in the frame arena, so they must be used or copied before the frame ends
+	CFrameVector<glm::i32vec2> PathFind(const glm::i32vec2& startPos, const glm::i32vec2& targetPos, HeuristicFunction heuristicFunc, int weight);
+	CFrameVector<glm::i32vec2> BuildPath() const;
 	void SetDiagonalMovement(const bool bEnable);
 	void PrintSelf(void) const;
 	bool isValid(const glm::i32vec2& pos) const;
@@ -194,11 +225,33 @@ protected:
 	// A 1-D array which stores the map sizes for each level
 	MapSize* arrMapSizes;
 
-	// Map containing texture IDs
-	map<int, int> MapOfTextureIDs;
-
-	//CS: The quadMesh for drawing the tiles
-	CMesh* quadMesh;
+	// The number of directions which items can be spawned in, from a platform
+	static const int NUM_SPAWN_DIRECTIONS = 4;
+
+	// A set of the empty tiles next to a platform, where an item can be spawned.
+	// vTiles holds the 1-D indices of the tiles, and vPositions holds the position of each tile in vTiles,
+	// or -1 if it is not in the set, so that a tile is added, removed or picked at random in constant time.
+	// Both are sized for the whole map in Init, so they never allocate after that.
+	struct SSpawnTiles
+	{
+		CTaggedVector<int, CAllocationTracker::MAP> vTiles;
+		CTaggedVector<int, CAllocationTracker::MAP> vPositions;
+	};
+	// The spawn tiles of each level and direction, at [uiLevel * NUM_SPAWN_DIRECTIONS + iDirection]
+	CTaggedVector<SSpawnTiles, CAllocationTracker::MAP> vSpawnTiles;
+
+	// The textures of all the tiles, the sprite sheets of the entities and the inventory icons, packed into
+	// one atlas so that the map, the entities and the GUI are drawn with few texture binds
+	CTextureAtlas cTextureAtlas;
+	// The region of each tile's texture in cTextureAtlas, or NULL if the tile has no texture
+	const CTextureAtlas::SRegion* arrTileRegions[TILE_COUNT];
+
+	// The visible area of the screen. Tiles outside of it are not rendered.
+	glm::vec2 vec2ViewMin;
+	glm::vec2 vec2ViewMax;
+	// The number of tiles rendered and culled in the last frame
+	unsigned int uiNumTilesRendered;
+	unsigned int uiNumTilesCulled;
 
 	// Constructor
 	CMap2D(void);
@@ -209,7 +262,18 @@ protected:
 	// Load a texture
 	bool LoadTexture(const char* filename, const int iTextureCode);
 
-	// Render a tile
+	// Add a tile to the sprite batch
 	void RenderTile(const unsigned int uiRow, const unsigned int uiCol);
+
+	// Set the value of a tile, and update the spawn tiles around it
+	void SetTile(const unsigned int uiLevel, const unsigned int uiRow, const unsigned int uiCol, const int iValue);
+	// Build the spawn tiles of a level from its tiles
+	void BuildSpawnTiles(const unsigned int uiLevel);
+	// Add a tile to, or remove it from, the spawn tiles of a level and direction
+	void UpdateSpawnTile(const unsigned int uiLevel, const int iDirection, const int iRow, const int iCol);
+	// Check if a tile is empty and next to a platform, in a direction from the platform
+	bool IsSpawnTile(const unsigned int uiLevel, const int iDirection, const int iRow, const int iCol) const;
+	// Get the index of a direction in vSpawnTiles, or -1 if it is not up, down, left or right
+	int GetSpawnDirection(const glm::i32vec2& i32vec2Dir) const;
 };
 
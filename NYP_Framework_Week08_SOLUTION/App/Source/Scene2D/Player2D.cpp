@@ -11,20 +11,24 @@
 using namespace std;
 
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
 
-// Include ImageLoader
-#include "System\ImageLoader.h"
+// Include SpriteBatch2D
+#include "RenderControl/SpriteBatch2D.h"
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
 #include "Primitives/MeshBuilder.h"
+#include "Primitives/AnimationClipLibrary.h"
 
 // Include Game Manager
 #include "GameManager.h"
 
 #include "Bomb2D.h"
 
+// Include CFrameArena
+#include "System/FrameArena.h"
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
@@ -38,6 +42,7 @@ CPlayer2D::CPlayer2D(void)
 	, dJumpCount(0)
 	, cItemSpawner(NULL)
 	, cSoundController(NULL)
+	, animatedSprites(NULL)
 {
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 
@@ -73,8 +78,16 @@ CPlayer2D::~CPlayer2D(void)
 	// We won't delete this since it was created elsewhere
 	cMap2D = NULL;
 
+	//CS: Delete the animated sprite. Its buffers are deleted by CMeshBuilder once no other sprite is using them.
+	if (animatedSprites)
+	{
+		delete animatedSprites;
+		animatedSprites = NULL;
+	}
+
 	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
+	if (VAO != 0)
+		glDeleteVertexArrays(1, &VAO);
 }
 
 /**
@@ -110,23 +123,34 @@ bool CPlayer2D::Init(void)
 	// By default, microsteps should be zero
 	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-	
-	// Load the player texture
-	if (LoadTexture("Image/scene2d_player.png", iTextureID) == false)
+	// There is no OpenGL context in headless mode
+	if (cSettings->bHeadless == false)
 	{
-		std::cout << "Failed to load player tile texture" << std::endl;
-		return false;
+		glGenVertexArrays(1, &VAO);
+		glBindVertexArray(VAO);
 	}
 	
 	//CS: Create the animated sprite and setup the animation 
 	animatedSprites = CMeshBuilder::GenerateSpriteAnimation(3, 4, cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
-	animatedSprites->AddAnimation("idle", 0, 1);
-	animatedSprites->AddAnimation("right", 0, 3);
-	animatedSprites->AddAnimation("left", 4, 7);
+	// The player's sprite sheet is in the map's texture atlas
+	if (cMap2D->SetSpriteSheet(animatedSprites, "Player2D", iTextureID) == false)
+	{
+		std::cout << "Failed to load player tile texture" << std::endl;
+		return false;
+	}
+	CAnimationClipSet* cClipSet = CAnimationClipLibrary::GetInstance()->GetClipSet("Player2D");
+	if (cClipSet->GetNumClips() == 0)
+	{
+		cClipSet->AddClip("idle", 0, 1);
+		cClipSet->AddClip("right", 0, 3);
+		cClipSet->AddClip("left", 4, 7);
+	}
+	animatedSprites->SetClipSet(cClipSet);
+	iClipIdle = cClipSet->GetClipHandle("idle");
+	iClipRight = cClipSet->GetClipHandle("right");
+	iClipLeft = cClipSet->GetClipHandle("left");
 	//CS: Play the "idle" animation as default
-	animatedSprites->PlayAnimation("idle", -1, 1.0f);
+	animatedSprites->PlayAnimation(iClipIdle, -1, 1.0f);
 
 	//CS: Init the color to white
 	currentColor = glm::vec4(1.0, 1.0, 1.0, 1.0);
@@ -148,12 +172,15 @@ bool CPlayer2D::Init(void)
 	// Get the handler to the CInventoryManager instance
 	cInventoryManager = CInventoryManager::GetInstance();
 	// Add a Lives icon as one of the inventory items
-	cInventoryItem = cInventoryManager->Add("Lives", "Image/Scene2D_Lives.tga", 3, 0);
+	// The Lives icon is the Life tile's texture in the map's texture atlas
+	cInventoryItem = cInventoryManager->Add("Lives", NULL, 3, 0);
 	cInventoryItem->vec2Size = glm::vec2(25, 25);
+	cMap2D->SetInventoryIcon(cInventoryItem, std::to_string(10));
 
 	// Add a Health icon as one of the inventory items
-	cInventoryItem = cInventoryManager->Add("Health", "Image/Scene2D_Health.tga", 1000, 1000);
+	cInventoryItem = cInventoryManager->Add("Health", NULL, 1000, 1000);
 	cInventoryItem->vec2Size = glm::vec2(25, 25);
+	cMap2D->SetInventoryIcon(cInventoryItem, "Health");
 
 	// Get the handler to the CSoundController
 	cSoundController = CSoundController::GetInstance();
@@ -206,7 +233,7 @@ void CPlayer2D::Update(const double dElapsedTime)
 		{
 			cMap2D->ClearInteractables();
 			nextSwitchCD = Math::RandFloatMinMax(5.5f, 18.f);
-			std::vector<int> nums;
+			CFrameVector<int> nums;
 			nums.push_back(0);
 			nums.push_back(1);
 			nums.push_back(2);
@@ -334,8 +361,7 @@ void CPlayer2D::Update(const double dElapsedTime)
 	// Update the Health and Lives
 	UpdateHealthLives();
 
-	//CS: Update the animated sprite
-	animatedSprites->Update(dElapsedTime);
+	//CS: The animated sprite is updated by CEntityManager2D, together with those of the other entities
 
 	// Update the UV Coordinates
 	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, i32vec2Index.x, false, i32vec2NumMicroSteps.x*cSettings->MICRO_STEP_XAXIS);
@@ -403,43 +429,27 @@ void CPlayer2D::PostRender(void)
 }
 
 /**
-@brief Load a texture, assign it a code and store it in MapOfTextureIDs.
-@param filename A const char* variable which contains the file name of the texture
-*/
-bool CPlayer2D::LoadTexture(const char* filename, GLuint& iTextureID)
+ @brief Get the animated sprite of this instance
+ @return The CSpriteAnimation of this instance
+ */
+CSpriteAnimation* CPlayer2D::GetAnimatedSprites(void) const
 {
-	// Variables used in loading the texture
-	int width, height, nrChannels;
-	
-	// texture 1
-	// ---------
-	glGenTextures(1, &iTextureID);
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-	// set the texture wrapping parameters
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	// set texture filtering parameters
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-	CImageLoader* cImageLoader = CImageLoader::GetInstance();
-	unsigned char *data = cImageLoader->Load(filename, width, height, nrChannels, true);
-	if (data)
-	{
-		if (nrChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-		else if (nrChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+	return animatedSprites;
+}
 
-		// Generate mipmaps
-		glGenerateMipmap(GL_TEXTURE_2D);
-	}
-	else
-	{
-		return false;
-	}
-	// Free up the memory of the file data read in
-	free(data);
+/**
+ @brief Add this instance to the CSpriteBatch2D, which draws all the sprites with the same texture together
+ @return true as this instance does not need to be rendered by itself
+ */
+bool CPlayer2D::SubmitSprite(void)
+{
+	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
+	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
+													vec2UVCoordinate.y,
+													0.0f));
+	transform = glm::rotate(transform, 0.8f, glm::vec3(0, 0, 1));
+
+	CSpriteBatch2D::GetInstance()->Submit(iTextureID, animatedSprites, transform, currentColor);
 
 	return true;
 }
@@ -479,7 +489,7 @@ void CPlayer2D::Move(CPhysics2D::DIRECTION eDirection, const double dElapsedTime
 		}
 
 		//CS: Play the "left" animation
-		animatedSprites->PlayAnimation("left", -1, 1.0f);
+		animatedSprites->PlayAnimation(iClipLeft, -1, 1.0f);
 
 		//CS: Change Color
 	
@@ -516,7 +526,7 @@ void CPlayer2D::Move(CPhysics2D::DIRECTION eDirection, const double dElapsedTime
 		}
 
 		//CS: Play the "right" animation
-		animatedSprites->PlayAnimation("right", -1, 1.0f);
+		animatedSprites->PlayAnimation(iClipRight, -1, 1.0f);
 
 	
 	}
@@ -551,7 +561,7 @@ void CPlayer2D::Move(CPhysics2D::DIRECTION eDirection, const double dElapsedTime
 		}
 
 		//CS: Play the "idle" animation
-		animatedSprites->PlayAnimation("idle", -1, 1.0f);
+		animatedSprites->PlayAnimation(iClipIdle, -1, 1.0f);
 
 	}
 	else if (relativeDir.y == -1) // "S" Key
@@ -584,7 +594,7 @@ void CPlayer2D::Move(CPhysics2D::DIRECTION eDirection, const double dElapsedTime
 		}
 
 		//CS: Play the "idle" animation
-		animatedSprites->PlayAnimation("idle", -1, 1.0f);
+		animatedSprites->PlayAnimation(iClipIdle, -1, 1.0f);
 
 
 	}
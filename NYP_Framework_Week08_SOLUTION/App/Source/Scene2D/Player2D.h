@@ -6,7 +6,7 @@
 #pragma once
 
 // Include Singleton template
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 
 // Include GLEW
 #ifndef GLEW_STATIC
@@ -26,7 +26,7 @@
 class CMap2D;
 
 // Include Keyboard controller
-#include "Inputs\KeyboardController.h"
+#include "Inputs/KeyboardController.h"
 
 // Include Physics2D
 #include "Physics2D.h"
@@ -43,7 +43,7 @@ class CMap2D;
 #include "ItemSpawner.h"
 
 // Include SoundController
-#include "..\SoundController\SoundController.h"
+#include "../SoundController/SoundController.h"
 
 class CPlayer2D : public CSingletonTemplate<CPlayer2D>, public CEntity2D
 {
@@ -65,6 +65,12 @@ public:
 	// PostRender
 	void PostRender(void);
 
+	// Add this instance to the CSpriteBatch2D instead of rendering it by itself
+	bool SubmitSprite(void);
+
+	// Get the animated sprite of this instance
+	CSpriteAnimation* GetAnimatedSprites(void) const;
+
 protected:
 
 	glm::i32vec2 i32vec2OldIndex;
@@ -89,6 +95,10 @@ protected:
 
 	//CS: Animated Sprite
 	CSpriteAnimation* animatedSprites;
+	//CS: The handles of the animations, so that they are not looked up by name every frame
+	int iClipIdle;
+	int iClipRight;
+	int iClipLeft;
 
 	// Current color
 	glm::vec4 currentColor;
@@ -118,9 +128,6 @@ protected:
 	// Move in a Direction
 	void Move(CPhysics2D::DIRECTION eDirection, const double dElapsedTime);
 
-	// Load a texture
-	bool LoadTexture(const char* filename, GLuint& iTextureID);
-
 	// Constraint the player's position within a boundary
 	void Constraint(CPhysics2D::DIRECTION eDirection = CPhysics2D::DIRECTION::LEFT);
 
@@ -3,9 +3,17 @@
 using namespace std;
 
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
 
-#include "System\filesystem.h"
+#include "System/filesystem.h"
+
+// Include CProfiler and CTraceRecorder
+#include "TimeControl/Profiler.h"
+
+// Include CAllocationTracker
+#include "System/AllocationTracker.h"
+
+#include <ctime>
 
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
@@ -43,6 +51,11 @@ CScene2D::~CScene2D(void)
 		cGUI_Scene2D->Destroy();
 		cGUI_Scene2D = NULL;
 	}
+	else
+	{
+		// The inventory is destroyed by cGUI_Scene2D, which is not created in headless mode
+		CInventoryManager::GetInstance()->Destroy();
+	}
 
 	// We won't delete this since it was created elsewhere
 	cKeyboardController = NULL;
@@ -61,10 +74,18 @@ CScene2D::~CScene2D(void)
 */ 
 bool CScene2D::Init(void)
 {
+	PROFILE_SCOPE("Scene2D::Init");
+
+	// In headless mode, there is no OpenGL context, so only the simulation is set up
+	const bool bHeadless = CSettings::GetInstance()->bHeadless;
+
 	// Include Shader Manager
-	CShaderManager::GetInstance()->Add("2DShader", "Shader//Scene2D.vs", "Shader//Scene2D.fs");
-	CShaderManager::GetInstance()->Use("2DShader");
-	CShaderManager::GetInstance()->activeShader->setInt("texture1", 0);
+	if (bHeadless == false)
+	{
+		CShaderManager::GetInstance()->Add("2DShader", "Shader//Scene2D.vs", "Shader//Scene2D.fs");
+		CShaderManager::GetInstance()->Use("2DShader");
+		CShaderManager::GetInstance()->activeShader->setInt("texture1", 0);
+	}
 
 	// Create and initialise the Map 2D
 	cMap2D = CMap2D::GetInstance();
@@ -98,10 +119,18 @@ bool CScene2D::Init(void)
 		return false;
 	}
 
-	// Load Scene2DColor into ShaderManager
-	CShaderManager::GetInstance()->Add("2DColorShader", "Shader//Scene2DColor.vs", "Shader//Scene2DColor.fs");
-	CShaderManager::GetInstance()->Use("2DColorShader");
-	CShaderManager::GetInstance()->activeShader->setInt("texture1", 0);
+	if (bHeadless == false)
+	{
+		// Load Scene2DColor into ShaderManager
+		CShaderManager::GetInstance()->Add("2DColorShader", "Shader//Scene2DColor.vs", "Shader//Scene2DColor.fs");
+		CShaderManager::GetInstance()->Use("2DColorShader");
+		CShaderManager::GetInstance()->activeShader->setInt("texture1", 0);
+
+		// Load Scene2DSprite into ShaderManager, which selects the frames of animated sprites
+		CShaderManager::GetInstance()->Add("2DSpriteShader", "Shader//Scene2DSprite.vs", "Shader//Scene2DColor.fs");
+		CShaderManager::GetInstance()->Use("2DSpriteShader");
+		CShaderManager::GetInstance()->activeShader->setInt("texture1", 0);
+	}
 	
 	cEntityManager2D = CEntityManager2D::GetInstance();
 	cEntityManager2D->Init();
@@ -133,15 +162,21 @@ bool CScene2D::Init(void)
 
 
 	// Setup the shaders
-	CShaderManager::GetInstance()->Add("textShader", "Shader//text.vs", "Shader//text.fs");
-	CShaderManager::GetInstance()->Use("textShader");
+	if (bHeadless == false)
+	{
+		CShaderManager::GetInstance()->Add("textShader", "Shader//text.vs", "Shader//text.fs");
+		CShaderManager::GetInstance()->Use("textShader");
+	}
 
 	// Store the keyboard controller singleton instance here
 	cKeyboardController = CKeyboardController::GetInstance();
 
-	// Store the cGUI_Scene2D singleton instance here
-	cGUI_Scene2D = CGUI_Scene2D::GetInstance();
-	cGUI_Scene2D->Init();
+	// Store the cGUI_Scene2D singleton instance here. There is no GUI in headless mode.
+	if (bHeadless == false)
+	{
+		cGUI_Scene2D = CGUI_Scene2D::GetInstance();
+		cGUI_Scene2D->Init();
+	}
 
 	// Game Manager
 	cGameManager = CGameManager::GetInstance();
@@ -192,14 +227,28 @@ bool CScene2D::Update(const double dElapsedTime)
 		}
 	}
 
+	// Start or stop recording a trace of the scopes into a new file
+	if (cKeyboardController->IsKeyPressed(GLFW_KEY_F4))
+	{
+		CTraceRecorder* cTraceRecorder = CTraceRecorder::GetInstance();
+		if (cTraceRecorder->IsRecording())
+			cTraceRecorder->Stop();
+		else
+			cTraceRecorder->Start("Trace_" + to_string((long long)time(NULL)) + ".json");
+	}
+
 	// Call the cGUI_Scene2D's update method
-	cGUI_Scene2D->Update(dElapsedTime);
+	if (cGUI_Scene2D)
+		cGUI_Scene2D->Update(dElapsedTime);
 
 	// Check if the game should go to the next level
 	if (cGameManager->bLevelCompleted == true)
 	{
 		cMap2D->SetCurrentLevel(4);
 		cGameManager->bLevelCompleted = false;
+
+		// The new level may allocate while it settles
+		CAllocationTracker::ResetSteadyState();
 	}
 
 	// Check if the game has been won by the player
@@ -242,6 +291,8 @@ void CScene2D::Render(void)
 	
 	// Call the Map2D's PreRender()
 	cMap2D->PreRender();
+	// There is no camera, so the view is the whole window, from -1 to 1 in the space of the tiles
+	cMap2D->SetViewRect(glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, 1.0f));
 	// Call the Map2D's Render()
 	cMap2D->Render();
 	// Call the Map2D's PostRender()
@@ -6,7 +6,7 @@
 #pragma once
 
 // Include SingletonTemplate
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 
 // Include GLEW
 #ifndef GLEW_STATIC
@@ -20,7 +20,7 @@
 #include <includes/gtc/type_ptr.hpp>
 
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
@@ -32,7 +32,7 @@
 #include "ItemSpawner.h"
 
 // Include Keyboard controller
-#include "Inputs\KeyboardController.h"
+#include "Inputs/KeyboardController.h"
 
 // GUI
 //#include "GUI/GUI.h"
@@ -46,7 +46,7 @@
 #include "EntityManager.h"
 
 // Include SoundController
-#include "..\SoundController\SoundController.h"
+#include "../SoundController/SoundController.h"
 
 class CScene2D : public CSingletonTemplate<CScene2D>
 {
@@ -0,0 +1,286 @@
+#include "Scene3D.h"
+#include <cstdio>
+#include <iostream>
+using namespace std;
+
+// Include Shader Manager
+#include "RenderControl/ShaderManager.h"
+
+// Include CProfiler
+#include "TimeControl/Profiler.h"
+
+// Include CBroadphase3D
+#include "Primitives/Broadphase3D.h"
+
+// The files and sizes of each kind of structure, in the order of CScene3D::STRUCTURE_TYPE
+static const struct
+{
+	const char* file_path;
+	const char* texture_path;
+	// The scale of the model, and how far it is raised so that it stands on the ground
+	float fScale;
+	float fHeight;
+	// The size of the collider, which is a unit box around the position
+	glm::vec3 vec3ColliderScale;
+} arrStructureTypes[CScene3D::NUM_STRUCTURE_TYPES] =
+{
+	{ "OBJ/WoodenCrate.obj",	"Image/WoodenCrate.png",			0.2f,	0.0f,	glm::vec3(1.0f, 2.0f, 1.0f) },
+	{ "OBJ/column.obj",			"Image/Scene3D_Structure_01.tga",	0.5f,	1.4f,	glm::vec3(0.6f, 3.0f, 0.6f) },
+	{ "OBJ/rock.obj",			"Image/rock.png",					0.5f,	0.2f,	glm::vec3(2.0f, 2.0f, 2.0f) },
+};
+
+const float CScene3D::STRUCTURE_SPACING = 4.0f;
+
+// The size of the collider of the camera, which reaches from the ground to above the camera
+static const glm::vec3 CAMERA_COLLIDER_SCALE = glm::vec3(1.0f, 6.0f, 1.0f);
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CScene3D::CScene3D(void)
+	: cCameraBody(NULL)
+	, cInstancedRenderer(NULL)
+	, cTextRenderer(NULL)
+	, iControlsText(-1)
+	, cKeyboardController(NULL)
+	, cSettings(NULL)
+	, vec3CameraPosition(0.0f)
+	, fCameraYaw(0.0f)
+	, view(glm::mat4(1.0f))
+	, projection(glm::mat4(1.0f))
+{
+	for (int i = 0; i < NUM_STRUCTURE_TYPES; i++)
+		arrModels[i] = NULL;
+}
+
+/**
+ @brief Destructor
+ */
+CScene3D::~CScene3D(void)
+{
+	if (cCameraBody)
+	{
+		delete cCameraBody;
+		cCameraBody = NULL;
+	}
+
+	// Delete the structures before the models whose meshes they share
+	for (unsigned int i = 0; i < vStructures.size(); i++)
+		delete vStructures[i];
+	vStructures.clear();
+
+	for (int i = 0; i < NUM_STRUCTURE_TYPES; i++)
+	{
+		if (arrModels[i])
+		{
+			delete arrModels[i];
+			arrModels[i] = NULL;
+		}
+	}
+
+	if (cInstancedRenderer)
+	{
+		cInstancedRenderer->Destroy();
+		cInstancedRenderer = NULL;
+	}
+
+	if (cTextRenderer)
+	{
+		cTextRenderer->DeleteStaticText(iControlsText);
+		cTextRenderer->Destroy();
+		cTextRenderer = NULL;
+	}
+
+	// We won't delete these since they were created elsewhere
+	cKeyboardController = NULL;
+	cSettings = NULL;
+}
+
+/**
+@brief Init Initialise this instance. Requires a valid OpenGL context.
+*/
+bool CScene3D::Init(void)
+{
+	PROFILE_SCOPE("Scene3D::Init");
+
+	cSettings = CSettings::GetInstance();
+
+	// Load the shader of CInstancedRenderer into ShaderManager
+	CShaderManager::GetInstance()->Add("InstancingShader", "Shader//Instancing.vs", "Shader//Instancing.fs");
+
+	cInstancedRenderer = CInstancedRenderer::GetInstance();
+	cInstancedRenderer->SetShader("InstancingShader");
+	if (cInstancedRenderer->Init() == false)
+	{
+		cout << "Failed to load CInstancedRenderer" << endl;
+		return false;
+	}
+
+	// Load the shader of CTextRenderer into ShaderManager
+	CShaderManager::GetInstance()->Add("textShader", "Shader//text.vs", "Shader//text.fs");
+
+	cTextRenderer = CTextRenderer::GetInstance();
+	cTextRenderer->SetShader("textShader");
+	if (cTextRenderer->Init() == false)
+	{
+		cout << "Failed to load CTextRenderer" << endl;
+		return false;
+	}
+	// The controls do not change, so their quads are built once
+	iControlsText = cTextRenderer->CreateStaticText("W/S: Move  A/D: Turn", 10.0f, 10.0f, 0.5f);
+
+	// Load the meshes and the texture of each kind of structure once
+	for (int i = 0; i < NUM_STRUCTURE_TYPES; i++)
+	{
+		arrModels[i] = new CStructure3D();
+		arrModels[i]->Init();
+		arrModels[i]->SetShader("InstancingShader");
+		if (arrModels[i]->LoadModel(arrStructureTypes[i].file_path, arrStructureTypes[i].texture_path) == false)
+		{
+			cout << "Failed to load the structure " << arrStructureTypes[i].file_path << endl;
+			return false;
+		}
+	}
+
+	// Fill the field with structures, centred on the origin
+	const float fOffset = (NUM_STRUCTURES_PER_SIDE - 1) * STRUCTURE_SPACING * 0.5f;
+	vStructures.reserve(NUM_STRUCTURES_PER_SIDE * NUM_STRUCTURES_PER_SIDE);
+	for (int iRow = 0; iRow < NUM_STRUCTURES_PER_SIDE; iRow++)
+	{
+		for (int iCol = 0; iCol < NUM_STRUCTURES_PER_SIDE; iCol++)
+		{
+			const int iType = (iRow + iCol) % NUM_STRUCTURE_TYPES;
+
+			CStructure3D* cStructure3D = new CStructure3D();
+			cStructure3D->Init();
+			cStructure3D->SetShader("InstancingShader");
+			cStructure3D->ShareLODModel(*arrModels[iType]);
+			cStructure3D->SetTextureID(arrModels[iType]->GetTextureID());
+			cStructure3D->SetScale(glm::vec3(arrStructureTypes[iType].fScale));
+			cStructure3D->SetPosition(glm::vec3(iCol * STRUCTURE_SPACING - fOffset,
+												arrStructureTypes[iType].fHeight,
+												iRow * STRUCTURE_SPACING - fOffset));
+			// The collider is used for culling and by the CBroadphase3D. It is not drawn.
+			cStructure3D->ActivateCollider("");
+			cStructure3D->SetColliderScale(arrStructureTypes[iType].vec3ColliderScale);
+			vStructures.push_back(cStructure3D);
+		}
+	}
+
+	// Check that no structures overlap. The CBroadphase3D finds the pairs whose boxes are close,
+	// and only these are tested with their colliders.
+	std::vector<std::pair<CEntity3D*, CEntity3D*> > vPairs;
+	CBroadphase3D::GetInstance()->GetCandidatePairs(vPairs);
+	int iNumOverlaps = 0;
+	for (unsigned int i = 0; i < vPairs.size(); i++)
+	{
+		if (vPairs[i].first->CheckForCollision(vPairs[i].second))
+			iNumOverlaps++;
+	}
+	if (iNumOverlaps > 0)
+		cout << iNumOverlaps << " pairs of structures overlap in the field" << endl;
+
+	// Start at the edge of the field, looking into it
+	vec3CameraPosition = glm::vec3(0.0f, 3.0f, fOffset + STRUCTURE_SPACING * 2.0f);
+	fCameraYaw = 0.0f;
+
+	// The camera's collider stops it from moving into the structures
+	cCameraBody = new CStructure3D();
+	cCameraBody->Init();
+	cCameraBody->SetPosition(vec3CameraPosition);
+	cCameraBody->ActivateCollider("");
+	cCameraBody->SetColliderScale(CAMERA_COLLIDER_SCALE);
+
+	// Store the keyboard controller singleton instance here
+	cKeyboardController = CKeyboardController::GetInstance();
+
+	return true;
+}
+
+/**
+@brief Update Update this instance
+*/
+bool CScene3D::Update(const double dElapsedTime)
+{
+	// Turn the camera with A and D, and move it with W and S
+	const float fMovementSpeed = 10.0f;
+	const float fTurnSpeed = 1.5f;
+	if (cKeyboardController->IsKeyDown(GLFW_KEY_A))
+		fCameraYaw -= fTurnSpeed * (float)dElapsedTime;
+	if (cKeyboardController->IsKeyDown(GLFW_KEY_D))
+		fCameraYaw += fTurnSpeed * (float)dElapsedTime;
+
+	glm::vec3 vec3Front = glm::vec3(sin(fCameraYaw), 0.0f, -cos(fCameraYaw));
+	if (cKeyboardController->IsKeyDown(GLFW_KEY_W))
+		vec3CameraPosition += vec3Front * fMovementSpeed * (float)dElapsedTime;
+	if (cKeyboardController->IsKeyDown(GLFW_KEY_S))
+		vec3CameraPosition -= vec3Front * fMovementSpeed * (float)dElapsedTime;
+
+	// Move the camera's collider, and move both back if it is now in a structure
+	{
+		PROFILE_SCOPE("Collision");
+		cCameraBody->StorePositionForRollback();
+		cCameraBody->SetPosition(vec3CameraPosition);
+		if (CBroadphase3D::GetInstance()->QueryCollisions(cCameraBody, vCollisions) > 0)
+		{
+			cCameraBody->RollbackPosition();
+			vec3CameraPosition = cCameraBody->GetPosition();
+		}
+	}
+
+	// Select the level of details of each structure for its distance to the camera
+	for (unsigned int i = 0; i < vStructures.size(); i++)
+		vStructures[i]->UpdateLOD(vec3CameraPosition);
+
+	return true;
+}
+
+/**
+ @brief PreRender Set up the OpenGL display environment before rendering
+ */
+void CScene3D::PreRender(void)
+{
+	// Clear the screen and buffer
+	glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	glEnable(GL_DEPTH_TEST);
+}
+
+/**
+ @brief Render Render this instance
+ */
+void CScene3D::Render(void)
+{
+	glm::vec3 vec3Front = glm::vec3(sin(fCameraYaw), 0.0f, -cos(fCameraYaw));
+	view = glm::lookAt(vec3CameraPosition, vec3CameraPosition + vec3Front, glm::vec3(0.0f, 1.0f, 0.0f));
+	projection = glm::perspective(	glm::radians(45.0f),
+									(float)cSettings->iWindowWidth / (float)cSettings->iWindowHeight,
+									0.1f, 500.0f);
+
+	// Draw the structures which are in view, one draw call for each mesh and texture
+	cInstancedRenderer->Begin(view, projection);
+	for (unsigned int i = 0; i < vStructures.size(); i++)
+		cInstancedRenderer->Submit(vStructures[i]);
+	cInstancedRenderer->Render();
+
+	// Draw the HUD over the field
+	glDisable(GL_DEPTH_TEST);
+	cTextRenderer->PreRender();
+	cTextRenderer->RenderStaticText(iControlsText, glm::vec3(1.0f, 1.0f, 0.0f));
+	// The number of structures which were drawn and culled by the camera's view in this frame
+	const CFrustum& cFrustum = cInstancedRenderer->GetFrustum();
+	char sFrustumText[64];
+	snprintf(sFrustumText, sizeof(sFrustumText), "Visible: %u  Culled: %u",
+		cFrustum.GetNumVisible(), cFrustum.GetNumCulled());
+	cTextRenderer->Render(sFrustumText, 10.0f, 40.0f, 0.5f, glm::vec3(1.0f, 1.0f, 0.0f));
+	cTextRenderer->PostRender();
+}
+
+/**
+ @brief PostRender Set up the OpenGL display environment after rendering.
+ */
+void CScene3D::PostRender(void)
+{
+	glDisable(GL_DEPTH_TEST);
+}
@@ -0,0 +1,114 @@
+/**
+ CScene3D
+
+ A field of crates, columns and rocks which is drawn by CInstancedRenderer.
+ Each kind of structure is loaded once with its LOD meshes, and every structure of that kind
+ shares them, so each kind and level of details is one draw call. The structures outside the
+ camera's view are culled by their colliders, which are also in the CBroadphase3D.
+ W and S move the camera forwards and backwards, and A and D turn it. The camera has a collider
+ too, and it cannot move into the structures. The controls are shown in a HUD over the field,
+ with the number of structures which are visible and culled.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include GLM
+#include <includes/glm.hpp>
+#include <includes/gtc/matrix_transform.hpp>
+#include <includes/gtc/type_ptr.hpp>
+
+// Include CStructure3D
+#include "Structure3D.h"
+
+// Include CInstancedRenderer
+#include "RenderControl/InstancedRenderer.h"
+
+// Include CTextRenderer
+#include "RenderControl/TextRenderer.h"
+
+// Include Keyboard controller
+#include "Inputs/KeyboardController.h"
+
+// Include Settings
+#include "GameControl/Settings.h"
+
+#include <vector>
+
+class CScene3D : public CSingletonTemplate<CScene3D>
+{
+	friend CSingletonTemplate<CScene3D>;
+public:
+	// The kinds of structures in the field
+	enum STRUCTURE_TYPE
+	{
+		CRATE,
+		COLUMN,
+		ROCK,
+		NUM_STRUCTURE_TYPES
+	};
+
+	// The number of structures along each side of the field, and the distance between them
+	static const int NUM_STRUCTURES_PER_SIDE = 30;
+	static const float STRUCTURE_SPACING;
+
+	// Init
+	bool Init(void);
+
+	// Update
+	bool Update(const double dElapsedTime);
+
+	// PreRender
+	void PreRender(void);
+
+	// Render
+	void Render(void);
+
+	// PostRender
+	void PostRender(void);
+
+protected:
+	// The structures which load the meshes and textures of each kind. They are not drawn.
+	CStructure3D* arrModels[NUM_STRUCTURE_TYPES];
+	// The structures in the field, which share the meshes of arrModels
+	std::vector<CStructure3D*> vStructures;
+
+	// A CStructure3D without a model, which holds the collider of the camera
+	CStructure3D* cCameraBody;
+	// The structures which collide with the camera. It is kept between frames to reuse its memory.
+	std::vector<CEntity3D*> vCollisions;
+
+	// The handler to the CInstancedRenderer instance
+	CInstancedRenderer* cInstancedRenderer;
+
+	// The handler to the CTextRenderer instance, which draws the HUD
+	CTextRenderer* cTextRenderer;
+	// The handle of the controls in the HUD, which are built once with CTextRenderer::CreateStaticText
+	int iControlsText;
+
+	// Keyboard Controller singleton instance
+	CKeyboardController* cKeyboardController;
+
+	// The handler to the CSettings instance
+	CSettings* cSettings;
+
+	// The position and direction of the camera
+	glm::vec3 vec3CameraPosition;
+	float fCameraYaw;
+
+	// The camera matrices of this frame
+	glm::mat4 view;
+	glm::mat4 projection;
+
+	// Constructor
+	CScene3D(void);
+	// Destructor
+	virtual ~CScene3D(void);
+};
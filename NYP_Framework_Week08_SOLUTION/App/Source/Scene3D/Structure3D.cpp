@@ -0,0 +1,139 @@
+/**
+ CStructure3D
+ */
+#include "Structure3D.h"
+
+// Include ShaderManager
+#include "RenderControl/ShaderManager.h"
+
+// Include CInstancedRenderer for the location of aInstanceMatrix
+#include "RenderControl/InstancedRenderer.h"
+
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Default Constructor
+ */
+CStructure3D::CStructure3D(void)
+	: bOwnsTexture(false)
+{
+	eType = STRUCTURE;
+}
+
+/**
+ @brief Destructor
+ */
+CStructure3D::~CStructure3D(void)
+{
+	if ((bOwnsTexture) && (iTextureID != 0))
+	{
+		glDeleteTextures(1, &iTextureID);
+		iTextureID = 0;
+	}
+}
+
+/**
+ @brief Initialise this instance to default values
+ */
+bool CStructure3D::Init(void)
+{
+	return CEntity3D::Init();
+}
+
+/**
+ @brief Load the LOD meshes of an OBJ file and a texture
+ @param file_path A const char* containing the name of the OBJ file
+ @param texture_path A const char* containing the name of the texture
+ @return true if the meshes and the texture were loaded, else false
+ */
+bool CStructure3D::LoadModel(const char* file_path, const char* texture_path)
+{
+	if (LoadLODModel(file_path) == false)
+	{
+		cout << "Unable to load the model " << file_path << endl;
+		return false;
+	}
+
+	iTextureID = LoadTexture(texture_path);
+	if (iTextureID == 0)
+	{
+		cout << "Unable to load the texture " << texture_path << endl;
+		return false;
+	}
+	bOwnsTexture = true;
+
+	return true;
+}
+
+/**
+ @brief Set the model matrix
+ */
+void CStructure3D::SetModel(glm::mat4 model)
+{
+	this->model = model;
+}
+
+/**
+ @brief Set the view matrix
+ */
+void CStructure3D::SetView(glm::mat4 view)
+{
+	this->view = view;
+}
+
+/**
+ @brief Set the projection matrix
+ */
+void CStructure3D::SetProjection(glm::mat4 projection)
+{
+	this->projection = projection;
+}
+
+/**
+ @brief Update this instance. A structure does not move.
+ @param dElapsedTime A const double containing the elapsed time since the last frame
+ */
+void CStructure3D::Update(const double dElapsedTime)
+{
+}
+
+/**
+ @brief PreRender Set up the OpenGL display environment before rendering
+ */
+void CStructure3D::PreRender(void)
+{
+}
+
+/**
+ @brief Render this CStructure3D with the instancing shader, as a single instance.
+		aInstanceMatrix is not read from a buffer here, so it is set as a constant attribute.
+ */
+void CStructure3D::Render(void)
+{
+	if ((VAO == 0) || (index_buffer_size == 0))
+		return;
+
+	model = GetModelMatrix();
+
+	CShaderManager::GetInstance()->Use(sShaderName);
+	CShaderManager::GetInstance()->activeShader->setMat4("view", view);
+	CShaderManager::GetInstance()->activeShader->setMat4("projection", projection);
+	CShaderManager::GetInstance()->activeShader->setInt("texture_diffuse1", 0);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, iTextureID);
+
+	glBindVertexArray(VAO);
+	for (GLuint i = 0; i < 4; i++)
+		glVertexAttrib4fv(CInstancedRenderer::INSTANCE_MATRIX_LOCATION + i, glm::value_ptr(model[i]));
+	glDrawElements(GL_TRIANGLES, index_buffer_size, GL_UNSIGNED_INT, 0);
+	glBindVertexArray(0);
+}
+
+/**
+ @brief PostRender Set up the OpenGL display environment after rendering.
+ */
+void CStructure3D::PostRender(void)
+{
+}
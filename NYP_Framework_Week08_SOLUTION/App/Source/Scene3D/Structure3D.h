@@ -0,0 +1,59 @@
+/**
+ CStructure3D
+
+ A static prop, such as a crate or a column, which is drawn with LOD meshes.
+ One CStructure3D loads the meshes and the texture with LoadModel, and the others use them
+ through ShareLODModel and SetTextureID, so that CInstancedRenderer draws them together.
+ */
+#pragma once
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include GLM
+#include <includes/glm.hpp>
+#include <includes/gtc/matrix_transform.hpp>
+#include <includes/gtc/type_ptr.hpp>
+
+// Include CEntity3D
+#include "Primitives/Entity3D.h"
+
+class CStructure3D : public CEntity3D
+{
+public:
+	// Constructor
+	CStructure3D(void);
+
+	// Destructor
+	virtual ~CStructure3D(void);
+
+	// Init
+	virtual bool Init(void);
+
+	// Load the LOD meshes of an OBJ file and a texture
+	bool LoadModel(const char* file_path, const char* texture_path);
+
+	// Set model
+	virtual void SetModel(glm::mat4 model);
+	// Set view
+	virtual void SetView(glm::mat4 view);
+	// Set projection
+	virtual void SetProjection(glm::mat4 projection);
+
+	// Update this class instance
+	virtual void Update(const double dElapsedTime);
+
+	// PreRender
+	virtual void PreRender(void);
+	// Render this CStructure3D on its own. Use CInstancedRenderer to draw many of them.
+	virtual void Render(void);
+	// PostRender
+	virtual void PostRender(void);
+
+protected:
+	// True if the texture was loaded by LoadModel, so it is deleted with this CStructure3D
+	bool bOwnsTexture;
+};
@@ -1,5 +1,14 @@
 #include "SoundController.h"
 
+// Include CSettings
+#include "GameControl/Settings.h"
+
+// Include CProfiler
+#include "TimeControl/Profiler.h"
+
+// Include CAllocationTracker
+#include "System/AllocationTracker.h"
+
 #include <iostream>
 using namespace std;
 
@@ -47,8 +56,10 @@ CSoundController::~CSoundController(void)
  */
 bool CSoundController::Init(void)
 {
-	// Initialise the sound engine with default parameters
-	cSoundEngine = createIrrKlangDevice(ESOD_WIN_MM, ESEO_MULTI_THREADED);
+	// Initialise the sound engine with default parameters. In headless mode, the sounds are
+	// played by the null driver, which has no output, so there does not need to be a sound device.
+	E_SOUND_OUTPUT_DRIVER eDriver = CSettings::GetInstance()->bHeadless ? ESOD_NULL : ESOD_WIN_MM;
+	cSoundEngine = createIrrKlangDevice(eDriver, ESEO_MULTI_THREADED);
 	if (cSoundEngine == NULL)
 	{
 		cout << "Unable to initialise the IrrKlang sound engine" << endl;
@@ -74,6 +85,8 @@ bool CSoundController::LoadSound(	string filename,
 									CSoundInfo::SOUNDTYPE eSoundType,
 									vec3df vec3dfSoundPos)
 {
+	PROFILE_SCOPE("SoundController::LoadSound");
+
 	// Load the sound from the file
 	ISoundSource* pSoundSource = cSoundEngine->addSoundSourceFromFile(filename.c_str(),
 																	E_STREAM_MODE::ESM_NO_STREAMING, 
@@ -112,6 +125,8 @@ bool CSoundController::LoadSound(	string filename,
  */
 void CSoundController::PlaySoundByID(const int ID)
 {
+	ALLOCATION_SCOPE(CAllocationTracker::SOUND);
+
 	CSoundInfo* pSoundInfo = GetSound(ID);
 	if (!pSoundInfo)
 	{
@@ -6,7 +6,7 @@
 #pragma once
 
 // Include SingletonTemplate
-#include <DesignPatterns\SingletonTemplate.h>
+#include <DesignPatterns/SingletonTemplate.h>
 
 // Include GLEW
 #include <includes/irrKlang.h>
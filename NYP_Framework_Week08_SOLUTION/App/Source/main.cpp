@@ -19,11 +19,17 @@ Boolean macro to determine if the program is in 3D or 2D mode
 
 /**
  @brief This function is the main function which is called by the operating system when you run the executables
+ @param argc The number of command line arguments
+ @param argv The command line arguments, e.g. --headless to run without a window
  @return This function returns the error codes
  */
-int main(void)
+int main(int argc, char* argv[])
 {
 	Application* pApp = Application::GetInstance();
+	// Read the command line arguments, before the application is initialised with them
+	if (pApp->ParseArguments(argc, argv) == false)
+		return 1;
+
 	// if the application is initialised properly, then run it
 	if (pApp->Init() == true)
 	{
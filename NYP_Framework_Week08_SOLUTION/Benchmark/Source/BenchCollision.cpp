@@ -0,0 +1,66 @@
+/**
+ Benchmarks of the collisions of CEntityManager2D
+
+ The collision pass of CEntityManager2D::Update, at several numbers of entities: the box of
+ every entity is stored in a CAABBBatch, then each entity is tested against all of them.
+ The entities are not updated and do not respond to the collisions.
+ */
+#include <benchmark/benchmark.h>
+
+// Include CEntity2D
+#include "Primitives/Entity2D.h"
+
+// Include CAABBBatch, which CEntityManager2D tests the entities with
+#include "Primitives/AABBBatch.h"
+
+#include <vector>
+using namespace std;
+
+/**
+ @brief Get the box of an entity, in the same way as CEntityManager2D. Each entity is 1 tile wide.
+ */
+static void GetEntityBox(const CEntity2D& cEntity2D, float* arrMin, float* arrMax)
+{
+	arrMin[0] = cEntity2D.i32vec2Index.x + cEntity2D.i32vec2NumMicroSteps.x * 0.25f;
+	arrMin[1] = cEntity2D.i32vec2Index.y + cEntity2D.i32vec2NumMicroSteps.y * 0.25f;
+	arrMax[0] = arrMin[0] + 1.0f;
+	arrMax[1] = arrMin[1] + 1.0f;
+}
+
+static void BM_EntityManager2D_Collision(benchmark::State& state)
+{
+	const unsigned int uiNumEntities = (unsigned int)state.range(0);
+
+	// Spread the entities over a map of 32 x 24 tiles, part of the way between tiles
+	vector<CEntity2D> vEntities(uiNumEntities);
+	for (unsigned int i = 0; i < uiNumEntities; i++)
+	{
+		vEntities[i].i32vec2Index = glm::i32vec2((i * 7) % 32, (i * 5) % 24);
+		vEntities[i].i32vec2NumMicroSteps = glm::i32vec2(i % 4, 0);
+	}
+
+	CAABBBatch cAABBBatch(2, false);
+	vector<unsigned int> vCollisionMask;
+	vector<unsigned int> vCollisionIndices;
+	float arrMin[2], arrMax[2];
+	size_t uiNumCollisions = 0;
+	for (auto _ : state)
+	{
+		cAABBBatch.Resize(uiNumEntities);
+		for (unsigned int i = 0; i < uiNumEntities; i++)
+		{
+			GetEntityBox(vEntities[i], arrMin, arrMax);
+			cAABBBatch.SetBox(i, arrMin, arrMax);
+		}
+		for (unsigned int i = 0; i < uiNumEntities; i++)
+		{
+			GetEntityBox(vEntities[i], arrMin, arrMax);
+			cAABBBatch.Test(arrMin, arrMax, vCollisionMask, vCollisionIndices);
+			uiNumCollisions += vCollisionIndices.size();
+		}
+	}
+	benchmark::DoNotOptimize(uiNumCollisions);
+	state.SetItemsProcessed(state.iterations() * uiNumEntities);
+	state.SetComplexityN(uiNumEntities);
+}
+BENCHMARK(BM_EntityManager2D_Collision)->RangeMultiplier(4)->Range(16, 1024)->Complexity();
@@ -0,0 +1,110 @@
+/**
+ Benchmarks of the loaders
+
+ The CSV readers on a shipped map, and the OBJ loaders on shipped models from small to large.
+ */
+#include <benchmark/benchmark.h>
+
+// Include Settings
+#include "GameControl/Settings.h"
+
+// Include the loaders of the maps
+#include "System/CSVReader.h"
+#include "System/rapidcsv.h"
+
+// Include the loaders of the models
+#include "System/LoadOBJ.h"
+#include "System/MeshCache.h"
+
+#include <vector>
+using namespace std;
+
+// The map which is loaded
+static const char* MAP_FILE_PATH = "Maps/DM2213_Map_Level_01_DOWN.csv";
+
+static void BM_CCSVReader_read_csv(benchmark::State& state)
+{
+	const int iNumCols = CSettings::GetInstance()->NUM_TILES_XAXIS;
+	const int iNumRows = CSettings::GetInstance()->NUM_TILES_YAXIS;
+	CCSVReader cCSVReader;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(cCSVReader.read_csv(MAP_FILE_PATH, iNumCols, iNumRows));
+}
+BENCHMARK(BM_CCSVReader_read_csv)->Unit(benchmark::kMicrosecond);
+
+static void BM_rapidcsv_Document(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		rapidcsv::Document doc(MAP_FILE_PATH);
+		benchmark::DoNotOptimize(doc.GetRowCount());
+	}
+}
+BENCHMARK(BM_rapidcsv_Document)->Unit(benchmark::kMicrosecond);
+
+// The OBJ loaders append to the vectors, so they are cleared before each load
+static void BM_LoadOBJ(benchmark::State& state, const char* file_path)
+{
+	vector<glm::vec3> vertices;
+	vector<glm::vec2> uvs;
+	vector<glm::vec3> normals;
+	for (auto _ : state)
+	{
+		vertices.clear();
+		uvs.clear();
+		normals.clear();
+		if (LoadOBJ(file_path, vertices, uvs, normals) == false)
+		{
+			state.SkipWithError("Failed to load the model");
+			break;
+		}
+	}
+	state.counters["Vertices"] = (double)vertices.size();
+}
+BENCHMARK_CAPTURE(BM_LoadOBJ, WoodenCrate, "OBJ/WoodenCrate.obj")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadOBJ, teapot, "OBJ/teapot.obj")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadOBJ, Shark, "OBJ/Shark.obj")->Unit(benchmark::kMillisecond);
+
+static void BM_LoadOBJParallel(benchmark::State& state, const char* file_path)
+{
+	vector<glm::vec3> vertices;
+	vector<glm::vec2> uvs;
+	vector<glm::vec3> normals;
+	for (auto _ : state)
+	{
+		vertices.clear();
+		uvs.clear();
+		normals.clear();
+		if (LoadOBJParallel(file_path, vertices, uvs, normals) == false)
+		{
+			state.SkipWithError("Failed to load the model");
+			break;
+		}
+	}
+	state.counters["Vertices"] = (double)vertices.size();
+}
+BENCHMARK_CAPTURE(BM_LoadOBJParallel, WoodenCrate, "OBJ/WoodenCrate.obj")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_LoadOBJParallel, teapot, "OBJ/teapot.obj")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_LoadOBJParallel, Shark, "OBJ/Shark.obj")->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// The first load writes the cache file if it is out of date, so the timed loads read it
+static void BM_CMeshCache_Load(benchmark::State& state, const char* file_path)
+{
+	vector<IndexedVertex> vertices;
+	vector<unsigned> indices;
+	if (CMeshCache::Load(file_path, vertices, indices) == false)
+	{
+		state.SkipWithError("Failed to load the model");
+		return;
+	}
+	for (auto _ : state)
+	{
+		vertices.clear();
+		indices.clear();
+		CMeshCache::Load(file_path, vertices, indices);
+	}
+	state.counters["Vertices"] = (double)vertices.size();
+}
+BENCHMARK_CAPTURE(BM_CMeshCache_Load, WoodenCrate, "OBJ/WoodenCrate.obj")->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_CMeshCache_Load, teapot, "OBJ/teapot.obj")->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_CMeshCache_Load, Shark, "OBJ/Shark.obj")->Unit(benchmark::kMicrosecond);
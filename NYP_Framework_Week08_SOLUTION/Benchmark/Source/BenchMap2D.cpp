@@ -0,0 +1,177 @@
+/**
+ Benchmarks of CMap2D
+
+ The tile queries over every tile of a shipped map, and CMap2D::PathFind between fixed tiles
+ on each of the shipped maps.
+ */
+#include <benchmark/benchmark.h>
+
+// Include Settings
+#include "GameControl/Settings.h"
+
+// Include CMap2D
+#include "Scene2D/Map2D.h"
+
+// Include CFrameArena, which holds the paths of CMap2D::PathFind
+#include "System/FrameArena.h"
+
+#include <vector>
+using namespace std;
+
+// The shipped maps, in the order of their levels
+static const char* arrMaps[] =
+{
+	"Maps/DM2213_Map_Level_01_DOWN.csv",
+	"Maps/DM2213_Map_Level_01_UP.csv",
+	"Maps/DM2213_Map_Level_01_RIGHT.csv",
+	"Maps/DM2213_Map_Level_01_LEFT.csv",
+};
+static const unsigned int NUM_MAPS = sizeof(arrMaps) / sizeof(arrMaps[0]);
+
+// The number of paths which are found on each map
+static const unsigned int NUM_PATHS = 4;
+
+/**
+ @brief Load the shipped maps into CMap2D, the first time that it is used
+ @param state A benchmark::State& which is skipped if the maps could not be loaded
+ @return The CMap2D, or NULL if the maps could not be loaded
+ */
+static CMap2D* GetMap2D(benchmark::State& state)
+{
+	static bool bLoaded = false;
+	CMap2D* cMap2D = CMap2D::GetInstance();
+	if (bLoaded == false)
+	{
+		if (cMap2D->Init(NUM_MAPS) == false)
+		{
+			state.SkipWithError("Failed to load CMap2D");
+			return NULL;
+		}
+		for (unsigned int i = 0; i < NUM_MAPS; i++)
+		{
+			if (cMap2D->LoadMap(arrMaps[i], i) == false)
+			{
+				state.SkipWithError("Failed to load the shipped maps");
+				return NULL;
+			}
+		}
+		bLoaded = true;
+	}
+	cMap2D->SetCurrentLevel(0);
+	return cMap2D;
+}
+
+static void BM_Map2D_GetMapInfo(benchmark::State& state)
+{
+	CMap2D* cMap2D = GetMap2D(state);
+	if (cMap2D == NULL)
+		return;
+
+	const unsigned int uiNumRows = CSettings::GetInstance()->NUM_TILES_YAXIS;
+	const unsigned int uiNumCols = CSettings::GetInstance()->NUM_TILES_XAXIS;
+	for (auto _ : state)
+	{
+		for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+			for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+				benchmark::DoNotOptimize(cMap2D->GetMapInfo(uiRow, uiCol));
+	}
+	state.SetItemsProcessed(state.iterations() * uiNumRows * uiNumCols);
+}
+BENCHMARK(BM_Map2D_GetMapInfo);
+
+static void BM_Map2D_isBlocked(benchmark::State& state)
+{
+	CMap2D* cMap2D = GetMap2D(state);
+	if (cMap2D == NULL)
+		return;
+
+	const unsigned int uiNumRows = CSettings::GetInstance()->NUM_TILES_YAXIS;
+	const unsigned int uiNumCols = CSettings::GetInstance()->NUM_TILES_XAXIS;
+	for (auto _ : state)
+	{
+		for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+			for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+				benchmark::DoNotOptimize(cMap2D->isBlocked(uiRow, uiCol));
+	}
+	state.SetItemsProcessed(state.iterations() * uiNumRows * uiNumCols);
+}
+BENCHMARK(BM_Map2D_isBlocked);
+
+// Finding the player is done when a level starts, and a value which is not there scans the whole map
+static void BM_Map2D_FindValue(benchmark::State& state, const int iValue)
+{
+	CMap2D* cMap2D = GetMap2D(state);
+	if (cMap2D == NULL)
+		return;
+
+	unsigned int uiRow = 0, uiCol = 0;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(cMap2D->FindValue(iValue, uiRow, uiCol));
+}
+BENCHMARK_CAPTURE(BM_Map2D_FindValue, player, (int)CMap2D::PLAYER);
+BENCHMARK_CAPTURE(BM_Map2D_FindValue, missing, -1);
+
+// Find paths between free tiles at fixed places in a map, from its ends inwards
+static void BM_Map2D_PathFind(benchmark::State& state, const unsigned int uiLevel)
+{
+	CMap2D* cMap2D = GetMap2D(state);
+	if (cMap2D == NULL)
+		return;
+	cMap2D->SetCurrentLevel(uiLevel);
+
+	const unsigned int uiNumRows = CSettings::GetInstance()->NUM_TILES_YAXIS;
+	const unsigned int uiNumCols = CSettings::GetInstance()->NUM_TILES_XAXIS;
+	vector<glm::i32vec2> vFreeTiles;
+	for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+			if (cMap2D->isBlocked(uiRow, uiCol) == false)
+				vFreeTiles.push_back(glm::i32vec2(uiCol, uiRow));
+	if (vFreeTiles.empty())
+	{
+		state.SkipWithError("The map has no free tiles");
+		return;
+	}
+
+	vector<glm::i32vec2> vStarts, vTargets;
+	for (unsigned int i = 0; i < NUM_PATHS; i++)
+	{
+		const size_t uiOffset = i * vFreeTiles.size() / (NUM_PATHS * 2);
+		vStarts.push_back(vFreeTiles[uiOffset]);
+		vTargets.push_back(vFreeTiles[vFreeTiles.size() - 1 - uiOffset]);
+	}
+
+	size_t uiPathLength = 0;
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NUM_PATHS; i++)
+		{
+			uiPathLength += cMap2D->PathFind(vStarts[i], vTargets[i], heuristic::manhattan, 1).size();
+			// The path is in the frame arena
+			CFrameArena::GetInstance()->Reset();
+		}
+	}
+	benchmark::DoNotOptimize(uiPathLength);
+	state.SetItemsProcessed(state.iterations() * NUM_PATHS);
+	cMap2D->SetCurrentLevel(0);
+}
+BENCHMARK_CAPTURE(BM_Map2D_PathFind, DOWN, 0)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Map2D_PathFind, UP, 1)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Map2D_PathFind, RIGHT, 2)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Map2D_PathFind, LEFT, 3)->Unit(benchmark::kMicrosecond);
+
+static void BM_Map2D_LoadMap(benchmark::State& state)
+{
+	CMap2D* cMap2D = GetMap2D(state);
+	if (cMap2D == NULL)
+		return;
+
+	for (auto _ : state)
+	{
+		if (cMap2D->LoadMap(arrMaps[0], 0) == false)
+		{
+			state.SkipWithError("Failed to load the map");
+			break;
+		}
+	}
+}
+BENCHMARK(BM_Map2D_LoadMap)->Unit(benchmark::kMicrosecond);
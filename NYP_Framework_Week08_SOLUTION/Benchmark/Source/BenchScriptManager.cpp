@@ -0,0 +1,51 @@
+/**
+ Benchmarks of CScriptManager
+
+ CScriptManager::get<T> of each type, from a global and from nested tables of Scripts/DM2240.lua.
+ */
+#include <benchmark/benchmark.h>
+
+// Include CScriptManager
+#include "Scripting/ScriptManager.h"
+
+// Include filesystem
+#include "GameControl/Settings.h"
+#include "System/filesystem.h"
+
+/**
+ @brief Load Scripts/DM2240.lua into CScriptManager, the first time that it is used
+ @param state A benchmark::State& which is skipped if the script could not be loaded
+ @return The CScriptManager, or NULL if the script could not be loaded
+ */
+static CScriptManager* GetScriptManager(benchmark::State& state)
+{
+	static bool bLoaded = false;
+	CScriptManager* cScriptManager = CScriptManager::GetInstance();
+	if (bLoaded == false)
+	{
+		if (cScriptManager->Init(	FileSystem::getPath("Scripts/DM2240.lua"),
+									FileSystem::getPath("Scripts/DM2240_LuaFunctions.lua")) == false)
+		{
+			state.SkipWithError("Failed to load the script Scripts/DM2240.lua");
+			return NULL;
+		}
+		bLoaded = true;
+	}
+	return cScriptManager;
+}
+
+template <class T>
+static void BM_CScriptManager_get(benchmark::State& state, const char* sKey)
+{
+	CScriptManager* cScriptManager = GetScriptManager(state);
+	if (cScriptManager == NULL)
+		return;
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(cScriptManager->get<T>(sKey));
+}
+BENCHMARK_CAPTURE(BM_CScriptManager_get<int>, int, "PlayerInfo.HP");
+BENCHMARK_CAPTURE(BM_CScriptManager_get<float>, float, "volumeLevel");
+BENCHMARK_CAPTURE(BM_CScriptManager_get<bool>, bool, "toggleBGM");
+BENCHMARK_CAPTURE(BM_CScriptManager_get<std::string>, string, "PlayerInfo.callsign");
+BENCHMARK_CAPTURE(BM_CScriptManager_get<glm::vec3>, vec3_nested, "WayPoints.Enemy_1.B");
@@ -0,0 +1,84 @@
+/**
+ Benchmarks of CSpriteAnimation
+
+ CSpriteAnimation::Update of each sprite, and CSpriteAnimation::UpdateBatch of all of them,
+ for looping sprites which are at different frames of a shared clip.
+ */
+#include <benchmark/benchmark.h>
+
+// Include Settings
+#include "GameControl/Settings.h"
+
+// Include CSpriteAnimation and the libraries which create it
+#include "Primitives/SpriteAnimation.h"
+#include "Primitives/MeshBuilder.h"
+#include "Primitives/AnimationClipLibrary.h"
+
+#include <vector>
+using namespace std;
+
+// The time of a frame of the game
+static const double FRAME_TIME = 1.0 / 60.0;
+
+/**
+ @brief Create looping sprites of 5 x 8 frames, which play a 40 frame clip from different frames
+ */
+static void CreateSprites(vector<CSpriteAnimation*>& vSprites, const unsigned int uiNumSprites)
+{
+	CSettings* cSettings = CSettings::GetInstance();
+	CAnimationClipSet* cClipSet = CAnimationClipLibrary::GetInstance()->GetClipSet("Benchmark");
+	if (cClipSet->GetNumClips() == 0)
+		cClipSet->AddClip("walk", 0, 40);
+
+	vSprites.resize(uiNumSprites);
+	for (unsigned int i = 0; i < uiNumSprites; i++)
+	{
+		vSprites[i] = CMeshBuilder::GenerateSpriteAnimation(5, 8, cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
+		vSprites[i]->SetClipSet(cClipSet);
+		vSprites[i]->PlayAnimation(cClipSet->GetClipHandle("walk"), -1, 1.0f);
+		vSprites[i]->Update(i * 0.01);
+	}
+}
+
+/**
+ @brief Delete the sprites which were created by CreateSprites
+ */
+static void DeleteSprites(vector<CSpriteAnimation*>& vSprites)
+{
+	for (unsigned int i = 0; i < vSprites.size(); i++)
+		delete vSprites[i];
+	vSprites.clear();
+}
+
+static void BM_CSpriteAnimation_Update(benchmark::State& state)
+{
+	vector<CSpriteAnimation*> vSprites;
+	CreateSprites(vSprites, (unsigned int)state.range(0));
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < vSprites.size(); i++)
+			vSprites[i]->Update(FRAME_TIME);
+		benchmark::DoNotOptimize(vSprites[0]->GetCurrentFrame());
+	}
+	state.SetItemsProcessed(state.iterations() * vSprites.size());
+
+	DeleteSprites(vSprites);
+}
+BENCHMARK(BM_CSpriteAnimation_Update)->Arg(256);
+
+static void BM_CSpriteAnimation_UpdateBatch(benchmark::State& state)
+{
+	vector<CSpriteAnimation*> vSprites;
+	CreateSprites(vSprites, (unsigned int)state.range(0));
+
+	for (auto _ : state)
+	{
+		CSpriteAnimation::UpdateBatch(&vSprites[0], (unsigned int)vSprites.size(), FRAME_TIME);
+		benchmark::DoNotOptimize(vSprites[0]->GetCurrentFrame());
+	}
+	state.SetItemsProcessed(state.iterations() * vSprites.size());
+
+	DeleteSprites(vSprites);
+}
+BENCHMARK(BM_CSpriteAnimation_UpdateBatch)->Arg(256);
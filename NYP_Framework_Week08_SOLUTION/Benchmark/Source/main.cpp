@@ -0,0 +1,51 @@
+/**
+ Benchmarks
+
+ Micro-benchmarks of the hot paths of the framework, so that a change which slows them down
+ shows up as a number. They run headless: there is no window or OpenGL context, so the meshes
+ and textures are never uploaded. Run with --help for the options of Google Benchmark, e.g.
+ --benchmark_filter=Map2D or --benchmark_out=results.json to compare two builds.
+ */
+#include <benchmark/benchmark.h>
+
+// Include Settings
+#include "GameControl/Settings.h"
+
+// Include CFrameArena, which holds the paths of CMap2D::PathFind
+#include "System/FrameArena.h"
+
+// Include CProfiler
+#include "TimeControl/Profiler.h"
+
+#ifdef _WIN32
+	#include <direct.h>
+	#define chdir _chdir
+#else
+	#include <unistd.h>
+#endif
+
+#include <iostream>
+using namespace std;
+
+int main(int argc, char** argv)
+{
+	// The files are loaded relative to the App folder, as when the game is run
+	if (chdir(BENCHMARK_APP_DIR) != 0)
+	{
+		cout << "Unable to open " << BENCHMARK_APP_DIR << endl;
+		return 1;
+	}
+
+	CSettings::GetInstance()->bHeadless = true;
+	// The scopes of the CProfiler would be timed along with the code they are in
+	CProfiler::GetInstance()->SetEnabled(false);
+	CFrameArena::GetInstance()->Init();
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
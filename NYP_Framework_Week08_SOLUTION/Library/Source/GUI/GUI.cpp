@@ -6,10 +6,10 @@
 #include "GUI.h"
 
  // Include Shader Manager
-#include "..\RenderControl\ShaderManager.h"
+#include "../RenderControl/ShaderManager.h"
 
 // Include ImageLoader
-#include "..\System\ImageLoader.h"
+#include "../System/ImageLoader.h"
 
 #include <iostream>
 using namespace std;
@@ -19,6 +19,7 @@ using namespace std;
  */
 CGUI::CGUI(void)
 	: cTextRenderer(NULL)
+	, iTitleText(-1)
 	, cSettings(NULL)
 {
 }
@@ -46,6 +47,7 @@ CGUI::~CGUI(void)
 
 	if (cTextRenderer)
 	{
+		cTextRenderer->DeleteStaticText(iTitleText);
 		cTextRenderer->Destroy();
 		cTextRenderer = NULL;
 	}
@@ -69,6 +71,8 @@ bool CGUI::Init(void)
 		cout << "Failed to load CTextRenderer" << endl;
 		return false;
 	}
+	// The title does not change, so its quads are built once
+	iTitleText = cTextRenderer->CreateStaticText("DM2213 2D Game Creation", 10.0f, 10.0f, 0.5f);
 
 	// Store the CFPSCounter singleton instance here
 	cFPSCounter = CFPSCounter::GetInstance();
@@ -192,11 +196,11 @@ void CGUI::PreRender(void)
  */
 void CGUI::Render(void)
 {
-	//// Call the CTextRenderer's Render()
-	//cTextRenderer->Render("DM2213 2D Game Creation", 10.0f, 10.0f, 0.5f, glm::vec3(1.0f, 1.0f, 0.0f));
-	//// Render FPS info
-	//cTextRenderer->Render(	cFPSCounter->GetFrameRateString(),
-	//						10.0f, 580.0f, 0.5f, glm::vec3(1.0f, 1.0f, 0.0f));
+	// Render the title
+	cTextRenderer->RenderStaticText(iTitleText, glm::vec3(1.0f, 1.0f, 0.0f));
+	// Render FPS info
+	cTextRenderer->Render(	cFPSCounter->GetFrameRateString(),
+							10.0f, 580.0f, 0.5f, glm::vec3(1.0f, 1.0f, 0.0f));
 
 	// Rendering
 	ImGui::Render();
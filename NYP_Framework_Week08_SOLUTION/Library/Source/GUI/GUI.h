@@ -15,7 +15,7 @@
 #include "../RenderControl/TextRenderer.h"
 
 // FPS Counter
-#include "../TimeControl\FPSCounter.h"
+#include "../TimeControl/FPSCounter.h"
 
 // Include GLEW
 #ifndef GLEW_STATIC
@@ -32,8 +32,8 @@
 // Important: GLEW and GLFW must be included before IMGUI
 #ifndef IMGUI_ACTIVE
 #include "imgui.h"
-#include "backends\imgui_impl_glfw.h"
-#include "backends\imgui_impl_opengl3.h"
+#include "backends/imgui_impl_glfw.h"
+#include "backends/imgui_impl_opengl3.h"
 #define IMGUI_ACTIVE
 #endif
 
@@ -70,6 +70,8 @@ protected:
 
 	// The handler containing the instance of the CTextRenderer
 	CTextRenderer* cTextRenderer;
+	// The handle of the title, which is built once with CTextRenderer::CreateStaticText
+	int iTitleText;
 
 	// FPS Control
 	CFPSCounter* cFPSCounter;
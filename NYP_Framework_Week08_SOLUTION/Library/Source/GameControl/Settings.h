@@ -8,7 +8,9 @@
 // Include SingletonTemplate
 #include "../DesignPatterns/SingletonTemplate.h"
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
 // Include GLEW
 #ifndef GLEW_STATIC
@@ -18,6 +20,8 @@
 // Include GLFW
 #include <GLFW/glfw3.h>
 
+#include <string>
+
 class CSettings : public CSingletonTemplate<CSettings>
 {
 	friend CSingletonTemplate<CSettings>;
@@ -46,10 +50,42 @@ public:
 	bool bDisableMousePointer = true;
 	bool bShowMousePointer = false;
 
+	// Rendering Information
+	// Let the vertex shader select the frames of the enemies and bombs, and draw them with instancing
+	bool bGPUSpriteAnimation = true;
+
 	// Frame Rate Information
 	const unsigned char FPS = 30; // FPS of this game
 	const unsigned int frameTime = 1000 / FPS; // time for each frame
 
+	// Scene Information
+	// Show the 3D field of structures drawn by CInstancedRenderer, instead of the 2D game
+	bool bScene3D = false;
+
+	// Headless Information
+	// Run the simulation without a window, an OpenGL context or sound output, as fast as possible
+	bool bHeadless = false;
+	// The number of frames to simulate in headless mode. 0 means until the game ends.
+	unsigned int uiHeadlessFrames = 0;
+	// The time step of each frame in headless mode, in seconds
+	double dHeadlessTimeStep = 1.0 / 60.0;
+	// The file of scripted keyboard input for headless mode. Empty means no input.
+	std::string sInputScript;
+
+	// Trace Information
+	// The file to record a trace of the session into, from the start. Empty means no trace.
+	std::string sTraceFile;
+
+	// Frame Time Information
+	// The file to save the frame time statistics to on exit, as CSV or as JSON if it ends in .json. Empty means no file.
+	std::string sFrameTimeReport;
+
+	// Input Recording Information
+	// The file to record the input of the session into. Empty means no recording.
+	std::string sRecordFile;
+	// The file of recorded input to replay, in place of the keyboard and mouse. Empty means no replay.
+	std::string sReplayFile;
+
 	// Input control
 	//const bool bActivateMouseInput
 
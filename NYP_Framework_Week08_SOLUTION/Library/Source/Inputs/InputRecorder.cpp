@@ -0,0 +1,317 @@
+/**
+ CInputRecorder
+ */
+#include "InputRecorder.h"
+
+// Include CKeyboardController
+#include "KeyboardController.h"
+// Include CMouseController
+#include "MouseController.h"
+
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+// The first bytes of the file, to check that it is a recording
+static const char RECORDING_MAGIC[4] = { 'N', 'Y', 'P', 'R' };
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CInputRecorder::CInputRecorder(void)
+	: uiNext(0)
+	, uiSeed(0)
+	, uiNumFrames(0)
+	, dMouseX(0.0)
+	, dMouseY(0.0)
+	, bHasMousePosition(false)
+	, bRecording(false)
+	, bReplaying(false)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CInputRecorder::~CInputRecorder(void)
+{
+	Stop();
+}
+
+/**
+ @brief Start recording into a file. A recording or replay which is in progress is stopped first.
+ @param filename A const std::string& containing the name of the file
+ @param uiSeed A const unsigned int containing the seed which the random number generator was initialised with
+ @return true if the file was opened, else false
+ */
+bool CInputRecorder::StartRecording(const std::string& filename, const unsigned int uiSeed)
+{
+	Stop();
+
+	if (cBufferedWriter.Open(filename, CBufferedWriter::DEFAULT_CAPACITY, true) == false)
+	{
+		cout << "CInputRecorder: Unable to open " << filename << endl;
+		return false;
+	}
+
+	sFilename = filename;
+	this->uiSeed = uiSeed;
+	uiNumFrames = 0;
+	bHasMousePosition = false;
+
+	cBufferedWriter.WriteBytes(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+	Write((unsigned int)VERSION);
+	Write(uiSeed);
+
+	bRecording = true;
+	cout << "CInputRecorder: Recording to " << sFilename << endl;
+	return true;
+}
+
+/**
+ @brief Load a file and start replaying it. A recording or replay which is in progress is stopped first.
+ @param filename A const std::string& containing the name of the file
+ @return true if the file is a recording, else false
+ */
+bool CInputRecorder::StartReplay(const std::string& filename)
+{
+	Stop();
+
+	ifstream file(filename.c_str(), ios::binary);
+	if (!file.is_open())
+	{
+		cout << "CInputRecorder: Unable to open " << filename << endl;
+		return false;
+	}
+	vData.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+	uiNext = 0;
+
+	// Check the header
+	char arrMagic[sizeof(RECORDING_MAGIC)];
+	unsigned int uiVersion = 0;
+	if ((Read(arrMagic) == false) || (memcmp(arrMagic, RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) != 0)
+		|| (Read(uiVersion) == false) || (uiVersion != VERSION)
+		|| (Read(uiSeed) == false))
+	{
+		cout << "CInputRecorder: " << filename << " is not a recording of version " << VERSION << endl;
+		vData.clear();
+		return false;
+	}
+
+	sFilename = filename;
+	uiNumFrames = 0;
+	bHasMousePosition = false;
+
+	bReplaying = true;
+	cout << "CInputRecorder: Replaying " << sFilename << endl;
+	return true;
+}
+
+/**
+ @brief Stop recording or replaying
+ */
+void CInputRecorder::Stop(void)
+{
+	if (bRecording)
+	{
+		bRecording = false;
+		cBufferedWriter.Close();
+		cout << "CInputRecorder: Recorded " << uiNumFrames << " frames to " << sFilename << endl;
+	}
+	if (bReplaying)
+	{
+		bReplaying = false;
+		vData.clear();
+		cout << "CInputRecorder: Replayed " << uiNumFrames << " frames from " << sFilename << endl;
+	}
+}
+
+/**
+ @brief Check if the input is being recorded
+ */
+bool CInputRecorder::IsRecording(void) const
+{
+	return bRecording;
+}
+
+/**
+ @brief Check if the input is being replayed
+ */
+bool CInputRecorder::IsReplaying(void) const
+{
+	return bReplaying;
+}
+
+/**
+ @brief Get the seed of the random number generator of the recording
+ */
+unsigned int CInputRecorder::GetSeed(void) const
+{
+	return uiSeed;
+}
+
+/**
+ @brief Get the number of frames which have been recorded or replayed
+ */
+unsigned int CInputRecorder::GetNumFrames(void) const
+{
+	return uiNumFrames;
+}
+
+/**
+ @brief Record a key event
+ @param iKey A const int containing the GLFW key code
+ @param iAction A const int containing the GLFW action
+ */
+void CInputRecorder::RecordKey(const int iKey, const int iAction)
+{
+	if (bRecording == false)
+		return;
+
+	Write((unsigned char)KEY);
+	Write((short)iKey);
+	Write((unsigned char)iAction);
+}
+
+/**
+ @brief Record the position of the mouse. It is only written when it changes, as it is polled every frame.
+ @param dX A const double containing the position in the x-axis
+ @param dY A const double containing the position in the y-axis
+ */
+void CInputRecorder::RecordMousePosition(const double dX, const double dY)
+{
+	if (bRecording == false)
+		return;
+	if (bHasMousePosition && (dX == dMouseX) && (dY == dMouseY))
+		return;
+
+	dMouseX = dX;
+	dMouseY = dY;
+	bHasMousePosition = true;
+
+	Write((unsigned char)MOUSE_POSITION);
+	Write(dX);
+	Write(dY);
+}
+
+/**
+ @brief Record a mouse button event
+ @param iButton A const int containing the button ID
+ @param bPressed A const bool which is true if the button was pressed, or false if it was released
+ */
+void CInputRecorder::RecordMouseButton(const int iButton, const bool bPressed)
+{
+	if (bRecording == false)
+		return;
+
+	Write((unsigned char)MOUSE_BUTTON);
+	Write((unsigned char)iButton);
+	Write((unsigned char)(bPressed ? 1 : 0));
+}
+
+/**
+ @brief Record a mouse scroll event
+ @param dOffsetX A const double containing the scroll offset in the x-axis
+ @param dOffsetY A const double containing the scroll offset in the y-axis
+ */
+void CInputRecorder::RecordMouseScroll(const double dOffsetX, const double dOffsetY)
+{
+	if (bRecording == false)
+		return;
+
+	Write((unsigned char)MOUSE_SCROLL);
+	Write(dOffsetX);
+	Write(dOffsetY);
+}
+
+/**
+ @brief End the frame which is being recorded. The input which was recorded since the last frame is sent at the end of this frame.
+ @param dElapsedTime A const double containing the elapsed time which the next frame is updated with, in seconds
+ */
+void CInputRecorder::EndFrame(const double dElapsedTime)
+{
+	if (bRecording == false)
+		return;
+
+	Write((unsigned char)FRAME);
+	Write(dElapsedTime);
+	uiNumFrames++;
+}
+
+/**
+ @brief Send the input of the next frame to the controllers, in the order that it was recorded, and get its elapsed time.
+		The mouse position is sent every frame, as it was polled every frame when it was recorded.
+ @param dElapsedTime A double& which is set to the elapsed time which the next frame is updated with, in seconds
+ @return true if a frame was replayed, or false if the recording has ended
+ */
+bool CInputRecorder::ReplayFrame(double& dElapsedTime)
+{
+	if (bReplaying == false)
+		return false;
+
+	CKeyboardController* cKeyboardController = CKeyboardController::GetInstance();
+	CMouseController* cMouseController = CMouseController::GetInstance();
+
+	unsigned char ucType;
+	while (Read(ucType))
+	{
+		bool bResult = true;
+		switch (ucType)
+		{
+		case FRAME:
+			bResult = Read(dElapsedTime);
+			if (bResult)
+			{
+				if (bHasMousePosition)
+					cMouseController->UpdateMousePosition(dMouseX, dMouseY);
+				uiNumFrames++;
+				return true;
+			}
+			break;
+		case KEY:
+		{
+			short sKey;
+			unsigned char ucAction;
+			bResult = Read(sKey) && Read(ucAction);
+			if (bResult)
+				cKeyboardController->Update(sKey, ucAction);
+			break;
+		}
+		case MOUSE_POSITION:
+			bResult = Read(dMouseX) && Read(dMouseY);
+			bHasMousePosition = bResult;
+			break;
+		case MOUSE_BUTTON:
+		{
+			unsigned char ucButton, ucPressed;
+			bResult = Read(ucButton) && Read(ucPressed);
+			if (bResult && ucPressed)
+				cMouseController->UpdateMouseButtonPressed(ucButton);
+			else if (bResult)
+				cMouseController->UpdateMouseButtonReleased(ucButton);
+			break;
+		}
+		case MOUSE_SCROLL:
+		{
+			double dOffsetX, dOffsetY;
+			bResult = Read(dOffsetX) && Read(dOffsetY);
+			if (bResult)
+				cMouseController->UpdateMouseScroll(dOffsetX, dOffsetY);
+			break;
+		}
+		default:
+			bResult = false;
+			break;
+		}
+
+		if (bResult == false)
+		{
+			cout << "CInputRecorder: Invalid record at byte " << uiNext << " of " << sFilename << endl;
+			break;
+		}
+	}
+
+	// The recording has ended, or a record was cut off
+	Stop();
+	return false;
+}
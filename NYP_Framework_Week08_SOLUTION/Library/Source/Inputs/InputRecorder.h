@@ -0,0 +1,127 @@
+/**
+ CInputRecorder
+
+ Records the keyboard and mouse input of a session, the time of each frame and the seed of the
+ random number generator into a binary file, and replays them later. A replay sends the same
+ input to CKeyboardController and CMouseController on the same frames, and gives each frame the
+ same elapsed time, so the scene is updated exactly as it was in the recorded session. The
+ replay can also be run headless, as fast as possible.
+
+ The file starts with a header, followed by one record for each input event. Each record is a
+ byte for its type followed by its values. A FRAME record with the elapsed time ends each frame.
+ Input which does not go through the controllers, e.g. clicking on the ImGui windows, is not
+ recorded.
+
+ Usage, when recording:
+	cInputRecorder->StartRecording("session.rec", uiSeed);
+	cInputRecorder->RecordKey(key, action);					// in the input callbacks
+	cInputRecorder->EndFrame(dElapsedTime);					// at the end of each frame
+ Usage, when replaying:
+	cInputRecorder->StartReplay("session.rec");
+	Math::InitRNG(cInputRecorder->GetSeed());
+	cInputRecorder->ReplayFrame(dElapsedTime);				// at the end of each frame
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include CBufferedWriter
+#include "../System/BufferedWriter.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+class CInputRecorder : public CSingletonTemplate<CInputRecorder>
+{
+	friend CSingletonTemplate<CInputRecorder>;
+public:
+	// The version of the file format. Increase this when a record changes.
+	static const unsigned int VERSION = 1;
+
+	// Start recording into a file
+	bool StartRecording(const std::string& filename, const unsigned int uiSeed);
+	// Load a file and start replaying it
+	bool StartReplay(const std::string& filename);
+	// Stop recording or replaying
+	void Stop(void);
+
+	// Check if the input is being recorded
+	bool IsRecording(void) const;
+	// Check if the input is being replayed
+	bool IsReplaying(void) const;
+	// Get the seed of the random number generator of the recording
+	unsigned int GetSeed(void) const;
+	// Get the number of frames which have been recorded or replayed
+	unsigned int GetNumFrames(void) const;
+
+	// Record a key event
+	void RecordKey(const int iKey, const int iAction);
+	// Record the position of the mouse. It is only written when it changes.
+	void RecordMousePosition(const double dX, const double dY);
+	// Record a mouse button event
+	void RecordMouseButton(const int iButton, const bool bPressed);
+	// Record a mouse scroll event
+	void RecordMouseScroll(const double dOffsetX, const double dOffsetY);
+	// End the frame which is being recorded
+	void EndFrame(const double dElapsedTime);
+
+	// Send the input of the next frame to the controllers, and get its elapsed time
+	bool ReplayFrame(double& dElapsedTime);
+
+protected:
+	// The types of the records
+	enum RECORD_TYPE
+	{
+		FRAME = 0,
+		KEY,
+		MOUSE_POSITION,
+		MOUSE_BUTTON,
+		MOUSE_SCROLL,
+		NUM_RECORD_TYPES
+	};
+
+	// The output file when recording
+	CBufferedWriter cBufferedWriter;
+	// The contents of the file when replaying, and the position of the next record in it
+	std::vector<unsigned char> vData;
+	size_t uiNext;
+
+	// The name of the file
+	std::string sFilename;
+	// The seed of the random number generator
+	unsigned int uiSeed;
+	// The number of frames which have been recorded or replayed
+	unsigned int uiNumFrames;
+	// The last position of the mouse, so that it is only recorded when it changes
+	double dMouseX, dMouseY;
+	bool bHasMousePosition;
+
+	// Whether the input is being recorded or replayed
+	bool bRecording;
+	bool bReplaying;
+
+	// Append a value to the file
+	template <typename T>
+	void Write(const T& value)
+	{
+		cBufferedWriter.WriteBytes(&value, sizeof(T));
+	}
+	// Read the next value of the file. Returns false if the file has ended.
+	template <typename T>
+	bool Read(T& value)
+	{
+		if (vData.size() - uiNext < sizeof(T))
+			return false;
+		memcpy(&value, &vData[uiNext], sizeof(T));
+		uiNext += sizeof(T);
+		return true;
+	}
+
+	// Constructor
+	CInputRecorder(void);
+
+	// Destructor
+	virtual ~CInputRecorder(void);
+};
@@ -0,0 +1,147 @@
+/**
+ CInputScript
+ */
+#include "InputScript.h"
+
+// Include CKeyboardController
+#include "KeyboardController.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+CInputScript::CInputScript(void)
+	: uiNext(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CInputScript::~CInputScript(void)
+{
+}
+
+/**
+ @brief Load the events from a file. The events which were loaded before are removed.
+ @param filename A const std::string& containing the name of the file
+ @return true if the file was loaded, else false
+ */
+bool CInputScript::Load(const std::string& filename)
+{
+	Clear();
+
+	ifstream file(filename.c_str());
+	if (!file.is_open())
+	{
+		cout << "CInputScript: Unable to open " << filename << endl;
+		return false;
+	}
+
+	string sLine;
+	unsigned int uiLine = 0;
+	while (getline(file, sLine))
+	{
+		uiLine++;
+
+		istringstream ssLine(sLine);
+		string sFrame, sKey, sAction;
+		if (!(ssLine >> sFrame) || (sFrame[0] == '#'))
+			continue;
+
+		SEvent sEvent;
+		sEvent.uiFrame = (unsigned int)strtoul(sFrame.c_str(), NULL, 10);
+		sEvent.iKey = (ssLine >> sKey) ? ParseKey(sKey) : -1;
+		sEvent.iAction = (ssLine >> sAction) ? ParseAction(sAction) : -1;
+		if ((isdigit((unsigned char)sFrame[0]) == 0) || (sEvent.iKey < 0) || (sEvent.iAction < 0))
+		{
+			cout << "CInputScript: Invalid event on line " << uiLine << " of " << filename << endl;
+			Clear();
+			return false;
+		}
+		vEvents.push_back(sEvent);
+	}
+
+	// Events in the same frame are kept in the order of the file
+	stable_sort(vEvents.begin(), vEvents.end(),
+				[](const SEvent& a, const SEvent& b) { return a.uiFrame < b.uiFrame; });
+	return true;
+}
+
+/**
+ @brief Remove all the events
+ */
+void CInputScript::Clear(void)
+{
+	vEvents.clear();
+	uiNext = 0;
+}
+
+/**
+ @brief Send the events of a frame, and any earlier events which were not sent yet, to CKeyboardController
+ @param uiFrame A const unsigned int containing the number of the frame
+ */
+void CInputScript::Update(const unsigned int uiFrame)
+{
+	CKeyboardController* cKeyboardController = CKeyboardController::GetInstance();
+	while ((uiNext < vEvents.size()) && (vEvents[uiNext].uiFrame <= uiFrame))
+	{
+		cKeyboardController->Update(vEvents[uiNext].iKey, vEvents[uiNext].iAction);
+		uiNext++;
+	}
+}
+
+/**
+ @brief Check if all the events have been sent
+ */
+bool CInputScript::IsFinished(void) const
+{
+	return uiNext >= vEvents.size();
+}
+
+/**
+ @brief Get the number of events
+ */
+unsigned int CInputScript::GetNumEvents(void) const
+{
+	return (unsigned int)vEvents.size();
+}
+
+/**
+ @brief Convert a token to a GLFW key code. A single character is the key with that character, as
+		GLFW uses the upper case ASCII codes for the letters and digits. Other tokens are key codes.
+ @param sToken A const std::string& containing the token
+ @return The key code, or -1 if the token is not a key
+ */
+int CInputScript::ParseKey(const std::string& sToken)
+{
+	if (sToken.size() == 1)
+		return toupper((unsigned char)sToken[0]);
+
+	char* pEnd = NULL;
+	long lKey = strtol(sToken.c_str(), &pEnd, 10);
+	if ((*pEnd != '\0') || (lKey < 0) || (lKey >= CKeyboardController::MAX_KEYS))
+		return -1;
+	return (int)lKey;
+}
+
+/**
+ @brief Convert a token to a GLFW action
+ @param sToken A const std::string& containing the token
+ @return 1 for press, 0 for release, or -1 if the token is not an action
+ */
+int CInputScript::ParseAction(const std::string& sToken)
+{
+	if ((sToken == "press") || (sToken == "1"))
+		return 1;
+	if ((sToken == "release") || (sToken == "0"))
+		return 0;
+	return -1;
+}
@@ -0,0 +1,59 @@
+/**
+ CInputScript
+
+ Drives CKeyboardController from a text file instead of a window, so that a game can be run
+ headless with the same input every time. Each line holds one key event:
+	<frame> <key> <action>
+ where frame is the number of the frame in which the event happens, key is a GLFW key code or a
+ single character (e.g. 68 or D), and action is press, release, 1 or 0. Empty lines and lines
+ starting with # are ignored. The events do not need to be sorted.
+
+ Usage, every frame before updating the scene:
+	cInputScript.Update(uiFrame);
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+class CInputScript
+{
+public:
+	// Constructor
+	CInputScript(void);
+
+	// Destructor
+	virtual ~CInputScript(void);
+
+	// Load the events from a file
+	bool Load(const std::string& filename);
+	// Remove all the events
+	void Clear(void);
+
+	// Send the events of a frame to CKeyboardController
+	void Update(const unsigned int uiFrame);
+
+	// Check if all the events have been sent
+	bool IsFinished(void) const;
+	// Get the number of events
+	unsigned int GetNumEvents(void) const;
+
+protected:
+	// A key event
+	struct SEvent
+	{
+		unsigned int uiFrame;
+		int iKey;
+		int iAction;
+	};
+
+	// The events, sorted by frame
+	std::vector<SEvent> vEvents;
+	// The index of the next event to send
+	unsigned int uiNext;
+
+	// Convert a token to a GLFW key code. Returns -1 if the token is not a key.
+	static int ParseKey(const std::string& sToken);
+	// Convert a token to a GLFW action. Returns -1 if the token is not an action.
+	static int ParseAction(const std::string& sToken);
+};
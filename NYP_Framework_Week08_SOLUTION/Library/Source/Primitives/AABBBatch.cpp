@@ -0,0 +1,229 @@
+/**
+ CAABBBatch
+ */
+#include "AABBBatch.h"
+
+#if defined(AABB_BATCH_AVX)
+	#include <immintrin.h>
+#elif defined(AABB_BATCH_SSE)
+	#include <xmmintrin.h>
+#endif
+
+#include <cfloat>
+
+/**
+ @brief Constructor
+ @param iNumAxes A const int containing the number of axes of the boxes, 2 or 3
+ @param bInclusive A const bool which is true if touching boxes overlap
+ */
+CAABBBatch::CAABBBatch(const int iNumAxes, const bool bInclusive)
+	: iNumAxes(iNumAxes < 1 ? 1 : (iNumAxes > 3 ? 3 : iNumAxes))
+	, bInclusive(bInclusive)
+	, uiNumBoxes(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CAABBBatch::~CAABBBatch(void)
+{
+}
+
+/**
+ @brief Set the number of boxes. New boxes are empty and never overlap anything.
+ @param uiNumBoxes A const unsigned int containing the number of boxes
+ */
+void CAABBBatch::Resize(const unsigned int uiNumBoxes)
+{
+	unsigned int uiPadded = (uiNumBoxes + BATCH_WIDTH - 1) / BATCH_WIDTH * BATCH_WIDTH;
+
+	// An empty box has min > max, so every comparison with it fails
+	for (int i = 0; i < iNumAxes; i++)
+	{
+		vMin[i].resize(uiPadded, FLT_MAX);
+		vMax[i].resize(uiPadded, -FLT_MAX);
+	}
+
+	// Clear the boxes which were removed but are still in the padding
+	for (unsigned int j = uiNumBoxes; (j < this->uiNumBoxes) && (j < uiPadded); j++)
+		SetEmpty(j);
+
+	this->uiNumBoxes = uiNumBoxes;
+}
+
+/**
+ @brief Remove all the boxes
+ */
+void CAABBBatch::Clear(void)
+{
+	for (int i = 0; i < iNumAxes; i++)
+	{
+		vMin[i].clear();
+		vMax[i].clear();
+	}
+	uiNumBoxes = 0;
+}
+
+/**
+ @brief Get the number of boxes
+ */
+unsigned int CAABBBatch::GetSize(void) const
+{
+	return uiNumBoxes;
+}
+
+/**
+ @brief Add a box
+ @param arrMin A const float* containing the min corner of the box
+ @param arrMax A const float* containing the max corner of the box
+ @return The index of the box
+ */
+unsigned int CAABBBatch::Add(const float* arrMin, const float* arrMax)
+{
+	unsigned int uiIndex = uiNumBoxes;
+	Resize(uiNumBoxes + 1);
+	SetBox(uiIndex, arrMin, arrMax);
+	return uiIndex;
+}
+
+/**
+ @brief Set a box
+ @param uiIndex A const unsigned int containing the index of the box
+ @param arrMin A const float* containing the min corner of the box
+ @param arrMax A const float* containing the max corner of the box
+ */
+void CAABBBatch::SetBox(const unsigned int uiIndex, const float* arrMin, const float* arrMax)
+{
+	for (int i = 0; i < iNumAxes; i++)
+	{
+		vMin[i][uiIndex] = arrMin[i];
+		vMax[i][uiIndex] = arrMax[i];
+	}
+}
+
+/**
+ @brief Make a box empty, so that it never overlaps anything
+ @param uiIndex A const unsigned int containing the index of the box
+ */
+void CAABBBatch::SetEmpty(const unsigned int uiIndex)
+{
+	for (int i = 0; i < iNumAxes; i++)
+	{
+		vMin[i][uiIndex] = FLT_MAX;
+		vMax[i][uiIndex] = -FLT_MAX;
+	}
+}
+
+/**
+ @brief Test a box against all the boxes.
+		On each axis, box A overlaps box B if A.min <= B.max and B.min <= A.max,
+		or B.min < A.max if this batch is not inclusive.
+ @param arrMin A const float* containing the min corner of the tested box
+ @param arrMax A const float* containing the max corner of the tested box
+ @param vMask A std::vector<unsigned int>& which will receive 1 bit per box
+ */
+void CAABBBatch::Test(const float* arrMin, const float* arrMax, std::vector<unsigned int>& vMask) const
+{
+	unsigned int uiPadded = (unsigned int)vMin[0].size();
+	vMask.assign((uiPadded + 31) / 32, 0);
+
+#if defined(AABB_BATCH_AVX)
+	__m256 arrTestMin[3], arrTestMax[3];
+	for (int i = 0; i < iNumAxes; i++)
+	{
+		arrTestMin[i] = _mm256_set1_ps(arrMin[i]);
+		arrTestMax[i] = _mm256_set1_ps(arrMax[i]);
+	}
+
+	for (unsigned int j = 0; j < uiPadded; j += 8)
+	{
+		__m256 result = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (int i = 0; i < iNumAxes; i++)
+		{
+			__m256 otherMin = _mm256_loadu_ps(&vMin[i][j]);
+			__m256 otherMax = _mm256_loadu_ps(&vMax[i][j]);
+			result = _mm256_and_ps(result, _mm256_cmp_ps(arrTestMin[i], otherMax, _CMP_LE_OQ));
+			// The predicate of _mm256_cmp_ps must be a constant
+			if (bInclusive)
+				result = _mm256_and_ps(result, _mm256_cmp_ps(otherMin, arrTestMax[i], _CMP_LE_OQ));
+			else
+				result = _mm256_and_ps(result, _mm256_cmp_ps(otherMin, arrTestMax[i], _CMP_LT_OQ));
+		}
+		vMask[j / 32] |= (unsigned int)_mm256_movemask_ps(result) << (j % 32);
+	}
+#elif defined(AABB_BATCH_SSE)
+	__m128 arrTestMin[3], arrTestMax[3];
+	for (int i = 0; i < iNumAxes; i++)
+	{
+		arrTestMin[i] = _mm_set1_ps(arrMin[i]);
+		arrTestMax[i] = _mm_set1_ps(arrMax[i]);
+	}
+
+	for (unsigned int j = 0; j < uiPadded; j += 4)
+	{
+		__m128 result = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+		for (int i = 0; i < iNumAxes; i++)
+		{
+			__m128 otherMin = _mm_loadu_ps(&vMin[i][j]);
+			__m128 otherMax = _mm_loadu_ps(&vMax[i][j]);
+			result = _mm_and_ps(result, _mm_cmple_ps(arrTestMin[i], otherMax));
+			if (bInclusive)
+				result = _mm_and_ps(result, _mm_cmple_ps(otherMin, arrTestMax[i]));
+			else
+				result = _mm_and_ps(result, _mm_cmplt_ps(otherMin, arrTestMax[i]));
+		}
+		vMask[j / 32] |= (unsigned int)_mm_movemask_ps(result) << (j % 32);
+	}
+#else
+	for (unsigned int j = 0; j < uiNumBoxes; j++)
+	{
+		bool bOverlap = true;
+		for (int i = 0; i < iNumAxes; i++)
+		{
+			bOverlap = bOverlap && (arrMin[i] <= vMax[i][j]);
+			bOverlap = bOverlap && (bInclusive ? (vMin[i][j] <= arrMax[i]) : (vMin[i][j] < arrMax[i]));
+		}
+		if (bOverlap)
+			vMask[j / 32] |= 1u << (j % 32);
+	}
+#endif
+}
+
+/**
+ @brief Test a box against all the boxes, and get the indices of the overlapping boxes
+ @param arrMin A const float* containing the min corner of the tested box
+ @param arrMax A const float* containing the max corner of the tested box
+ @param vMask A std::vector<unsigned int>& which will receive 1 bit per box
+ @param vIndices A std::vector<unsigned int>& which will receive the indices of the overlapping boxes
+ */
+void CAABBBatch::Test(const float* arrMin, const float* arrMax, std::vector<unsigned int>& vMask,
+					  std::vector<unsigned int>& vIndices) const
+{
+	Test(arrMin, arrMax, vMask);
+
+	vIndices.clear();
+	for (unsigned int w = 0; w < vMask.size(); w++)
+	{
+		unsigned int uiBits = vMask[w];
+		for (unsigned int b = 0; uiBits != 0; b++, uiBits >>= 1)
+		{
+			if ((uiBits & 1u) && (w * 32 + b < uiNumBoxes))
+				vIndices.push_back(w * 32 + b);
+		}
+	}
+}
+
+/**
+ @brief Get the name of the instruction set which is used
+ */
+const char* CAABBBatch::GetInstructionSet(void)
+{
+#if defined(AABB_BATCH_AVX)
+	return "AVX";
+#elif defined(AABB_BATCH_SSE)
+	return "SSE";
+#else
+	return "Scalar";
+#endif
+}
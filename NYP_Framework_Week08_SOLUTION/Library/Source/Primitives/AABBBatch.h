@@ -0,0 +1,77 @@
+/**
+ CAABBBatch
+
+ Stores many axis-aligned boxes as separate arrays per axis (structure of arrays), so that one box
+ can be tested against 8 boxes per AVX instruction or 4 per SSE instruction. A scalar loop is used
+ when neither is enabled in the compiler settings, or when AABB_BATCH_NO_SIMD is defined.
+ */
+#pragma once
+
+#include <vector>
+
+#if !defined(AABB_BATCH_NO_SIMD) && defined(__AVX__)
+	#define AABB_BATCH_AVX
+#elif !defined(AABB_BATCH_NO_SIMD) && (defined(_M_X64) || defined(__SSE__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1)))
+	#define AABB_BATCH_SSE
+#endif
+
+class CAABBBatch
+{
+public:
+	// The number of boxes tested per instruction. The arrays are padded to a multiple of this.
+	static const unsigned int BATCH_WIDTH = 8;
+
+	// Constructor
+	// iNumAxes is 2 or 3. If bInclusive is false, boxes which only touch on the max side of the
+	// tested box do not overlap, which is the test used by CEntityManager2D.
+	CAABBBatch(const int iNumAxes = 3, const bool bInclusive = true);
+	// Destructor
+	virtual ~CAABBBatch(void);
+
+	// Set the number of boxes. New boxes are empty and never overlap anything.
+	void Resize(const unsigned int uiNumBoxes);
+	// Remove all the boxes
+	void Clear(void);
+	// Get the number of boxes
+	unsigned int GetSize(void) const;
+
+	// Add a box. Returns its index.
+	unsigned int Add(const float* arrMin, const float* arrMax);
+	// Set a box. arrMin and arrMax hold iNumAxes values.
+	void SetBox(const unsigned int uiIndex, const float* arrMin, const float* arrMax);
+	// Make a box empty, so that it never overlaps anything
+	void SetEmpty(const unsigned int uiIndex);
+
+	// Test a box against all the boxes. Bit (i % 32) of vMask[i / 32] is set if box i overlaps.
+	void Test(const float* arrMin, const float* arrMax, std::vector<unsigned int>& vMask) const;
+	// Test a box against all the boxes, and get the indices of the overlapping boxes
+	void Test(const float* arrMin, const float* arrMax, std::vector<unsigned int>& vMask,
+			  std::vector<unsigned int>& vIndices) const;
+
+	// Get the name of the instruction set which is used
+	static const char* GetInstructionSet(void);
+
+protected:
+	// The number of axes of each box
+	int iNumAxes;
+	// True if touching boxes overlap
+	bool bInclusive;
+	// The number of boxes, not counting the padding
+	unsigned int uiNumBoxes;
+
+	// The min and max corners of the boxes, one array per axis
+	std::vector<float> vMin[3];
+	std::vector<float> vMax[3];
+};
+
+// A CAABBBatch with the space for the results of its tests. Keep one for each caller, e.g. as a
+// member, so that the memory is reused between tests.
+struct SCollisionBatch
+{
+	CAABBBatch cAABBBatch;
+	// The results of CAABBBatch::Test
+	std::vector<unsigned int> vMask;
+	std::vector<unsigned int> vIndices;
+
+	SCollisionBatch(const int iNumAxes = 3, const bool bInclusive = true) : cAABBBatch(iNumAxes, bInclusive) {}
+};
@@ -0,0 +1,47 @@
+/**
+ CAnimationClipLibrary
+ */
+#include "AnimationClipLibrary.h"
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CAnimationClipLibrary::CAnimationClipLibrary(void)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CAnimationClipLibrary::~CAnimationClipLibrary(void)
+{
+	Exit();
+}
+
+/**
+ @brief Get a clip set by name, creating an empty one if it does not exist
+ @param _name A const std::string& containing the name of the clip set
+ @return The clip set
+ */
+CAnimationClipSet* CAnimationClipLibrary::GetClipSet(const std::string& _name)
+{
+	return &mapClipSets[_name];
+}
+
+/**
+ @brief Check if a clip set exists
+ @param _name A const std::string& containing the name of the clip set
+ @return true if the clip set exists, else false
+ */
+bool CAnimationClipLibrary::Check(const std::string& _name) const
+{
+	return mapClipSets.count(_name) != 0;
+}
+
+/**
+ @brief Delete all the clip sets. No sprite may be using them.
+ */
+void CAnimationClipLibrary::Exit(void)
+{
+	mapClipSets.clear();
+}
@@ -0,0 +1,44 @@
+/**
+ CAnimationClipLibrary
+
+ Holds the animation clip sets which are shared by many sprites, e.g. one set for all the enemies
+ and one for all the bombs, so that each sprite does not build and look up its own clips.
+ A clip set is created empty on first use and filled once:
+	CAnimationClipSet* cClipSet = CAnimationClipLibrary::GetInstance()->GetClipSet("Enemy2D");
+	if (cClipSet->GetNumClips() == 0)
+		cClipSet->AddClip("idle", 0, 11);
+	animatedSprites->SetClipSet(cClipSet);
+	animatedSprites->PlayAnimation(cClipSet->GetClipHandle("idle"), -1, 1.0f);
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include CAnimationClipSet
+#include "SpriteAnimation.h"
+
+#include <map>
+#include <string>
+
+class CAnimationClipLibrary : public CSingletonTemplate<CAnimationClipLibrary>
+{
+	friend CSingletonTemplate<CAnimationClipLibrary>;
+public:
+	// Get a clip set by name, creating an empty one if it does not exist
+	CAnimationClipSet* GetClipSet(const std::string& _name);
+	// Check if a clip set exists
+	bool Check(const std::string& _name) const;
+	// Delete all the clip sets. No sprite may be using them.
+	void Exit(void);
+
+protected:
+	// Constructor
+	CAnimationClipLibrary(void);
+
+	// Destructor
+	virtual ~CAnimationClipLibrary(void);
+
+	// The clip sets with their names. The nodes of a std::map do not move, so the sets can be shared by pointer.
+	std::map<std::string, CAnimationClipSet> mapClipSets;
+};
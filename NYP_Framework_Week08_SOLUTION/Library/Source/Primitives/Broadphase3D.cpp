@@ -0,0 +1,490 @@
+/**
+ CBroadphase3D
+ */
+#include "Broadphase3D.h"
+
+// Include CEntity3D
+#include "Entity3D.h"
+
+#include <algorithm>
+
+/**
+ @brief Constructor
+ */
+CBroadphase3D::CBroadphase3D(void)
+	: iRoot(NULL_NODE)
+	, iFreeList(NULL_NODE)
+	, iNumProxies(0)
+	, fMargin(0.1f)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CBroadphase3D::~CBroadphase3D(void)
+{
+}
+
+/**
+ @brief Add an entity with a collider to the tree
+ @param cEntity3D A CEntity3D* which has an activated CCollider
+ @return The proxy of the entity, which is used to update or remove it
+ */
+int CBroadphase3D::Add(CEntity3D* cEntity3D)
+{
+	int iLeaf = AllocateNode();
+
+	SNode& sNode = vNodes[iLeaf];
+	GetColliderBox(cEntity3D, sNode.vec3Min, sNode.vec3Max);
+	sNode.vec3Min -= glm::vec3(fMargin);
+	sNode.vec3Max += glm::vec3(fMargin);
+	sNode.cEntity3D = cEntity3D;
+	sNode.iHeight = 0;
+
+	InsertLeaf(iLeaf);
+	iNumProxies++;
+
+	return iLeaf;
+}
+
+/**
+ @brief Remove an entity from the tree
+ @param iProxy A const int containing the proxy which was returned by Add
+ */
+void CBroadphase3D::Remove(const int iProxy)
+{
+	if ((iProxy < 0) || (iProxy >= (int)vNodes.size()) || (!vNodes[iProxy].IsLeaf()))
+		return;
+
+	RemoveLeaf(iProxy);
+	FreeNode(iProxy);
+	iNumProxies--;
+}
+
+/**
+ @brief Update the box of an entity after it moved or was resized
+ @param iProxy A const int containing the proxy which was returned by Add
+ @return true if the entity left its enlarged box and was reinserted, else false
+ */
+bool CBroadphase3D::Update(const int iProxy)
+{
+	if ((iProxy < 0) || (iProxy >= (int)vNodes.size()) || (!vNodes[iProxy].IsLeaf()))
+		return false;
+
+	glm::vec3 vec3Min, vec3Max;
+	GetColliderBox(vNodes[iProxy].cEntity3D, vec3Min, vec3Max);
+
+	// Nothing to do while the collider is still inside the enlarged box
+	SNode& sNode = vNodes[iProxy];
+	if ((glm::all(glm::lessThanEqual(sNode.vec3Min, vec3Min))) &&
+		(glm::all(glm::lessThanEqual(vec3Max, sNode.vec3Max))))
+		return false;
+
+	RemoveLeaf(iProxy);
+	vNodes[iProxy].vec3Min = vec3Min - glm::vec3(fMargin);
+	vNodes[iProxy].vec3Max = vec3Max + glm::vec3(fMargin);
+	InsertLeaf(iProxy);
+	return true;
+}
+
+/**
+ @brief Get all the pairs of entities whose enlarged boxes overlap. Each pair is returned once.
+ @param pairs A std::vector<std::pair<CEntity3D*, CEntity3D*> >& which will receive the pairs
+ */
+void CBroadphase3D::GetCandidatePairs(std::vector<std::pair<CEntity3D*, CEntity3D*> >& pairs)
+{
+	pairs.clear();
+	if (iRoot == NULL_NODE)
+		return;
+
+	for (int iLeaf = 0; iLeaf < (int)vNodes.size(); iLeaf++)
+	{
+		if ((vNodes[iLeaf].iHeight != 0) || (!vNodes[iLeaf].IsLeaf()))
+			continue;
+
+		// Find the leaves which overlap this leaf. Only pairs with a larger index are kept, to avoid duplicates.
+		const glm::vec3 vec3Min = vNodes[iLeaf].vec3Min;
+		const glm::vec3 vec3Max = vNodes[iLeaf].vec3Max;
+		vStack.clear();
+		vStack.push_back(iRoot);
+		while (!vStack.empty())
+		{
+			int iNode = vStack.back();
+			vStack.pop_back();
+
+			const SNode& sNode = vNodes[iNode];
+			if (!Overlaps(vec3Min, vec3Max, sNode.vec3Min, sNode.vec3Max))
+				continue;
+
+			if (sNode.IsLeaf())
+			{
+				if (iNode > iLeaf)
+					pairs.push_back(std::make_pair(vNodes[iLeaf].cEntity3D, sNode.cEntity3D));
+			}
+			else
+			{
+				vStack.push_back(sNode.iChild1);
+				vStack.push_back(sNode.iChild2);
+			}
+		}
+	}
+}
+
+/**
+ @brief Get all the entities whose enlarged boxes overlap a box
+ @param vec3Min A const glm::vec3& containing the minimum corner of the box
+ @param vec3Max A const glm::vec3& containing the maximum corner of the box
+ @param results A std::vector<CEntity3D*>& which will receive the entities
+ */
+void CBroadphase3D::Query(const glm::vec3& vec3Min, const glm::vec3& vec3Max, std::vector<CEntity3D*>& results)
+{
+	results.clear();
+	if (iRoot == NULL_NODE)
+		return;
+
+	vStack.clear();
+	vStack.push_back(iRoot);
+	while (!vStack.empty())
+	{
+		int iNode = vStack.back();
+		vStack.pop_back();
+
+		const SNode& sNode = vNodes[iNode];
+		if (!Overlaps(vec3Min, vec3Max, sNode.vec3Min, sNode.vec3Max))
+			continue;
+
+		if (sNode.IsLeaf())
+		{
+			results.push_back(sNode.cEntity3D);
+		}
+		else
+		{
+			vStack.push_back(sNode.iChild1);
+			vStack.push_back(sNode.iChild2);
+		}
+	}
+}
+
+/**
+ @brief Get all the entities which collide with an entity. The entities whose boxes overlap in the tree are
+		checked with CEntity3D::CheckForCollision, which reuses the memory of this CBroadphase3D.
+ @param cEntity3D A CEntity3D* containing the entity, which must have a collider
+ @param results A std::vector<CEntity3D*>& which will receive the entities, not including cEntity3D
+ @return The number of entities
+ */
+int CBroadphase3D::QueryCollisions(CEntity3D* cEntity3D, std::vector<CEntity3D*>& results)
+{
+	results.clear();
+	if ((cEntity3D == NULL) || (cEntity3D->cCollider == NULL))
+		return 0;
+
+	glm::vec3 vec3Min, vec3Max;
+	GetColliderBox(cEntity3D, vec3Min, vec3Max);
+	Query(vec3Min, vec3Max, vCandidates);
+	return cEntity3D->CheckForCollision(vCandidates, sCollisionBatch, results);
+}
+
+/**
+ @brief Set how much the boxes are enlarged on each side. Larger margins mean fewer updates but more candidate pairs.
+ @param fMargin A const float containing the margin
+ */
+void CBroadphase3D::SetMargin(const float fMargin)
+{
+	this->fMargin = fMargin;
+}
+
+/**
+ @brief Get how much the boxes are enlarged on each side
+ */
+float CBroadphase3D::GetMargin(void) const
+{
+	return fMargin;
+}
+
+/**
+ @brief Get the number of entities in the tree
+ */
+int CBroadphase3D::GetNumProxies(void) const
+{
+	return iNumProxies;
+}
+
+/**
+ @brief Get the height of the tree
+ */
+int CBroadphase3D::GetHeight(void) const
+{
+	if (iRoot == NULL_NODE)
+		return 0;
+	return vNodes[iRoot].iHeight;
+}
+
+/**
+ @brief Get a node from the free list, or a new node if the free list is empty
+ */
+int CBroadphase3D::AllocateNode(void)
+{
+	int iNode;
+	if (iFreeList != NULL_NODE)
+	{
+		iNode = iFreeList;
+		iFreeList = vNodes[iNode].iParent;
+	}
+	else
+	{
+		iNode = (int)vNodes.size();
+		vNodes.push_back(SNode());
+	}
+
+	SNode& sNode = vNodes[iNode];
+	sNode.vec3Min = glm::vec3(0.0f);
+	sNode.vec3Max = glm::vec3(0.0f);
+	sNode.cEntity3D = NULL;
+	sNode.iParent = NULL_NODE;
+	sNode.iChild1 = NULL_NODE;
+	sNode.iChild2 = NULL_NODE;
+	sNode.iHeight = 0;
+	return iNode;
+}
+
+/**
+ @brief Return a node to the free list
+ */
+void CBroadphase3D::FreeNode(const int iNode)
+{
+	vNodes[iNode].iParent = iFreeList;
+	vNodes[iNode].iChild1 = NULL_NODE;
+	vNodes[iNode].cEntity3D = NULL;
+	vNodes[iNode].iHeight = -1;
+	iFreeList = iNode;
+}
+
+/**
+ @brief Insert a leaf next to the node where it increases the total area the least
+ */
+void CBroadphase3D::InsertLeaf(const int iLeaf)
+{
+	if (iRoot == NULL_NODE)
+	{
+		iRoot = iLeaf;
+		vNodes[iRoot].iParent = NULL_NODE;
+		return;
+	}
+
+	// Find the best sibling for the leaf
+	const glm::vec3 vec3LeafMin = vNodes[iLeaf].vec3Min;
+	const glm::vec3 vec3LeafMax = vNodes[iLeaf].vec3Max;
+	int iIndex = iRoot;
+	while (!vNodes[iIndex].IsLeaf())
+	{
+		int iChild1 = vNodes[iIndex].iChild1;
+		int iChild2 = vNodes[iIndex].iChild2;
+
+		float fArea = GetArea(vNodes[iIndex].vec3Min, vNodes[iIndex].vec3Max);
+		float fCombinedArea = GetArea(	glm::min(vNodes[iIndex].vec3Min, vec3LeafMin),
+										glm::max(vNodes[iIndex].vec3Max, vec3LeafMax));
+
+		// The cost of making a new parent for this node and the leaf
+		float fCost = 2.0f * fCombinedArea;
+		// The minimum cost of pushing the leaf further down the tree
+		float fInheritanceCost = 2.0f * (fCombinedArea - fArea);
+
+		// The cost of descending into each child
+		float arrChildCost[2];
+		int arrChildren[2] = { iChild1, iChild2 };
+		for (int i = 0; i < 2; i++)
+		{
+			const SNode& sChild = vNodes[arrChildren[i]];
+			float fNewArea = GetArea(glm::min(sChild.vec3Min, vec3LeafMin), glm::max(sChild.vec3Max, vec3LeafMax));
+			if (sChild.IsLeaf())
+				arrChildCost[i] = fNewArea + fInheritanceCost;
+			else
+				arrChildCost[i] = (fNewArea - GetArea(sChild.vec3Min, sChild.vec3Max)) + fInheritanceCost;
+		}
+
+		if ((fCost < arrChildCost[0]) && (fCost < arrChildCost[1]))
+			break;
+
+		iIndex = (arrChildCost[0] < arrChildCost[1]) ? iChild1 : iChild2;
+	}
+	int iSibling = iIndex;
+
+	// Create a new parent for the sibling and the leaf
+	int iOldParent = vNodes[iSibling].iParent;
+	int iNewParent = AllocateNode();
+	vNodes[iNewParent].iParent = iOldParent;
+	vNodes[iNewParent].vec3Min = glm::min(vNodes[iSibling].vec3Min, vec3LeafMin);
+	vNodes[iNewParent].vec3Max = glm::max(vNodes[iSibling].vec3Max, vec3LeafMax);
+	vNodes[iNewParent].iHeight = vNodes[iSibling].iHeight + 1;
+	vNodes[iNewParent].iChild1 = iSibling;
+	vNodes[iNewParent].iChild2 = iLeaf;
+	vNodes[iSibling].iParent = iNewParent;
+	vNodes[iLeaf].iParent = iNewParent;
+
+	if (iOldParent != NULL_NODE)
+	{
+		if (vNodes[iOldParent].iChild1 == iSibling)
+			vNodes[iOldParent].iChild1 = iNewParent;
+		else
+			vNodes[iOldParent].iChild2 = iNewParent;
+	}
+	else
+	{
+		iRoot = iNewParent;
+	}
+
+	// Walk back up the tree, fixing the boxes and heights
+	iIndex = vNodes[iLeaf].iParent;
+	while (iIndex != NULL_NODE)
+	{
+		iIndex = Balance(iIndex);
+		Refit(iIndex);
+		iIndex = vNodes[iIndex].iParent;
+	}
+}
+
+/**
+ @brief Remove a leaf from the tree. Its sibling takes the place of their parent.
+ */
+void CBroadphase3D::RemoveLeaf(const int iLeaf)
+{
+	if (iLeaf == iRoot)
+	{
+		iRoot = NULL_NODE;
+		return;
+	}
+
+	int iParent = vNodes[iLeaf].iParent;
+	int iGrandParent = vNodes[iParent].iParent;
+	int iSibling = (vNodes[iParent].iChild1 == iLeaf) ? vNodes[iParent].iChild2 : vNodes[iParent].iChild1;
+
+	if (iGrandParent != NULL_NODE)
+	{
+		if (vNodes[iGrandParent].iChild1 == iParent)
+			vNodes[iGrandParent].iChild1 = iSibling;
+		else
+			vNodes[iGrandParent].iChild2 = iSibling;
+		vNodes[iSibling].iParent = iGrandParent;
+		FreeNode(iParent);
+
+		int iIndex = iGrandParent;
+		while (iIndex != NULL_NODE)
+		{
+			iIndex = Balance(iIndex);
+			Refit(iIndex);
+			iIndex = vNodes[iIndex].iParent;
+		}
+	}
+	else
+	{
+		iRoot = iSibling;
+		vNodes[iSibling].iParent = NULL_NODE;
+		FreeNode(iParent);
+	}
+	vNodes[iLeaf].iParent = NULL_NODE;
+}
+
+/**
+ @brief Rotate the tree at node A if one child is more than 1 level taller than the other
+ @return The node which is now at the position of node A
+ */
+int CBroadphase3D::Balance(const int iA)
+{
+	if ((vNodes[iA].IsLeaf()) || (vNodes[iA].iHeight < 2))
+		return iA;
+
+	int iB = vNodes[iA].iChild1;
+	int iC = vNodes[iA].iChild2;
+	int iBalance = vNodes[iC].iHeight - vNodes[iB].iHeight;
+
+	if ((iBalance > 1) || (iBalance < -1))
+	{
+		// Promote the taller child (iUp), and give one of its children (the shorter one) to A
+		int iUp = (iBalance > 1) ? iC : iB;
+		int iStay = (iBalance > 1) ? iB : iC;
+		int iF = vNodes[iUp].iChild1;
+		int iG = vNodes[iUp].iChild2;
+
+		// Up takes the place of A
+		vNodes[iUp].iChild1 = iA;
+		vNodes[iUp].iParent = vNodes[iA].iParent;
+		vNodes[iA].iParent = iUp;
+		if (vNodes[iUp].iParent != NULL_NODE)
+		{
+			if (vNodes[vNodes[iUp].iParent].iChild1 == iA)
+				vNodes[vNodes[iUp].iParent].iChild1 = iUp;
+			else
+				vNodes[vNodes[iUp].iParent].iChild2 = iUp;
+		}
+		else
+		{
+			iRoot = iUp;
+		}
+
+		// The taller grandchild stays with Up, the shorter one moves to A
+		int iKeep = (vNodes[iF].iHeight > vNodes[iG].iHeight) ? iF : iG;
+		int iMove = (iKeep == iF) ? iG : iF;
+		vNodes[iUp].iChild2 = iKeep;
+		vNodes[iA].iChild1 = iStay;
+		vNodes[iA].iChild2 = iMove;
+		vNodes[iMove].iParent = iA;
+
+		Refit(iA);
+		Refit(iUp);
+		return iUp;
+	}
+
+	return iA;
+}
+
+/**
+ @brief Recompute the box and height of a node from its children
+ */
+void CBroadphase3D::Refit(const int iNode)
+{
+	SNode& sNode = vNodes[iNode];
+	if (sNode.IsLeaf())
+		return;
+
+	const SNode& sChild1 = vNodes[sNode.iChild1];
+	const SNode& sChild2 = vNodes[sNode.iChild2];
+	sNode.vec3Min = glm::min(sChild1.vec3Min, sChild2.vec3Min);
+	sNode.vec3Max = glm::max(sChild1.vec3Max, sChild2.vec3Max);
+	sNode.iHeight = 1 + std::max(sChild1.iHeight, sChild2.iHeight);
+}
+
+/**
+ @brief Get the box of the collider of an entity, the same box which CEntity3D::CheckForCollision uses
+ */
+void CBroadphase3D::GetColliderBox(const CEntity3D* cEntity3D, glm::vec3& vec3Min, glm::vec3& vec3Max) const
+{
+	glm::vec3 vec3Position = cEntity3D->GetPosition();
+	glm::vec3 vec3Scale = cEntity3D->GetColliderScale();
+	glm::vec3 vec3A = vec3Position + vec3Scale * cEntity3D->cCollider->vec3BottomLeft;
+	glm::vec3 vec3B = vec3Position + vec3Scale * cEntity3D->cCollider->vec3TopRight;
+
+	// A negative scale swaps the corners
+	vec3Min = glm::min(vec3A, vec3B);
+	vec3Max = glm::max(vec3A, vec3B);
+}
+
+/**
+ @brief Get the surface area of a box
+ */
+float CBroadphase3D::GetArea(const glm::vec3& vec3Min, const glm::vec3& vec3Max)
+{
+	glm::vec3 vec3Size = vec3Max - vec3Min;
+	return 2.0f * (vec3Size.x * vec3Size.y + vec3Size.y * vec3Size.z + vec3Size.z * vec3Size.x);
+}
+
+/**
+ @brief Check if 2 boxes overlap
+ */
+bool CBroadphase3D::Overlaps(	const glm::vec3& vec3MinA, const glm::vec3& vec3MaxA,
+								const glm::vec3& vec3MinB, const glm::vec3& vec3MaxB)
+{
+	return	(vec3MinA.x <= vec3MaxB.x) && (vec3MinB.x <= vec3MaxA.x) &&
+			(vec3MinA.y <= vec3MaxB.y) && (vec3MinB.y <= vec3MaxA.y) &&
+			(vec3MinA.z <= vec3MaxB.z) && (vec3MinB.z <= vec3MaxA.z);
+}
@@ -0,0 +1,118 @@
+/**
+ CBroadphase3D
+
+ A dynamic AABB tree of the CEntity3D colliders. Each leaf stores an enlarged ("fat") box around
+ a collider, so an entity which moves a little does not need to be updated in the tree.
+ Entities are added by CEntity3D::ActivateCollider and updated by CEntity3D::SetPosition.
+ GetCandidatePairs returns the pairs whose boxes overlap; these still need a narrow phase test
+ such as CEntity3D::CheckForCollision. QueryCollisions does both for one entity.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include AABBBatch
+#include "AABBBatch.h"
+
+#include <vector>
+#include <utility>
+
+class CEntity3D;
+
+class CBroadphase3D : public CSingletonTemplate<CBroadphase3D>
+{
+	friend CSingletonTemplate<CBroadphase3D>;
+public:
+	// The value of a proxy which is not in the tree
+	static const int NULL_NODE = -1;
+
+	// Add an entity with a collider. Returns its proxy.
+	int Add(CEntity3D* cEntity3D);
+	// Remove an entity
+	void Remove(const int iProxy);
+	// Update the box of an entity after it moved. Returns true if the tree was changed.
+	bool Update(const int iProxy);
+
+	// Get all the pairs of entities whose boxes overlap
+	void GetCandidatePairs(std::vector<std::pair<CEntity3D*, CEntity3D*> >& pairs);
+	// Get all the entities whose boxes overlap a box
+	void Query(const glm::vec3& vec3Min, const glm::vec3& vec3Max, std::vector<CEntity3D*>& results);
+	// Get all the entities which collide with an entity. Returns the number of entities.
+	int QueryCollisions(CEntity3D* cEntity3D, std::vector<CEntity3D*>& results);
+
+	// Set how much the boxes are enlarged on each side
+	void SetMargin(const float fMargin);
+	// Get how much the boxes are enlarged on each side
+	float GetMargin(void) const;
+
+	// Get the number of entities in the tree
+	int GetNumProxies(void) const;
+	// Get the height of the tree
+	int GetHeight(void) const;
+
+protected:
+	// A node of the tree. Leaves hold an entity, the other nodes have 2 children.
+	struct SNode
+	{
+		// The box which contains this node and all its children
+		glm::vec3 vec3Min;
+		glm::vec3 vec3Max;
+
+		CEntity3D* cEntity3D;
+
+		// The parent node, or the next free node if this node is not in use
+		int iParent;
+		int iChild1;
+		int iChild2;
+		// 0 for leaves, -1 for free nodes
+		int iHeight;
+
+		bool IsLeaf(void) const { return iChild1 == NULL_NODE; }
+	};
+
+	std::vector<SNode> vNodes;
+	int iRoot;
+	int iFreeList;
+	int iNumProxies;
+
+	// How much the boxes are enlarged on each side
+	float fMargin;
+
+	// Scratch space for the tree traversals
+	std::vector<int> vStack;
+	// Scratch space for QueryCollisions
+	std::vector<CEntity3D*> vCandidates;
+	SCollisionBatch sCollisionBatch;
+
+	// Constructor
+	CBroadphase3D(void);
+
+	// Destructor
+	virtual ~CBroadphase3D(void);
+
+	// Get a node from the free list
+	int AllocateNode(void);
+	// Return a node to the free list
+	void FreeNode(const int iNode);
+
+	// Insert a leaf into the tree
+	void InsertLeaf(const int iLeaf);
+	// Remove a leaf from the tree
+	void RemoveLeaf(const int iLeaf);
+	// Rotate the tree at a node if it is unbalanced. Returns the new root of the subtree.
+	int Balance(const int iNode);
+	// Recompute the box and height of a node from its children
+	void Refit(const int iNode);
+
+	// Get the box of the collider of an entity
+	void GetColliderBox(const CEntity3D* cEntity3D, glm::vec3& vec3Min, glm::vec3& vec3Max) const;
+	// Get the surface area of a box, used as the cost of a node
+	static float GetArea(const glm::vec3& vec3Min, const glm::vec3& vec3Max);
+	// Check if 2 boxes overlap
+	static bool Overlaps(	const glm::vec3& vec3MinA, const glm::vec3& vec3MaxA,
+							const glm::vec3& vec3MinB, const glm::vec3& vec3MaxB);
+};
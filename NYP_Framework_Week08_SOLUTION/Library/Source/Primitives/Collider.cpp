@@ -1,7 +1,7 @@
 #include "Collider.h"
 
 // Include Shader Manager
-#include "..\RenderControl\ShaderManager.h"
+#include "../RenderControl/ShaderManager.h"
 
 #include <GLFW/glfw3.h>
 
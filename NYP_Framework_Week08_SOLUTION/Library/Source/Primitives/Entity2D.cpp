@@ -7,10 +7,10 @@
 #include "MeshBuilder.h"
 
  // Include Shader Manager
-#include "..\RenderControl\ShaderManager.h"
+#include "../RenderControl/ShaderManager.h"
 
 // Include ImageLoader
-#include "..\System\ImageLoader.h"
+#include "../System/ImageLoader.h"
 
 #include <iostream>
 using namespace std;
@@ -179,12 +179,34 @@ void CEntity2D::PostRender(void)
 	glDisable(GL_BLEND);
 }
 
+/**
+ @brief Add this instance to the CSpriteBatch2D, which draws the sprites of many entities together
+ @return false as a plain CEntity2D is rendered by PreRender, Render and PostRender
+ */
+bool CEntity2D::SubmitSprite(void)
+{
+	return false;
+}
+
+/**
+ @brief Get the animated sprite which CEntityManager2D updates together with those of the other entities
+ @return NULL as a plain CEntity2D is not animated
+ */
+CSpriteAnimation* CEntity2D::GetAnimatedSprites(void) const
+{
+	return NULL;
+}
+
 /**
 @brief Load a texture, assign it a code and store it in MapOfTextureIDs.
 @param filename A const char* variable which contains the file name of the texture
 */
 bool CEntity2D::LoadTexture(const char* filename)
 {
+	// There is no OpenGL context in headless mode, so the texture is not needed
+	if (CSettings::GetInstance()->bHeadless)
+		return true;
+
 	// Variables used in loading the texture
 	int width, height, nrChannels;
 	
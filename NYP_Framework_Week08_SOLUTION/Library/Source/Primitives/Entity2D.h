@@ -17,13 +17,15 @@
 #include <includes/gtc/type_ptr.hpp>
 
 // Include Settings
-#include "..\GameControl\Settings.h"
+#include "../GameControl/Settings.h"
 #include <string>
 
 //CS: Include Mesh.h to use to draw (include vertex and index buffers)
 #include "Mesh.h"
 using namespace std;
 
+class CSpriteAnimation;
+
 class CEntity2D
 {
 public:
@@ -51,6 +53,12 @@ public:
 	// PostRender
 	virtual void PostRender(void);
 
+	// Add this instance to the CSpriteBatch2D instead of rendering it by itself
+	virtual bool SubmitSprite(void);
+
+	// Get the animated sprite which CEntityManager2D updates together with those of the other entities
+	virtual CSpriteAnimation* GetAnimatedSprites(void) const;
+
 	// Collision Handler
 	virtual void CollidedWith(CEntity2D*);
 
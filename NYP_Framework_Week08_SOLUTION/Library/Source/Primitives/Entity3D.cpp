@@ -6,9 +6,12 @@
 #include "Entity3D.h"
 
 // Include ImageLoader
-#include "..\System\ImageLoader.h"
+#include "../System/ImageLoader.h"
+// Include Broadphase3D
+#include "Broadphase3D.h"
 
 #include <iostream>
+#include <cfloat>
 using namespace std;
 
 /**
@@ -20,6 +23,8 @@ CEntity3D::CEntity3D()
 	, sShaderName("")
 	, VAO(0)
 	, VBO(0)
+	, IBO(0)
+	, index_buffer_size(0)
 	, iTextureID(0)
 	, model(glm::mat4(1.0f))
 	, view(glm::mat4(1.0f))
@@ -29,11 +34,13 @@ CEntity3D::CEntity3D()
 	, vec3Front(glm::vec3(0.0f, 0.0f, -1.0f))
 	, vec3PreviousPosition(0.0f)
 	, vec3Scale(1.0f)
+	, vec3ColliderScale(1.0f)
 	, fRotationAngle(0.0f)
 	, vec3RotationAxis(1.0f)
 	, vec4Colour(1.0f)
 	, fMovementSpeed(2.5f)
 	, bToDelete(false)
+	, iBroadphaseProxy(CBroadphase3D::NULL_NODE)
 {
 }
 
@@ -42,6 +49,12 @@ CEntity3D::CEntity3D()
 */
 CEntity3D::~CEntity3D(void)
 {
+	if (iBroadphaseProxy != CBroadphase3D::NULL_NODE)
+	{
+		CBroadphase3D::GetInstance()->Remove(iBroadphaseProxy);
+		iBroadphaseProxy = CBroadphase3D::NULL_NODE;
+	}
+
 	if (cCollider)
 	{
 		delete cCollider;
@@ -85,6 +98,7 @@ void CEntity3D::SetType(const TYPE eType)
 void CEntity3D::SetPosition(const glm::vec3 vec3Position)
 {
 	this->vec3Position = vec3Position;
+	UpdateBroadphase();
 }
 void CEntity3D::SetPreviousPosition(const glm::vec3 vec3PreviousPosition)
 {
@@ -101,6 +115,7 @@ void CEntity3D::SetScale(const glm::vec3 vec3Scale)
 void CEntity3D::SetColliderScale(const glm::vec3 vec3Scale)
 {
 	this->vec3ColliderScale = vec3Scale;
+	UpdateBroadphase();
 }
 
 void CEntity3D::SetRotation(const float fRotationAngle, const glm::vec3 vec3RotationAxis)
@@ -162,6 +177,26 @@ const float CEntity3D::GetMovementSpeed(void) const
 {
 	return fMovementSpeed;
 }
+const GLuint CEntity3D::GetVAO(void) const
+{
+	return VAO;
+}
+const GLuint CEntity3D::GetIndexBufferSize(void) const
+{
+	return index_buffer_size;
+}
+
+/**
+@brief Get the model matrix from the position, rotation and scale of this CEntity3D
+*/
+glm::mat4 CEntity3D::GetModelMatrix(void) const
+{
+	glm::mat4 model = glm::mat4(1.0f);
+	model = glm::translate(model, vec3Position);
+	model = glm::rotate(model, fRotationAngle, vec3RotationAxis);
+	model = glm::scale(model, vec3Scale);
+	return model;
+}
 
 // These methods are for marking this CEntity3D for deletion
 /**
@@ -183,14 +218,96 @@ const bool CEntity3D::IsToDelete(void) const
 }
 
 /**
-@brief Activate the CCollider for this class instance
+@brief Load an OBJ file with generated LOD meshes. The HIGH_DETAILS mesh is used until UpdateLOD is called.
+@param file_path A const char* containing the name of the OBJ file
+@param bUseCache A const bool which is true if the simplified meshes are to be cached on disk
+@return true if the meshes were loaded, else false
+*/
+bool CEntity3D::LoadLODModel(const char* file_path, const bool bUseCache)
+{
+	if (CLevelOfDetails::LoadLODModel(file_path, bUseCache) == false)
+		return false;
+
+	VAO = arrVAO[HIGH_DETAILS];
+	VBO = arrVBO[HIGH_DETAILS];
+	IBO = arrIBO[HIGH_DETAILS];
+	index_buffer_size = arrIndexSize[HIGH_DETAILS];
+	return true;
+}
+
+/**
+@brief Use the LOD meshes of another CEntity3D. Entities which share their meshes and texture are drawn
+		with one draw call by CInstancedRenderer. The HIGH_DETAILS mesh is used until UpdateLOD is called.
+@param cSource A const CLevelOfDetails& whose meshes were loaded by LoadLODModel. It must be kept until this CEntity3D is deleted.
+@return true if cSource has meshes, else false
+*/
+bool CEntity3D::ShareLODModel(const CLevelOfDetails& cSource)
+{
+	if (CLevelOfDetails::ShareLODModel(cSource) == false)
+		return false;
+
+	VAO = arrVAO[HIGH_DETAILS];
+	VBO = arrVBO[HIGH_DETAILS];
+	IBO = arrIBO[HIGH_DETAILS];
+	index_buffer_size = arrIndexSize[HIGH_DETAILS];
+	return true;
+}
+
+/**
+@brief Select the LOD mesh for the distance to the camera.
+		VAO, VBO, IBO and index_buffer_size are set to the selected mesh, so Render() needs no changes.
+@param vec3CameraPosition A const glm::vec3 containing the position of the camera
+*/
+void CEntity3D::UpdateLOD(const glm::vec3 vec3CameraPosition)
+{
+	if (GetLODStatus() == false)
+		return;
+
+	DETAIL_LEVEL eLevel = UpdateDetailLevel((float)sqrt(DistanceSquaredBetween(vec3Position, vec3CameraPosition)));
+
+	VAO = arrVAO[eLevel];
+	VBO = arrVBO[eLevel];
+	IBO = arrIBO[eLevel];
+	index_buffer_size = arrIndexSize[eLevel];
+	if (arriTextureID[eLevel] != 0)
+		iTextureID = arriTextureID[eLevel];
+}
+
+/**
+@brief Activate the CCollider for this class instance, and add it to the CBroadphase3D
 @param cLineShader A Shader* variable which stores a shader which renders lines
 */
 void CEntity3D::ActivateCollider(const std::string& _name)
 {
-	cCollider = new CCollider();
-	cCollider->Init();
+	if (cCollider == NULL)
+	{
+		cCollider = new CCollider();
+		cCollider->Init();
+	}
 	cCollider->SetLineShader(_name);
+
+	if (iBroadphaseProxy == CBroadphase3D::NULL_NODE)
+		iBroadphaseProxy = CBroadphase3D::GetInstance()->Add(this);
+	else
+		UpdateBroadphase();
+}
+
+/**
+@brief Get the proxy of this CEntity3D in the CBroadphase3D
+@return The proxy, or CBroadphase3D::NULL_NODE if the CCollider has not been activated
+*/
+const int CEntity3D::GetBroadphaseProxy(void) const
+{
+	return iBroadphaseProxy;
+}
+
+/**
+@brief Update the box of this CEntity3D in the CBroadphase3D. This is cheap if it has not left its enlarged box.
+*/
+void CEntity3D::UpdateBroadphase(void)
+{
+	if (iBroadphaseProxy != CBroadphase3D::NULL_NODE)
+		CBroadphase3D::GetInstance()->Update(iBroadphaseProxy);
 }
 
 /**
@@ -221,8 +338,8 @@ bool CEntity3D::CheckForCollision(const CEntity3D* cEntity3D)
 
 	tempVec3A_BottomLeft = vec3Position + vec3ColliderScale * cCollider->vec3BottomLeft;
 	tempVec3A_TopRight = vec3Position + vec3ColliderScale * cCollider->vec3TopRight;
-	tempVec3B_BottomLeft = cEntity3D->vec3Position + vec3ColliderScale * cEntity3D->cCollider->vec3BottomLeft;
-	tempVec3B_TopRight = cEntity3D->vec3Position + vec3ColliderScale * cEntity3D->cCollider->vec3TopRight;
+	tempVec3B_BottomLeft = cEntity3D->vec3Position + cEntity3D->vec3ColliderScale * cEntity3D->cCollider->vec3BottomLeft;
+	tempVec3B_TopRight = cEntity3D->vec3Position + cEntity3D->vec3ColliderScale * cEntity3D->cCollider->vec3TopRight;
 
 	// Check for collision using Sphere-Sphere intersection test
 	// If true, then check using AABB 
@@ -286,6 +403,72 @@ bool CEntity3D::CheckForCollision(const CEntity3D* cEntity3D)
 	return bResult;
 }
 
+/**
+@brief Check for collision with many CEntity3D at once.
+		The colliders are first tested as boxes, 4 or 8 at a time with CAABBBatch,
+		and only the overlapping ones are checked with CheckForCollision.
+@param vEntities A const std::vector<CEntity3D*>& containing the CEntity3D to test against
+@param sCollisionBatch A SCollisionBatch& which is used to test the boxes. The caller keeps it to reuse its memory.
+@param vResults A std::vector<CEntity3D*>& which will receive the CEntity3D which collide with this CEntity3D
+@return The number of CEntity3D which collide with this CEntity3D
+*/
+int CEntity3D::CheckForCollision(const std::vector<CEntity3D*>& vEntities, SCollisionBatch& sCollisionBatch, std::vector<CEntity3D*>& vResults)
+{
+	CAABBBatch& cAABBBatch = sCollisionBatch.cAABBBatch;
+	std::vector<unsigned int>& vIndices = sCollisionBatch.vIndices;
+
+	vResults.clear();
+	if (cCollider == NULL)
+		return 0;
+
+	cAABBBatch.Resize((unsigned int)vEntities.size());
+	for (unsigned int i = 0; i < vEntities.size(); i++)
+	{
+		const CEntity3D* cEntity3D = vEntities[i];
+		if ((cEntity3D == NULL) || (cEntity3D == this) || (cEntity3D->cCollider == NULL))
+		{
+			cAABBBatch.SetEmpty(i);
+			continue;
+		}
+
+		glm::vec3 vec3A = cEntity3D->vec3Position + cEntity3D->vec3ColliderScale * cEntity3D->cCollider->vec3BottomLeft;
+		glm::vec3 vec3B = cEntity3D->vec3Position + cEntity3D->vec3ColliderScale * cEntity3D->cCollider->vec3TopRight;
+		glm::vec3 vec3Min = glm::min(vec3A, vec3B);
+		glm::vec3 vec3Max = glm::max(vec3A, vec3B);
+		cAABBBatch.SetBox(i, &vec3Min[0], &vec3Max[0]);
+	}
+
+	glm::vec3 vec3A = vec3Position + vec3ColliderScale * cCollider->vec3BottomLeft;
+	glm::vec3 vec3B = vec3Position + vec3ColliderScale * cCollider->vec3TopRight;
+	glm::vec3 vec3Min = glm::min(vec3A, vec3B);
+	glm::vec3 vec3Max = glm::max(vec3A, vec3B);
+	cAABBBatch.Test(&vec3Min[0], &vec3Max[0], sCollisionBatch.vMask, vIndices);
+
+	for (unsigned int i = 0; i < vIndices.size(); i++)
+	{
+		if (CheckForCollision(vEntities[vIndices[i]]))
+			vResults.push_back(vEntities[vIndices[i]]);
+	}
+
+	return (int)vResults.size();
+}
+
+/**
+@brief Check if the collider of this CEntity3D is inside the camera's view.
+		A CEntity3D without a collider has no known bounds, so it is always visible.
+@param cFrustum A CFrustum& containing the camera's view, which also counts the visible and culled CEntity3D
+@return true if this CEntity3D may be visible, else false
+*/
+bool CEntity3D::IsVisible(CFrustum& cFrustum) const
+{
+	if (cCollider == NULL)
+		return cFrustum.IsSphereVisible(vec3Position, FLT_MAX);
+
+	glm::vec3 vec3A = vec3Position + vec3ColliderScale * cCollider->vec3BottomLeft;
+	glm::vec3 vec3B = vec3Position + vec3ColliderScale * cCollider->vec3TopRight;
+	return cFrustum.IsBoxVisible(glm::min(vec3A, vec3B), glm::max(vec3A, vec3B));
+}
+
 /**
  @brief Store position for rollback
  */
@@ -300,6 +483,7 @@ void CEntity3D::StorePositionForRollback(void)
 void CEntity3D::RollbackPosition(void)
 {
 	vec3Position = vec3PreviousPosition;
+	UpdateBroadphase();
 }
 
 /**
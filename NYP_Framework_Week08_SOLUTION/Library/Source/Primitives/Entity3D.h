@@ -11,17 +11,25 @@
 #define GLEW_STATIC
 #endif
 
-#include <includes\glm.hpp>
+#include <includes/glm.hpp>
 
 // Include CCollider
 #include "Collider.h"
 
 // Include Settings
-#include "..\GameControl\Settings.h"
+#include "../GameControl/Settings.h"
 
 // Include LevelOfDetails
 #include "LevelOfDetails.h"
 
+// Include Frustum
+#include "Frustum.h"
+
+// Include AABBBatch
+#include "AABBBatch.h"
+
+#include <vector>
+
 class CEntity3D : public CLevelOfDetails
 {
 public:
@@ -82,18 +90,36 @@ public:
 	virtual const glm::vec3 GetRotationAxis(void) const;
 	virtual const glm::vec4 GetColour(void) const;
 	virtual const float GetMovementSpeed(void) const;
+	virtual const GLuint GetVAO(void) const;
+	virtual const GLuint GetIndexBufferSize(void) const;
+
+	// Get the model matrix from the position, rotation and scale
+	virtual glm::mat4 GetModelMatrix(void) const;
 
 	// These methods are for marking this CEntity3D for deletion
 	virtual void SetToDelete(const bool bToDelete);
 	virtual const bool IsToDelete(void) const;
 
+	// Load an OBJ file with generated LOD meshes
+	virtual bool LoadLODModel(const char* file_path, const bool bUseCache = true);
+	// Use the LOD meshes of another CEntity3D, so that they can be drawn together by CInstancedRenderer
+	virtual bool ShareLODModel(const CLevelOfDetails& cSource);
+	// Select the LOD mesh for the distance to the camera. Call this every frame before Render().
+	virtual void UpdateLOD(const glm::vec3 vec3CameraPosition);
+
 	// Activate the CCollider for this class instance
 	virtual void ActivateCollider(const std::string& _name);
+	// Get the proxy of this CEntity3D in the CBroadphase3D
+	virtual const int GetBroadphaseProxy(void) const;
 
 	// Get Sphere Radius
 	virtual float GetSphereRadius(void);
 	// Check for collision with another CCollider
 	virtual bool CheckForCollision(const CEntity3D* cEntity3D);
+	// Check for collision with many CEntity3D at once, e.g. the results of CBroadphase3D::Query
+	virtual int CheckForCollision(const std::vector<CEntity3D*>& vEntities, SCollisionBatch& sCollisionBatch, std::vector<CEntity3D*>& vResults);
+	// Check if the collider of this CEntity3D is inside the camera's view
+	virtual bool IsVisible(CFrustum& cFrustum) const;
 	// Store position for rollback
 	virtual void StorePositionForRollback(void);
 	// Rollback the position to the previous position
@@ -151,6 +177,9 @@ protected:
 	// Boolean flag to indicate if this CEntity3D is to be deleted
 	bool bToDelete;
 
+	// The proxy of this CEntity3D in the CBroadphase3D, or CBroadphase3D::NULL_NODE
+	int iBroadphaseProxy;
+
 	// glm::vec3 variables use during for checking of collision
 	glm::vec3 tempVec3A_BottomLeft;
 	glm::vec3 tempVec3A_TopRight;
@@ -160,6 +189,9 @@ protected:
 	// Load Ground textures
 	virtual int LoadTexture(const char* filename);
 
+	// Update the box of this CEntity3D in the CBroadphase3D
+	virtual void UpdateBroadphase(void);
+
 	// Distance Squared between 2 Vector3 positions
 	virtual double DistanceSquaredBetween(glm::vec3 thisVector, glm::vec3 thatVector);
 };
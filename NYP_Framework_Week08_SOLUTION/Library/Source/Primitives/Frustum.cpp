@@ -0,0 +1,128 @@
+/**
+ CFrustum
+ */
+#include "Frustum.h"
+
+/**
+ @brief Constructor
+ */
+CFrustum::CFrustum(void)
+	: uiNumVisible(0)
+	, uiNumCulled(0)
+{
+	// Until Update is called, nothing is culled
+	for (int i = 0; i < NUM_PLANES; i++)
+		arrPlanes[i] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+/**
+ @brief Destructor
+ */
+CFrustum::~CFrustum(void)
+{
+}
+
+/**
+ @brief Compute the planes from the camera matrices (Gribb and Hartmann's method)
+ @param view A const glm::mat4& containing the view matrix of the camera
+ @param projection A const glm::mat4& containing the projection matrix of the camera
+ */
+void CFrustum::Update(const glm::mat4& view, const glm::mat4& projection)
+{
+	glm::mat4 viewProjection = projection * view;
+
+	// glm matrices are column-major, so viewProjection[c][r] is the element at row r, column c
+	glm::vec4 arrRows[4];
+	for (int r = 0; r < 4; r++)
+		arrRows[r] = glm::vec4(viewProjection[0][r], viewProjection[1][r], viewProjection[2][r], viewProjection[3][r]);
+
+	arrPlanes[LEFT_PLANE]	= arrRows[3] + arrRows[0];
+	arrPlanes[RIGHT_PLANE]	= arrRows[3] - arrRows[0];
+	arrPlanes[BOTTOM_PLANE]	= arrRows[3] + arrRows[1];
+	arrPlanes[TOP_PLANE]	= arrRows[3] - arrRows[1];
+	arrPlanes[NEAR_PLANE]	= arrRows[3] + arrRows[2];
+	arrPlanes[FAR_PLANE]	= arrRows[3] - arrRows[2];
+
+	// Normalise the planes so that IsSphereVisible can compare distances
+	for (int i = 0; i < NUM_PLANES; i++)
+	{
+		float fLength = glm::length(glm::vec3(arrPlanes[i]));
+		if (fLength > 0.0f)
+			arrPlanes[i] /= fLength;
+	}
+}
+
+/**
+ @brief Check if an axis-aligned box is at least partly inside the frustum.
+		The box is culled if its corner which is furthest along a plane's normal is outside that plane.
+ @param vec3Min A const glm::vec3& containing the minimum corner of the box
+ @param vec3Max A const glm::vec3& containing the maximum corner of the box
+ @return true if the box may be visible, else false
+ */
+bool CFrustum::IsBoxVisible(const glm::vec3& vec3Min, const glm::vec3& vec3Max)
+{
+	for (int i = 0; i < NUM_PLANES; i++)
+	{
+		glm::vec3 vec3Normal = glm::vec3(arrPlanes[i]);
+		glm::vec3 vec3Furthest(	vec3Normal.x >= 0.0f ? vec3Max.x : vec3Min.x,
+								vec3Normal.y >= 0.0f ? vec3Max.y : vec3Min.y,
+								vec3Normal.z >= 0.0f ? vec3Max.z : vec3Min.z);
+		if (glm::dot(vec3Normal, vec3Furthest) + arrPlanes[i].w < 0.0f)
+			return Count(false);
+	}
+	return Count(true);
+}
+
+/**
+ @brief Check if a sphere is at least partly inside the frustum
+ @param vec3Centre A const glm::vec3& containing the centre of the sphere
+ @param fRadius A const float containing the radius of the sphere
+ @return true if the sphere may be visible, else false
+ */
+bool CFrustum::IsSphereVisible(const glm::vec3& vec3Centre, const float fRadius)
+{
+	for (int i = 0; i < NUM_PLANES; i++)
+	{
+		if (glm::dot(glm::vec3(arrPlanes[i]), vec3Centre) + arrPlanes[i].w < -fRadius)
+			return Count(false);
+	}
+	return Count(true);
+}
+
+/**
+ @brief Reset the visibility counters
+ */
+void CFrustum::ResetCounters(void)
+{
+	uiNumVisible = 0;
+	uiNumCulled = 0;
+}
+
+/**
+ @brief Get the number of objects which were visible since the last ResetCounters()
+ */
+unsigned int CFrustum::GetNumVisible(void) const
+{
+	return uiNumVisible;
+}
+
+/**
+ @brief Get the number of objects which were culled since the last ResetCounters()
+ */
+unsigned int CFrustum::GetNumCulled(void) const
+{
+	return uiNumCulled;
+}
+
+/**
+ @brief Update the visibility counters
+ @return bVisible
+ */
+bool CFrustum::Count(const bool bVisible)
+{
+	if (bVisible)
+		uiNumVisible++;
+	else
+		uiNumCulled++;
+	return bVisible;
+}
@@ -0,0 +1,56 @@
+/**
+ CFrustum
+
+ The 6 planes of a camera's view volume, for culling objects which are off screen.
+ Counts the number of visible and culled objects since the last ResetCounters().
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+class CFrustum
+{
+public:
+	enum PLANE
+	{
+		LEFT_PLANE,
+		RIGHT_PLANE,
+		BOTTOM_PLANE,
+		TOP_PLANE,
+		NEAR_PLANE,
+		FAR_PLANE,
+		NUM_PLANES
+	};
+
+	// Constructor
+	CFrustum(void);
+	// Destructor
+	virtual ~CFrustum(void);
+
+	// Compute the planes from the camera matrices
+	void Update(const glm::mat4& view, const glm::mat4& projection);
+
+	// Check if an axis-aligned box is at least partly inside the frustum
+	bool IsBoxVisible(const glm::vec3& vec3Min, const glm::vec3& vec3Max);
+	// Check if a sphere is at least partly inside the frustum
+	bool IsSphereVisible(const glm::vec3& vec3Centre, const float fRadius);
+
+	// Reset the visibility counters, e.g. at the start of a frame
+	void ResetCounters(void);
+	// Get the number of objects which were visible
+	unsigned int GetNumVisible(void) const;
+	// Get the number of objects which were culled
+	unsigned int GetNumCulled(void) const;
+
+protected:
+	// The planes, as (normal, distance). A point p is inside a plane if dot(normal, p) + distance >= 0.
+	glm::vec4 arrPlanes[NUM_PLANES];
+
+	// The visibility counters
+	unsigned int uiNumVisible;
+	unsigned int uiNumCulled;
+
+	// Update the visibility counters
+	bool Count(const bool bVisible);
+};
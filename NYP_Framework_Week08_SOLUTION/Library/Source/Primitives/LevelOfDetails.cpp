@@ -1,15 +1,35 @@
 #include "LevelOfDetails.h"
 
+// Include MeshCache
+#include "../System/MeshCache.h"
+
+#include <iostream>
+#include <vector>
+
 /**
  @brief Constructor
 */
 CLevelOfDetails::CLevelOfDetails(void)
 	: m_bStatus(false)
 	, eDetailLevel(HIGH_DETAILS)
+	, bSharedLODModel(false)
 {
 	arrLODDistance[HIGH_DETAILS]	= 0.0f;
 	arrLODDistance[MID_DETAILS]		= 15.0f;
 	arrLODDistance[LOW_DETAILS]		= 30.0f;
+
+	arrLODTriangleRatio[HIGH_DETAILS]	= 1.0f;
+	arrLODTriangleRatio[MID_DETAILS]	= 0.5f;
+	arrLODTriangleRatio[LOW_DETAILS]	= 0.2f;
+
+	for (int i = 0; i < NUM_DETAIL_LEVEL; i++)
+	{
+		arrVAO[i] = 0;
+		arrVBO[i] = 0;
+		arrIBO[i] = 0;
+		arrIndexSize[i] = 0;
+		arriTextureID[i] = 0;
+	}
 }
 
 /** 
@@ -17,6 +37,7 @@ CLevelOfDetails::CLevelOfDetails(void)
 */
 CLevelOfDetails::~CLevelOfDetails(void)
 {
+	DeleteLODModel();
 }
 
 /** 
@@ -61,3 +82,134 @@ bool CLevelOfDetails::SetDetailLevel(const DETAIL_LEVEL eDetailLevel)
 	}
 	return false;
 }
+
+/**
+ @brief Load an OBJ file and generate the meshes for all the levels of details.
+		The OBJ file is loaded once, and the MID and LOW meshes are simplified from it using arrLODTriangleRatio.
+		A level which has no fewer triangles than the level before it shares that level's OpenGL buffers.
+ @param file_path A const char* containing the name of the OBJ file
+ @param bUseCache A const bool which is true if the simplified meshes are to be cached on disk
+ @return true if all the meshes were loaded, else false
+ */
+bool CLevelOfDetails::LoadLODModel(const char* file_path, const bool bUseCache)
+{
+	DeleteLODModel();
+
+	std::vector<IndexedVertex> vertices;
+	std::vector<unsigned> indices;
+	if (CMeshCache::Load(file_path, vertices, indices) == false)
+		return false;
+
+	CMeshCache::Upload(	vertices.data(), (unsigned)vertices.size(),
+						indices.data(), (unsigned)indices.size(),
+						arrVAO[HIGH_DETAILS], arrVBO[HIGH_DETAILS], arrIBO[HIGH_DETAILS]);
+	arrIndexSize[HIGH_DETAILS] = (GLuint)indices.size();
+
+	std::vector<IndexedVertex> lodVertices;
+	std::vector<unsigned> lodIndices;
+	for (int i = MID_DETAILS; i < NUM_DETAIL_LEVEL; i++)
+	{
+		if (CMeshCache::LoadSimplified(	file_path, vertices, indices, arrLODTriangleRatio[i],
+										lodVertices, lodIndices, bUseCache) == false)
+		{
+			std::cout << "Unable to generate level of details " << i << " for " << file_path << std::endl;
+			DeleteLODModel();
+			return false;
+		}
+
+		// The mesh could not be reduced any further, so reuse the buffers of the previous level
+		if (lodIndices.size() >= arrIndexSize[i - 1])
+		{
+			arrVAO[i] = arrVAO[i - 1];
+			arrVBO[i] = arrVBO[i - 1];
+			arrIBO[i] = arrIBO[i - 1];
+			arrIndexSize[i] = arrIndexSize[i - 1];
+			continue;
+		}
+
+		CMeshCache::Upload(	lodVertices.data(), (unsigned)lodVertices.size(),
+							lodIndices.data(), (unsigned)lodIndices.size(),
+							arrVAO[i], arrVBO[i], arrIBO[i]);
+		arrIndexSize[i] = (GLuint)lodIndices.size();
+	}
+
+	SetLODStatus(true);
+	eDetailLevel = HIGH_DETAILS;
+	return true;
+}
+
+/**
+ @brief Use the meshes of another CLevelOfDetails, so that many entities can be drawn from one set of
+		OpenGL buffers, e.g. with CInstancedRenderer. The meshes are not deleted by this CLevelOfDetails,
+		so cSource must be kept until this CLevelOfDetails is deleted.
+ @param cSource A const CLevelOfDetails& whose meshes were loaded by LoadLODModel
+ @return true if cSource has meshes, else false
+ */
+bool CLevelOfDetails::ShareLODModel(const CLevelOfDetails& cSource)
+{
+	DeleteLODModel();
+
+	if (cSource.arrIndexSize[HIGH_DETAILS] == 0)
+		return false;
+
+	for (int i = 0; i < NUM_DETAIL_LEVEL; i++)
+	{
+		arrVAO[i] = cSource.arrVAO[i];
+		arrVBO[i] = cSource.arrVBO[i];
+		arrIBO[i] = cSource.arrIBO[i];
+		arrIndexSize[i] = cSource.arrIndexSize[i];
+		arriTextureID[i] = cSource.arriTextureID[i];
+	}
+	bSharedLODModel = true;
+
+	SetLODStatus(true);
+	eDetailLevel = HIGH_DETAILS;
+	return true;
+}
+
+/**
+ @brief Select the level of details for the distance to the viewer.
+		The furthest level whose distance in arrLODDistance has been reached is used.
+ @param fDistance A const float containing the distance to the viewer
+ @return The selected level of details
+ */
+CLevelOfDetails::DETAIL_LEVEL CLevelOfDetails::UpdateDetailLevel(const float fDistance)
+{
+	if (m_bStatus == false)
+		return eDetailLevel;
+
+	DETAIL_LEVEL eNewDetailLevel = HIGH_DETAILS;
+	for (int i = MID_DETAILS; i < NUM_DETAIL_LEVEL; i++)
+	{
+		if (fDistance >= arrLODDistance[i])
+			eNewDetailLevel = (DETAIL_LEVEL)i;
+	}
+	SetDetailLevel(eNewDetailLevel);
+
+	return eDetailLevel;
+}
+
+/**
+ @brief Delete the meshes which were created by LoadLODModel, or forget the meshes of ShareLODModel.
+		The levels are deleted from the lowest up, so a level which shares the buffers of the level
+		before it is skipped instead of being deleted twice.
+ */
+void CLevelOfDetails::DeleteLODModel(void)
+{
+	for (int i = NUM_DETAIL_LEVEL - 1; i >= 0; i--)
+	{
+		bool bShared = (bSharedLODModel) || ((i > 0) && (arrVAO[i] == arrVAO[i - 1]));
+		if ((arrVAO[i] != 0) && (!bShared))
+		{
+			glDeleteVertexArrays(1, &arrVAO[i]);
+			glDeleteBuffers(1, &arrVBO[i]);
+			glDeleteBuffers(1, &arrIBO[i]);
+		}
+		arrVAO[i] = 0;
+		arrVBO[i] = 0;
+		arrIBO[i] = 0;
+		arrIndexSize[i] = 0;
+	}
+	bSharedLODModel = false;
+	SetLODStatus(false);
+}
@@ -19,6 +19,8 @@ public:
 
 	// Array containing the distances to switch LOD
 	float arrLODDistance[3];
+	// Array containing the fraction of the triangles which are kept for each LOD
+	float arrLODTriangleRatio[3];
 
 	// Constructor
 	CLevelOfDetails(void);
@@ -35,6 +37,13 @@ public:
 	// Get the current level of details
 	virtual DETAIL_LEVEL GetDetailLevel(void) const;
 
+	// Load an OBJ file and generate the meshes for all the levels of details
+	virtual bool LoadLODModel(const char* file_path, const bool bUseCache = true);
+	// Use the meshes of another CLevelOfDetails, which must be kept until this one is deleted
+	virtual bool ShareLODModel(const CLevelOfDetails& cSource);
+	// Select the level of details for the distance to the viewer
+	virtual DETAIL_LEVEL UpdateDetailLevel(const float fDistance);
+
 protected:
 	// Boolean flag to indicate if this LOD is active
 	bool m_bStatus;
@@ -43,7 +52,15 @@ protected:
 
 	// OpenGL objects using arrays
 	GLuint arrVAO[3], arrVBO[3], arrIBO[3];
+	// The number of indices in each IBO
+	GLuint arrIndexSize[3];
 
 	// The texture ID in OpenGL
 	GLuint arriTextureID[3];
+
+	// True if the meshes belong to another CLevelOfDetails, so they are not deleted by this one
+	bool bSharedLODModel;
+
+	// Delete the meshes which were created by LoadLODModel
+	virtual void DeleteLODModel(void);
 };
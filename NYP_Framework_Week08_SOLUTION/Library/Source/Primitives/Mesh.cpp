@@ -1,14 +1,31 @@
 #include "Mesh.h"
-#include "GL\glew.h"
+#include "MeshBuilder.h"
+#include "GL/glew.h"
 
-CMesh::CMesh(): mode(DRAW_TRIANGLES)
+CMesh::CMesh(): mode(DRAW_TRIANGLES), shared(false)
 {
 	glGenBuffers(1, &vertexBuffer);
 	glGenBuffers(1, &indexBuffer);
 }
 
+CMesh::CMesh(unsigned vertexBuffer, unsigned indexBuffer, unsigned indexSize)
+	: vertexBuffer(vertexBuffer)
+	, indexBuffer(indexBuffer)
+	, indexSize(indexSize)
+	, mode(DRAW_TRIANGLES)
+	, shared(true)
+{
+}
+
 CMesh::~CMesh()
 {
+	//Shared buffers are deleted by CMeshBuilder when the last mesh using them is deleted
+	if (shared)
+	{
+		CMeshBuilder::ReleaseBuffers(vertexBuffer);
+		return;
+	}
+
 	glDeleteBuffers(1, &vertexBuffer);
 	glDeleteBuffers(1, &indexBuffer);
 }
@@ -43,7 +43,9 @@ public:
 	};
 
 	CMesh();
-	~CMesh();
+	//Use buffers which are shared with other meshes. They are released through CMeshBuilder.
+	CMesh(unsigned vertexBuffer, unsigned indexBuffer, unsigned indexSize);
+	virtual ~CMesh();
 	virtual void Render();
 
 	unsigned vertexBuffer;
@@ -51,6 +53,9 @@ public:
 	unsigned indexSize;
 
 	DRAW_MODE mode;
+
+	//Are the buffers shared with other meshes
+	bool shared;
 };
 
 #endif
\ No newline at end of file
@@ -1,81 +1,124 @@
 #include "MeshBuilder.h"
-#include <GL\glew.h>
+#include <GL/glew.h>
+#include "../GameControl/Settings.h"
 #include <vector>
 
+std::map<CMeshBuilder::SMeshKey, CMeshBuilder::SMeshBuffers> CMeshBuilder::meshCache;
+
 CMesh* CMeshBuilder::GenerateQuad(glm::vec4 color, float width, float height)
 {
-	Vertex v;
-	std::vector<Vertex> vertex_buffer_data;
-	std::vector<GLuint> index_buffer_data;
-
-	v.position = glm::vec3(-0.5f * width, -0.5f * height, 0);
-	v.color = color;
-	v.texCoord = glm::vec2(0, 0);
-	vertex_buffer_data.push_back(v);
+	SMeshKey key = { width, height, 1, 1, color };
+	const SMeshBuffers& buffers = AcquireBuffers(key);
 
-	v.position = glm::vec3(0.5f * width, -0.5f * height, 0);
-	v.color = color;
-	v.texCoord = glm::vec2(1.0f, 0);
-	vertex_buffer_data.push_back(v);
+	CMesh* mesh = new CMesh(buffers.vertexBuffer, buffers.indexBuffer, buffers.indexSize);
+	mesh->mode = CMesh::DRAW_TRIANGLES;
 
-	v.position = glm::vec3(0.5f * width, 0.5f * height, 0);
-	v.color = color;
-	v.texCoord = glm::vec2(1.0f, 1.0f);
-	vertex_buffer_data.push_back(v);
+	return mesh;
+}
 
-	v.position = glm::vec3(-0.5f * width, 0.5f * height, 0);
-	v.color = color;
-	v.texCoord = glm::vec2(0, 1.0f);
-	vertex_buffer_data.push_back(v);
+CSpriteAnimation* CMeshBuilder::GenerateSpriteAnimation(unsigned numRow, unsigned numCol, float tile_width, float tile_height, bool gpuFrameSelection)
+{
+	// If the vertex shader selects the frame, one quad is enough. Its texture coordinates
+	// are the position within a frame, which Shader/Scene2DSprite.vs moves to the current frame.
+	SMeshKey key = { tile_width, tile_height, gpuFrameSelection ? 1 : numRow, gpuFrameSelection ? 1 : numCol, glm::vec4(1.0f) };
+	const SMeshBuffers& buffers = AcquireBuffers(key);
+
+	CSpriteAnimation* mesh = new CSpriteAnimation(numRow, numCol, buffers.vertexBuffer, buffers.indexBuffer, buffers.indexSize);
+	mesh->SetFrameSize(tile_width, tile_height);
+	mesh->SetGPUFrameSelection(gpuFrameSelection);
+	mesh->mode = CMesh::DRAW_TRIANGLES;
 
-	index_buffer_data.push_back(3);
-	index_buffer_data.push_back(0);
-	index_buffer_data.push_back(2);
-	index_buffer_data.push_back(1);
-	index_buffer_data.push_back(2);
-	index_buffer_data.push_back(0);
+	return mesh;
+}
 
-	CMesh* mesh = new CMesh();
+void CMeshBuilder::ReleaseBuffers(unsigned vertexBuffer)
+{
+	for (std::map<SMeshKey, SMeshBuffers>::iterator it = meshCache.begin(); it != meshCache.end(); ++it)
+	{
+		if (it->second.vertexBuffer != vertexBuffer)
+			continue;
 
-	glBindBuffer(GL_ARRAY_BUFFER, mesh->vertexBuffer);
-	glBufferData(GL_ARRAY_BUFFER, vertex_buffer_data.size() * sizeof(Vertex), &vertex_buffer_data[0], GL_STATIC_DRAW);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->indexBuffer);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_buffer_data.size() * sizeof(GLuint), &index_buffer_data[0], GL_STATIC_DRAW);
+		if (--it->second.refCount == 0)
+		{
+			glDeleteBuffers(1, &it->second.vertexBuffer);
+			glDeleteBuffers(1, &it->second.indexBuffer);
+			meshCache.erase(it);
+		}
+		return;
+	}
+}
 
-	mesh->indexSize = index_buffer_data.size();
-	mesh->mode = CMesh::DRAW_TRIANGLES;
+unsigned CMeshBuilder::GetNumCachedMeshes()
+{
+	return (unsigned)meshCache.size();
+}
 
-	return mesh;
+bool CMeshBuilder::SMeshKey::operator<(const SMeshKey& other) const
+{
+	if (width != other.width)
+		return width < other.width;
+	if (height != other.height)
+		return height < other.height;
+	if (numRow != other.numRow)
+		return numRow < other.numRow;
+	if (numCol != other.numCol)
+		return numCol < other.numCol;
+	for (int i = 0; i < 4; ++i)
+	{
+		if (color[i] != other.color[i])
+			return color[i] < other.color[i];
+	}
+	return false;
 }
 
-CSpriteAnimation* CMeshBuilder::GenerateSpriteAnimation(unsigned numRow, unsigned numCol, float tile_width, float tile_height)
+const CMeshBuilder::SMeshBuffers& CMeshBuilder::AcquireBuffers(const SMeshKey& key)
 {
+	// There is no OpenGL context in headless mode, so the meshes get no buffers and are never drawn
+	if (CSettings::GetInstance()->bHeadless)
+	{
+		static SMeshBuffers noBuffers;
+		noBuffers.vertexBuffer = 0;
+		noBuffers.indexBuffer = 0;
+		noBuffers.indexSize = key.numRow * key.numCol * 6;
+		noBuffers.refCount = 0;
+		return noBuffers;
+	}
+
+	std::map<SMeshKey, SMeshBuffers>::iterator it = meshCache.find(key);
+	if (it != meshCache.end())
+	{
+		++it->second.refCount;
+		return it->second;
+	}
+
+	// A quad for each cell of the sheet, numbered left to right from the top row
 	Vertex v;
+	v.color = key.color;
 	std::vector<Vertex> vertex_buffer_data;
 	std::vector<GLuint> index_buffer_data;
 
-	float width = 1.f / numCol;
-	float height = 1.f / numRow;
+	float width = 1.f / key.numCol;
+	float height = 1.f / key.numRow;
 	int offset = 0;
-	for (unsigned i = 0; i < numRow; ++i)
+	for (unsigned i = 0; i < key.numRow; ++i)
 	{
-		for (unsigned j = 0; j < numCol; ++j)
+		for (unsigned j = 0; j < key.numCol; ++j)
 		{
 			float u1 = j * width;
 			float v1 = 1.f - height - i * height;
-			v.position = glm::vec3(-0.5f * tile_width, -0.5f * tile_height, 0);
+			v.position = glm::vec3(-0.5f * key.width, -0.5f * key.height, 0);
 			v.texCoord = glm::vec2(u1, v1);
 			vertex_buffer_data.push_back(v);
 
-			v.position = glm::vec3(0.5f * tile_width, -0.5f * tile_height, 0);
+			v.position = glm::vec3(0.5f * key.width, -0.5f * key.height, 0);
 			v.texCoord = glm::vec2(u1 + width, v1);
 			vertex_buffer_data.push_back(v);
 
-			v.position = glm::vec3(0.5f * tile_width, 0.5f * tile_height, 0);
+			v.position = glm::vec3(0.5f * key.width, 0.5f * key.height, 0);
 			v.texCoord = glm::vec2(u1 + width, v1 + height);
 			vertex_buffer_data.push_back(v);
 
-			v.position = glm::vec3(-0.5f * tile_width, 0.5f * tile_height, 0);
+			v.position = glm::vec3(-0.5f * key.width, 0.5f * key.height, 0);
 			v.texCoord = glm::vec2(u1, v1 + height);
 			vertex_buffer_data.push_back(v);
 
@@ -89,15 +132,16 @@ CSpriteAnimation* CMeshBuilder::GenerateSpriteAnimation(unsigned numRow, unsigne
 		}
 	}
 
-	CSpriteAnimation* mesh = new CSpriteAnimation(numRow, numCol);
+	SMeshBuffers buffers;
+	glGenBuffers(1, &buffers.vertexBuffer);
+	glGenBuffers(1, &buffers.indexBuffer);
+	buffers.indexSize = index_buffer_data.size();
+	buffers.refCount = 1;
 
-	glBindBuffer(GL_ARRAY_BUFFER, mesh->vertexBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, buffers.vertexBuffer);
 	glBufferData(GL_ARRAY_BUFFER, vertex_buffer_data.size() * sizeof(Vertex), &vertex_buffer_data[0], GL_STATIC_DRAW);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->indexBuffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.indexBuffer);
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_buffer_data.size() * sizeof(GLuint), &index_buffer_data[0], GL_STATIC_DRAW);
 
-	mesh->indexSize = index_buffer_data.size();
-	mesh->mode = CMesh::DRAW_TRIANGLES;
-
-	return mesh;
+	return meshCache[key] = buffers;
 }
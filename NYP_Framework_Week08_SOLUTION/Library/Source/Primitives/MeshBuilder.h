@@ -5,6 +5,9 @@
  This MeshBuilder follows the style of NYP Computer Graphics Module for the ease of students.
  The Job of the meshbuilder is to create mesh with vertices, filling up the vertices and 
  indices buffer and return to the entity to be used.
+ Meshes with the same width, height, rows, columns and colour share their buffers, which are
+ counted and deleted when the last mesh using them is deleted. Spawning entities which use
+ the same sprite sheet therefore does not create any new buffers.
  */
 #ifndef MESH_BUILDER_H
 #define MESH_BUILDER_H
@@ -12,11 +15,45 @@
 #include "Mesh.h"
 #include "SpriteAnimation.h"
 
+#include <map>
+#include <vector>
+
 class CMeshBuilder
 {
 	public:
-		static CSpriteAnimation* GenerateSpriteAnimation(unsigned numRow, unsigned numCol, float tile_width = 1.0f, float tile_height = 1.0f);
+		static CSpriteAnimation* GenerateSpriteAnimation(unsigned numRow, unsigned numCol, float tile_width = 1.0f, float tile_height = 1.0f, bool gpuFrameSelection = false);
 		static CMesh* GenerateQuad(glm::vec4 color = glm::vec4(1,1,1,1), float width = 1.0f, float height = 1.0f);
+
+		// Release a mesh's hold on its shared buffers, and delete them if no other mesh is using them
+		static void ReleaseBuffers(unsigned vertexBuffer);
+		// Get the number of buffer pairs which are shared by meshes
+		static unsigned GetNumCachedMeshes();
+
+	private:
+		// The layout of a mesh. Meshes with the same layout share their buffers.
+		struct SMeshKey
+		{
+			float width, height;
+			unsigned numRow, numCol;
+			glm::vec4 color;
+
+			bool operator<(const SMeshKey& other) const;
+		};
+
+		// The buffers of a layout, and the number of meshes using them
+		struct SMeshBuffers
+		{
+			unsigned vertexBuffer;
+			unsigned indexBuffer;
+			unsigned indexSize;
+			unsigned refCount;
+		};
+
+		// Get the buffers of a layout, creating them if no mesh is using them, and count the new mesh
+		static const SMeshBuffers& AcquireBuffers(const SMeshKey& key);
+
+		// The buffers of each layout
+		static std::map<SMeshKey, SMeshBuffers> meshCache;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -8,7 +8,166 @@ Sprite Animation
 */
 /******************************************************************************/
 #include "SpriteAnimation.h"
-#include "GL\glew.h"
+#include "GL/glew.h"
+
+/******************************************************************************/
+/*!
+\brief
+Constructor
+*/
+/******************************************************************************/
+CAnimationClipSet::CAnimationClipSet()
+{
+}
+
+/******************************************************************************/
+/*!
+\brief
+Destructor
+*/
+/******************************************************************************/
+CAnimationClipSet::~CAnimationClipSet()
+{
+}
+
+/******************************************************************************/
+/*!
+\brief
+Add a clip by defining the start and the end
+
+param name - the name of the clip
+
+param start - the starting frame based on the sprite sheet
+
+param end - the ending frame based on the sprite sheet
+
+\exception None
+\return The handle of the clip
+*/
+/******************************************************************************/
+int CAnimationClipSet::AddClip(const std::string& name, int start, int end)
+{
+	//Check if start is more than end
+	//Swap over if it is
+	if (start > end)
+		std::swap(start, end);
+
+	//Add in all the frames in the range
+	std::vector<int> frames;
+	for (int i = start; i < end; ++i)
+	{
+		frames.push_back(i);
+	}
+
+	return AddClip(name, frames);
+}
+
+/******************************************************************************/
+/*!
+\brief
+Add a clip by defining the frame values. A clip with the same name is replaced.
+
+param name - the name of the clip
+
+param frames - the frames based on the sprite sheet
+
+\exception None
+\return The handle of the clip
+*/
+/******************************************************************************/
+int CAnimationClipSet::AddClip(const std::string& name, const std::vector<int>& frames)
+{
+	//Replace the frames of an existing clip, so that its handle stays the same
+	auto iter = clipHandles.find(name);
+	if (iter != clipHandles.end())
+	{
+		clips[iter->second].frames = frames;
+		clips[iter->second].contiguous = IsContiguous(frames);
+		return iter->second;
+	}
+
+	CAnimationClip clip;
+	clip.animationName = name;
+	clip.frames = frames;
+	clip.contiguous = IsContiguous(frames);
+	clips.push_back(clip);
+
+	const int handle = (int)clips.size() - 1;
+	clipHandles[name] = handle;
+	return handle;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the handle of a clip
+
+param name - the name of the clip
+
+\exception None
+\return The handle of the clip, or -1 if there is no clip with that name
+*/
+/******************************************************************************/
+int CAnimationClipSet::GetClipHandle(const std::string& name) const
+{
+	auto iter = clipHandles.find(name);
+	if (iter == clipHandles.end())
+		return -1;
+	return iter->second;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get a clip
+
+param handle - the handle of the clip
+
+\exception None
+\return The clip, or NULL if the handle is not valid
+*/
+/******************************************************************************/
+const CAnimationClip* CAnimationClipSet::GetClip(int handle) const
+{
+	if ((handle < 0) || (handle >= (int)clips.size()))
+		return NULL;
+	return &clips[handle];
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the number of clips
+
+\exception None
+\return The number of clips
+*/
+/******************************************************************************/
+int CAnimationClipSet::GetNumClips() const
+{
+	return (int)clips.size();
+}
+
+/******************************************************************************/
+/*!
+\brief
+Check if the frames follow one another in the sprite sheet
+
+param frames - the frames
+
+\exception None
+\return true if each frame is one more than the frame before it
+*/
+/******************************************************************************/
+bool CAnimationClipSet::IsContiguous(const std::vector<int>& frames)
+{
+	for (unsigned int i = 1; i < frames.size(); ++i)
+	{
+		if (frames[i] != frames[0] + (int)i)
+			return false;
+	}
+	return true;
+}
 
 /******************************************************************************/
 /*!
@@ -20,10 +179,57 @@ CSpriteAnimation::CSpriteAnimation(int row, int col)
 	: CMesh()
 	, row(row)
 	, col(col)
+	, frameWidth(1.0f)
+	, frameHeight(1.0f)
+	, currentTime(0)
+	, currentFrame(0)
+	, frameDirty(false)
+	, currentAnimation(-1)
+	, repeatCount(0)
+	, animTime(0.0f)
+	, animActive(false)
+	, gpuFrameSelection(false)
+	, atlasUVMin(0.0f, 0.0f)
+	, atlasUVMax(1.0f, 1.0f)
+	, clipSet(NULL)
+	, ownClipSet(NULL)
+{
+}
+
+/******************************************************************************/
+/*!
+\brief
+Constructor which uses buffers that are shared with other sprites, e.g. from CMeshBuilder
+
+param row - the number of rows in the sprite sheet
+
+param col - the number of columns in the sprite sheet
+
+param vertexBuffer - the shared vertex buffer
+
+param indexBuffer - the shared index buffer
+
+param indexSize - the number of indices
+*/
+/******************************************************************************/
+CSpriteAnimation::CSpriteAnimation(int row, int col, unsigned vertexBuffer, unsigned indexBuffer, unsigned indexSize)
+	: CMesh(vertexBuffer, indexBuffer, indexSize)
+	, row(row)
+	, col(col)
+	, frameWidth(1.0f)
+	, frameHeight(1.0f)
 	, currentTime(0)
 	, currentFrame(0)
-	, playCount(0)
-	, currentAnimation("")
+	, frameDirty(false)
+	, currentAnimation(-1)
+	, repeatCount(0)
+	, animTime(0.0f)
+	, animActive(false)
+	, gpuFrameSelection(false)
+	, atlasUVMin(0.0f, 0.0f)
+	, atlasUVMax(1.0f, 1.0f)
+	, clipSet(NULL)
+	, ownClipSet(NULL)
 {
 }
 
@@ -35,23 +241,20 @@ Destructor
 /******************************************************************************/
 CSpriteAnimation::~CSpriteAnimation()
 {
-	//Loop through the animation list
-	for (auto iter = animationList.begin(); iter != animationList.end(); ++iter)
+	//Delete the clip set if it was created by AddAnimation. A shared clip set is deleted by its owner.
+	if (ownClipSet != NULL)
 	{
-		if (iter->second != NULL)
-		{
-			//delete the animation
-			delete iter->second;
-		}
+		delete ownClipSet;
+		ownClipSet = NULL;
 	}
-	//Remove everything
-	animationList.clear();
+	clipSet = NULL;
 }
 
 /******************************************************************************/
 /*!
 \brief
-Update the current frame of the current animation
+Update the current time of the current animation. The current frame is not
+worked out until it is needed, so sprites which are not drawn cost very little.
 
 param dt - the delta time
 
@@ -62,44 +265,53 @@ param dt - the delta time
 void CSpriteAnimation::Update(double dt)
 {
 	//Check if the current animation is active
-	if (animationList[currentAnimation]->animActive)
+	if (!animActive)
+		return;
+
+	//Add the delta time
+	currentTime += static_cast<float>(dt);
+	frameDirty = true;
+
+	//If the animation is infinite, keep the time within one play so that it does not lose precision
+	if ((repeatCount == -1) && (animTime > 0.0f) && (currentTime >= animTime))
+	{
+		currentTime = fmod(currentTime, animTime);
+	}
+	//If the animation has played repeatCount + 1 times, stop it at its last frame
+	else if ((repeatCount >= 0) && (currentTime >= animTime * (repeatCount + 1)))
 	{
-		//Add the delta time
-		currentTime += static_cast<float>(dt);
-
-		//Get the number of frame to get the frame per second
-		int numFrame = animationList[currentAnimation]->frames.size();
-		float frameTime = animationList[currentAnimation]->animTime / numFrame;
-
-		//Set the current frame based on the current time
-		currentFrame = animationList[currentAnimation]->frames[fmin((int)animationList[currentAnimation]->frames.size() - 1 , static_cast<int>(currentTime / frameTime))];
-
-		//check if the current time is more than the total animated time
-		if (currentTime >= animationList[currentAnimation]->animTime)
-		{
-			//if it is less than the repeat count, increase the count and repeat
-			if (playCount < animationList[currentAnimation]->repeatCount)
-			{
-				++playCount;
-				currentTime = 0;
-				currentFrame = animationList[currentAnimation]->frames[0];
-			}
-			//if we repeat count is 0 or we have reach same number of play count
-			else
-			{
-				animationList[currentAnimation]->animActive = false;
-				animationList[currentAnimation]->ended = true;
-			}
-
-			//If the animaton is infinite
-			if (animationList[currentAnimation]->repeatCount == -1)
-			{
-				currentTime = 0.f;
-				currentFrame = animationList[currentAnimation]->frames[0];
-				animationList[currentAnimation]->animActive = true;
-				animationList[currentAnimation]->ended = false;
-			}
-		}
+		currentTime = animTime * (repeatCount + 1);
+		animActive = false;
+	}
+}
+
+/******************************************************************************/
+/*!
+\brief
+Update many animated sprites and work out their current frames in one pass,
+e.g. all the enemies and bombs of a level
+
+param sprites - the sprites to update, which may contain NULL
+
+param count - the number of sprites
+
+param dt - the delta time
+
+\exception None
+\return None
+*/
+/******************************************************************************/
+void CSpriteAnimation::UpdateBatch(CSpriteAnimation* const* sprites, unsigned int count, double dt)
+{
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		CSpriteAnimation* sprite = sprites[i];
+		if (sprite == NULL)
+			continue;
+
+		sprite->Update(dt);
+		if (sprite->frameDirty)
+			sprite->UpdateFrame();
 	}
 }
 
@@ -127,19 +339,76 @@ void CSpriteAnimation::Render()
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
 
+	//The mesh is a single quad, so pass the frame selection to Shader/Scene2DSprite.vs as constant attributes
+	if (gpuFrameSelection)
+	{
+		glm::vec4 sheet;
+		glm::vec2 time;
+		GetFrameSelection(sheet, time);
+		for (GLuint i = 0; i < 4; ++i)
+			glVertexAttrib4f(SPRITE_TRANSFORM_LOCATION + i, i == 0, i == 1, i == 2, i == 3);
+		glVertexAttrib4fv(SPRITE_SHEET_LOCATION, &sheet[0]);
+		glVertexAttrib2fv(SPRITE_TIME_LOCATION, &time[0]);
+
+		glm::vec4 atlas;
+		GetAtlasRegion(atlas);
+		glVertexAttrib4fv(SPRITE_ATLAS_LOCATION, &atlas[0]);
+	}
+
 	//Draw based on the current frame
+	const int frame = gpuFrameSelection ? 0 : GetCurrentFrame();
 	if (mode == DRAW_LINES)
-		glDrawElements(GL_LINES, 6, GL_UNSIGNED_INT, (void*)(currentFrame * 6 * sizeof(GLuint)));
+		glDrawElements(GL_LINES, 6, GL_UNSIGNED_INT, (void*)(frame * 6 * sizeof(GLuint)));
 	else if (mode == DRAW_TRIANGLE_STRIP)
-		glDrawElements(GL_TRIANGLE_STRIP, 6, GL_UNSIGNED_INT, (void*)(currentFrame * 6 * sizeof(GLuint)));
+		glDrawElements(GL_TRIANGLE_STRIP, 6, GL_UNSIGNED_INT, (void*)(frame * 6 * sizeof(GLuint)));
 	else
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)(currentFrame * 6 * sizeof(GLuint)));
+		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)(frame * 6 * sizeof(GLuint)));
 
 	glDisableVertexAttribArray(2);
 	glDisableVertexAttribArray(1);
 	glDisableVertexAttribArray(0);
 }
 
+/******************************************************************************/
+/*!
+\brief
+Use a clip set which is shared with other sprites. It is not deleted by this sprite.
+
+param clipSet - the clip set
+
+\exception None
+\return None
+*/
+/******************************************************************************/
+void CSpriteAnimation::SetClipSet(const CAnimationClipSet* clipSet)
+{
+	//Delete the clip set which was created by AddAnimation
+	if (ownClipSet != NULL)
+	{
+		delete ownClipSet;
+		ownClipSet = NULL;
+	}
+
+	this->clipSet = clipSet;
+	currentAnimation = ((clipSet != NULL) && (clipSet->GetNumClips() > 0)) ? 0 : -1;
+	animActive = false;
+	frameDirty = true;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the clip set of this sprite
+
+\exception None
+\return The clip set, or NULL if no clip has been added
+*/
+/******************************************************************************/
+const CAnimationClipSet* CSpriteAnimation::GetClipSet() const
+{
+	return clipSet;
+}
+
 /******************************************************************************/
 /*!
 \brief
@@ -152,32 +421,23 @@ param start - the starting frame based on the sprite sheet
 param end - the ending frame based on the sprite sheet
 
 \exception None
-\return None
+\return The handle of the animation, or -1 if the clip set is shared
 */
 /******************************************************************************/
-void CSpriteAnimation::AddAnimation(std::string anim_name, int start, int end)
+int CSpriteAnimation::AddAnimation(std::string anim_name, int start, int end)
 {
-	CAnimation* anim = new CAnimation();
-
-	//Check if start is more than end
-	//Swap over if it is
-	if(start > end)
-		std::swap(start, end);
+	CAnimationClipSet* clips = GetOwnClipSet();
+	if (clips == NULL)
+		return -1;
 
-	//Add in all the frames in the range
-	for (int i = start; i < end; ++i)
-	{
-		anim->AddFrame(i);
-	}
-
-	//Link the animation to the animation list
-	animationList[anim_name] = anim;
+	const int handle = clips->AddClip(anim_name, start, end);
 	//Set the current animation if it does not exisit
-	if (currentAnimation == "")
+	if (currentAnimation == -1)
 	{
-		currentAnimation = anim_name;
+		currentAnimation = handle;
+		frameDirty = true;
 	}
-	animationList[anim_name]->animActive = false;
+	return handle;
 }
 
 /******************************************************************************/
@@ -192,37 +452,73 @@ param count - the number of frame in the animation
 param ... - the frames
 
 \exception None
-\return None
+\return The handle of the animation, or -1 if the clip set is shared
 */
 /******************************************************************************/
-void CSpriteAnimation::AddSequeneAnimation(std::string anim_name, int count ...)
+int CSpriteAnimation::AddSequeneAnimation(std::string anim_name, int count ...)
 {
-	CAnimation* anim = new CAnimation();
+	CAnimationClipSet* clips = GetOwnClipSet();
+	if (clips == NULL)
+		return -1;
 
+	std::vector<int> frames;
 	va_list args;
 	va_start(args, count);
 	//Add the frames based on the input
 	for (int i = 0; i < count; ++i)
 	{
 		int value = va_arg(args, int);
-		anim->AddFrame(value);
+		frames.push_back(value);
 	}
 	va_end(args);
 
-	//Link the animation to the animation list
-	animationList[anim_name] = anim;
+	const int handle = clips->AddClip(anim_name, frames);
 	//Set the current animation if it does not exisit
-	if (currentAnimation == "")
+	if (currentAnimation == -1)
 	{
-		currentAnimation = anim_name;
+		currentAnimation = handle;
+		frameDirty = true;
 	}
-	animationList[anim_name]->animActive = false;
+	return handle;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Play the animation based on the given handle
+
+param handle - the handle of the animation in the clip set
+
+param repeat - the number of repeats (-1 for infinite looping)
+
+param time - the total time of the animation
+
+\exception None
+\return None
+*/
+/******************************************************************************/
+void CSpriteAnimation::PlayAnimation(int handle, int repeat, float time)
+{
+	//Check if the handle exists
+	if ((clipSet == NULL) || (clipSet->GetClip(handle) == NULL))
+		return;
+
+	//Playing another animation starts it from the beginning
+	if ((handle != currentAnimation) || (!animActive))
+		currentTime = 0.0f;
+
+	currentAnimation = handle;
+	repeatCount = repeat;
+	animTime = time;
+	animActive = true;
+	frameDirty = true;
 }
 
 /******************************************************************************/
 /*!
 \brief
-Play the animation based on the given name
+Play the animation based on the given name. This looks up the name every time,
+so use the handle instead if it is played often.
 
 param anim_name - the name of the animation
 
@@ -236,12 +532,10 @@ param time - the total time of the animation
 /******************************************************************************/
 void CSpriteAnimation::PlayAnimation(std::string anim_name, int repeat, float time)
 {
-	//Check if the anim name exist 
-	if (animationList[anim_name] != nullptr)
-	{
-		currentAnimation = anim_name;
-		animationList[anim_name]->Set(repeat, time, true);
-	}
+	if (clipSet == NULL)
+		return;
+
+	PlayAnimation(clipSet->GetClipHandle(anim_name), repeat, time);
 }
 
 /******************************************************************************/
@@ -255,7 +549,7 @@ Resume the current animation if it is Paused
 /******************************************************************************/
 void CSpriteAnimation::Resume()
 {
-	animationList[currentAnimation]->animActive = true;
+	animActive = (currentAnimation != -1);
 }
 
 /******************************************************************************/
@@ -269,7 +563,7 @@ Pause the current animation
 /******************************************************************************/
 void CSpriteAnimation::Pause()
 {
-	animationList[currentAnimation]->animActive = false;
+	animActive = false;
 }
 
 /******************************************************************************/
@@ -283,6 +577,261 @@ Reset the current animation
 /******************************************************************************/
 void CSpriteAnimation::Reset()
 {
-	currentFrame = animationList[currentAnimation]->frames[0];
-	playCount = 0;
-}
\ No newline at end of file
+	currentTime = 0.0f;
+	frameDirty = true;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the current frame in the sprite sheet, working it out if the time has changed
+
+\exception None
+\return The current frame
+*/
+/******************************************************************************/
+int CSpriteAnimation::GetCurrentFrame() const
+{
+	if (frameDirty)
+		UpdateFrame();
+	return currentFrame;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Set the size of a frame, which is the size of the quad that it is drawn on
+
+param width - the width of a frame
+
+param height - the height of a frame
+
+\exception None
+\return None
+*/
+/******************************************************************************/
+void CSpriteAnimation::SetFrameSize(float width, float height)
+{
+	frameWidth = width;
+	frameHeight = height;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the size of a frame
+
+\exception None
+\return The width and height of a frame
+*/
+/******************************************************************************/
+glm::vec2 CSpriteAnimation::GetFrameSize() const
+{
+	return glm::vec2(frameWidth, frameHeight);
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the texture coordinates of the current frame in the sprite sheet.
+Frames are numbered left to right, from the top row of the sprite sheet.
+
+param uvMin - the bottom left texture coordinate of the frame
+
+param uvMax - the top right texture coordinate of the frame
+
+\exception None
+\return None
+*/
+/******************************************************************************/
+void CSpriteAnimation::GetFrameUV(glm::vec2& uvMin, glm::vec2& uvMax) const
+{
+	float width = 1.f / col;
+	float height = 1.f / row;
+	const int frame = GetCurrentFrame();
+	int i = frame / col;
+	int j = frame % col;
+
+	uvMin = glm::vec2(j * width, 1.f - height - i * height);
+	uvMax = uvMin + glm::vec2(width, height);
+
+	//Move the frame into the sprite sheet's place in the texture atlas
+	const glm::vec2 atlasSize = atlasUVMax - atlasUVMin;
+	uvMin = atlasUVMin + uvMin * atlasSize;
+	uvMax = atlasUVMin + uvMax * atlasSize;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Set where the sprite sheet is in a texture atlas, e.g. CTextureAtlas::SRegion::vec2UVMin and
+vec2UVMax. GetFrameUV and Shader/Scene2DSprite.vs then select the frames within that region.
+The mesh of a sprite which is not selected by the vertex shader still has the texture coordinates
+of the whole sprite sheet, so such a sprite must be drawn by CSpriteBatch2D instead of Render.
+
+param uvMin - the texture coordinates of the bottom left corner of the sprite sheet
+
+param uvMax - the texture coordinates of the top right corner of the sprite sheet
+
+\exception None
+\return None
+*/
+/******************************************************************************/
+void CSpriteAnimation::SetAtlasRegion(const glm::vec2& uvMin, const glm::vec2& uvMax)
+{
+	atlasUVMin = uvMin;
+	atlasUVMax = uvMax;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the bottom left corner and the size of the sprite sheet in its texture, for Shader/Scene2DSprite.vs
+
+param atlas - the bottom left corner in x and y, and the size in z and w
+
+\exception None
+\return None
+*/
+/******************************************************************************/
+void CSpriteAnimation::GetAtlasRegion(glm::vec4& atlas) const
+{
+	atlas = glm::vec4(atlasUVMin, atlasUVMax - atlasUVMin);
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get a clip set which AddAnimation can add to, creating it if needed
+
+\exception None
+\return The clip set, or NULL if this sprite uses a shared clip set
+*/
+/******************************************************************************/
+CAnimationClipSet* CSpriteAnimation::GetOwnClipSet()
+{
+	if (ownClipSet != NULL)
+		return ownClipSet;
+
+	//A shared clip set must not be changed, as other sprites are using it
+	if (clipSet != NULL)
+		return NULL;
+
+	ownClipSet = new CAnimationClipSet();
+	clipSet = ownClipSet;
+	return ownClipSet;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the time within the current play of the animation
+
+\exception None
+\return The time from the start of the current play
+*/
+/******************************************************************************/
+float CSpriteAnimation::GetPlayTime() const
+{
+	//Once the last play has ended, stay at the last frame
+	if ((repeatCount >= 0) && (currentTime >= animTime * (repeatCount + 1)))
+		return animTime;
+	return fmod(currentTime, animTime);
+}
+
+/******************************************************************************/
+/*!
+\brief
+Work out the current frame from the current time
+
+\exception None
+\return None
+*/
+/******************************************************************************/
+void CSpriteAnimation::UpdateFrame() const
+{
+	frameDirty = false;
+
+	const CAnimationClip* clip = (clipSet != NULL) ? clipSet->GetClip(currentAnimation) : NULL;
+	if ((clip == NULL) || (clip->frames.empty()))
+		return;
+
+	//Get the number of frame to get the frame per second
+	const int numFrame = (int)clip->frames.size();
+	if (animTime <= 0.0f)
+	{
+		currentFrame = clip->frames[0];
+		return;
+	}
+
+	//Set the current frame based on the current time
+	const float frameTime = animTime / numFrame;
+	const int index = static_cast<int>(GetPlayTime() / frameTime);
+	currentFrame = clip->frames[(index < numFrame - 1) ? index : numFrame - 1];
+}
+
+/******************************************************************************/
+/*!
+\brief
+Let the vertex shader select the frame. The mesh is then a single quad which
+covers the whole sprite sheet, and it must be drawn with Shader/Scene2DSprite.vs.
+
+param gpuFrameSelection - true if the vertex shader selects the frame
+
+\exception None
+\return None
+*/
+/******************************************************************************/
+void CSpriteAnimation::SetGPUFrameSelection(bool gpuFrameSelection)
+{
+	this->gpuFrameSelection = gpuFrameSelection;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Check if the vertex shader selects the frame
+
+\exception None
+\return true if the vertex shader selects the frame
+*/
+/******************************************************************************/
+bool CSpriteAnimation::IsGPUFrameSelection() const
+{
+	return gpuFrameSelection;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the attributes which Shader/Scene2DSprite.vs selects the current frame with.
+A clip with consecutive frames is passed as its first frame and the time, so the
+current frame is never worked out on the CPU. Other clips pass the current frame.
+
+param sheet - the first frame, the number of frames, the columns and the rows
+
+param time - the time within the current play, and the time of each frame
+
+\exception None
+\return None
+*/
+/******************************************************************************/
+void CSpriteAnimation::GetFrameSelection(glm::vec4& sheet, glm::vec2& time) const
+{
+	sheet = glm::vec4(0.0f, 1.0f, (float)col, (float)row);
+	time = glm::vec2(0.0f);
+
+	const CAnimationClip* clip = (clipSet != NULL) ? clipSet->GetClip(currentAnimation) : NULL;
+	if ((clip == NULL) || (clip->frames.empty()))
+		return;
+
+	if ((!clip->contiguous) || (animTime <= 0.0f))
+	{
+		sheet.x = (float)GetCurrentFrame();
+		return;
+	}
+
+	sheet.x = (float)clip->frames[0];
+	sheet.y = (float)clip->frames.size();
+	time = glm::vec2(GetPlayTime(), animTime / clip->frames.size());
+}
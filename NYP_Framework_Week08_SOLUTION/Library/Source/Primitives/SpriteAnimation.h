@@ -5,8 +5,10 @@
 \par	email: 
 \brief
 Sprite Animation that hold different classes 
--Animation Class - Managed frames and name of the animation
--Sprite Animation - Managed various animations of the sprite  
+-Animation Clip - The name and frames of an animation, which never change once added
+-Animation Clip Set - The clips of a sprite sheet, which many sprites can share
+-Sprite Animation - Plays the clips of its clip set, and works out the current frame
+ only when it is needed
 */
 /******************************************************************************/
 #pragma once
@@ -17,83 +19,147 @@ Sprite Animation that hold different classes
 #include <stdarg.h>
 #include <math.h>
 
-struct CAnimation
+//The name and frames of an animation
+struct CAnimationClip
 {
-	//Constructor
-	CAnimation():repeatCount(0),
-		animTime(0.0f),
-		ended(false),
-		animActive(false)
-	{
-	}
-
-	//repeat count, total animation time, 
-	void Set(int repeat, float time, bool active)
-	{
-		this->repeatCount = repeat;
-		this->animTime = time;
-		this->animActive = active;
-	}
-
-	//Adding frames to the frame vector
-	void AddFrame(int i)
-	{
-		frames.push_back(i);
-	}
-
-private:
 	//name of the animation
 	std::string animationName;
 
 	//The frames
 	std::vector<int> frames;
 
-	//How many times to repeat
-	int repeatCount;
-	//The animation time
-	float animTime;
-	//Has the animation ended
-	bool ended;
-	//Is the animation active
-	bool animActive;
+	//Are the frames consecutive, so that the vertex shader can select them from the first frame
+	bool contiguous;
+};
 
-	//Allow the Sprite Animation class to use private variable
-	friend class CSpriteAnimation;
+//The animation clips of a sprite sheet, looked up by an integer handle.
+//A clip set can be shared by many sprites with SetClipSet, so it must not be changed after it is shared.
+class CAnimationClipSet
+{
+public:
+	CAnimationClipSet();
+	~CAnimationClipSet();
+
+	//Add a clip with the frames from start to end, excluding end, and return its handle
+	int AddClip(const std::string& name, int start, int end);
+	//Add a clip with the given frames, and return its handle
+	int AddClip(const std::string& name, const std::vector<int>& frames);
+
+	//Get the handle of a clip, or -1 if there is no clip with that name
+	int GetClipHandle(const std::string& name) const;
+	//Get a clip, or NULL if the handle is not valid
+	const CAnimationClip* GetClip(int handle) const;
+	//Get the number of clips
+	int GetNumClips() const;
+
+private:
+	//Check if the frames follow one another in the sprite sheet
+	static bool IsContiguous(const std::vector<int>& frames);
+
+	//The clips, indexed by their handles
+	std::vector<CAnimationClip> clips;
+	//The handles of the clips with their names
+	std::unordered_map<std::string, int> clipHandles;
 };
 
 //Sprite Animation that derives from Mesh for rendering
 class CSpriteAnimation : public CMesh
 {
 public:
+	//The attribute locations in Shader/Scene2DSprite.vs. The transform is a mat4, which uses 4 locations.
+	static const unsigned int SPRITE_TRANSFORM_LOCATION = 3;
+	static const unsigned int SPRITE_SHEET_LOCATION = 7;
+	static const unsigned int SPRITE_TIME_LOCATION = 8;
+	static const unsigned int SPRITE_ATLAS_LOCATION = 9;
+
 	CSpriteAnimation(int row, int col);
+	//Use buffers which are shared with other sprites
+	CSpriteAnimation(int row, int col, unsigned vertexBuffer, unsigned indexBuffer, unsigned indexSize);
 	~CSpriteAnimation();
 
 	//Update the animated sprite
 	void Update(double dt);
+	//Update many animated sprites and work out their current frames in one pass
+	static void UpdateBatch(CSpriteAnimation* const* sprites, unsigned int count, double dt);
 	virtual void Render();
 
-	void AddAnimation(std::string name, int start, int end);
-	void AddSequeneAnimation(std::string name, int count ...);
+	//Use a clip set which is shared with other sprites. It is not deleted by this sprite.
+	void SetClipSet(const CAnimationClipSet* clipSet);
+	//Get the clip set of this sprite
+	const CAnimationClipSet* GetClipSet() const;
+
+	int AddAnimation(std::string name, int start, int end);
+	int AddSequeneAnimation(std::string name, int count ...);
+	void PlayAnimation(int handle, int repeat, float time);
 	void PlayAnimation(std::string name, int repeat, float time);
 	void Pause();
 	void Resume();
 	void Reset();
 
+	//Get the current frame in the sprite sheet
+	int GetCurrentFrame() const;
+
+	//Let the vertex shader select the frame, so that the mesh is a single quad
+	void SetGPUFrameSelection(bool gpuFrameSelection);
+	//Check if the vertex shader selects the frame
+	bool IsGPUFrameSelection() const;
+	//Get the attributes which Shader/Scene2DSprite.vs selects the current frame with
+	void GetFrameSelection(glm::vec4& sheet, glm::vec2& time) const;
+
+	//Set the size of a frame, which is the size of the quad that it is drawn on
+	void SetFrameSize(float width, float height);
+	//Get the size of a frame
+	glm::vec2 GetFrameSize() const;
+	//Get the texture coordinates of the current frame in the sprite sheet, or in the texture atlas
+	void GetFrameUV(glm::vec2& uvMin, glm::vec2& uvMax) const;
+
+	//Set where the sprite sheet is in a texture atlas. The whole texture is used by default.
+	void SetAtlasRegion(const glm::vec2& uvMin, const glm::vec2& uvMax);
+	//Get the bottom left corner and the size of the sprite sheet in the texture, for Shader/Scene2DSprite.vs
+	void GetAtlasRegion(glm::vec4& atlas) const;
+
 private:
 	//number of rows
 	int row;
 	//number of columns 
 	int col;
 
-	//the current time of the animation
+	//the size of a frame
+	float frameWidth;
+	float frameHeight;
+
+	//the current time of the animation, from the start of its first play
 	float currentTime;
-	//the current frame of the animation
-	int currentFrame;
-	//How many time it has play
-	int playCount;
-
-	//The name of the current animation
-	std::string currentAnimation;
-	//The list of the animations with their names
-	std::unordered_map<std::string, CAnimation*> animationList;
+	//the current frame of the animation, which is worked out when it is needed
+	mutable int currentFrame;
+	//Has currentTime or the current animation changed since currentFrame was worked out
+	mutable bool frameDirty;
+
+	//The handle of the current animation
+	int currentAnimation;
+	//How many times to repeat (-1 for infinite looping)
+	int repeatCount;
+	//The animation time
+	float animTime;
+	//Is the animation active
+	bool animActive;
+
+	//Does the vertex shader select the frame
+	bool gpuFrameSelection;
+
+	//The texture coordinates of the bottom left and top right corners of the sprite sheet in its texture
+	glm::vec2 atlasUVMin;
+	glm::vec2 atlasUVMax;
+
+	//The clips which this sprite plays
+	const CAnimationClipSet* clipSet;
+	//The clip set which was created by AddAnimation, and is deleted by this sprite
+	CAnimationClipSet* ownClipSet;
+
+	//Get a clip set which AddAnimation can add to
+	CAnimationClipSet* GetOwnClipSet();
+	//Get the time within the current play of the animation
+	float GetPlayTime() const;
+	//Work out the current frame from the current time
+	void UpdateFrame() const;
 };
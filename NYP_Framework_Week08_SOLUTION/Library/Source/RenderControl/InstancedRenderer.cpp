@@ -0,0 +1,222 @@
+/**
+ CInstancedRenderer
+ */
+#include "InstancedRenderer.h"
+
+// Include ShaderManager
+#include "ShaderManager.h"
+
+#include <iostream>
+
+/**
+ @brief Constructor
+ */
+CInstancedRenderer::CInstancedRenderer(void)
+	: cStreamingBuffer(NULL)
+	, sShaderName("InstancingShader")
+	, view(glm::mat4(1.0f))
+	, projection(glm::mat4(1.0f))
+	, bFrustumCulling(true)
+	, uiNumDrawCalls(0)
+	, uiNumInstances(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CInstancedRenderer::~CInstancedRenderer(void)
+{
+	// We won't delete this since it was created elsewhere
+	cStreamingBuffer = NULL;
+}
+
+/**
+ @brief Initialise this instance. Requires a valid OpenGL context, and the shader set by SetShader
+		to have been added to the CShaderManager.
+ @return true if the initialisation is successful, else false
+ */
+bool CInstancedRenderer::Init(void)
+{
+	if (CShaderManager::GetInstance()->Check(sShaderName) == false)
+	{
+		std::cout << "CInstancedRenderer: the shader " << sShaderName << " has not been added to the CShaderManager" << std::endl;
+		return false;
+	}
+
+	cStreamingBuffer = CStreamingBuffer::GetInstance();
+
+	return cStreamingBuffer != NULL;
+}
+
+/**
+ @brief Set the name of the shader to be used. It must declare aInstanceMatrix at location 3.
+ @param _name The name of the Shader instance in the CShaderManager
+ */
+void CInstancedRenderer::SetShader(const std::string& _name)
+{
+	this->sShaderName = _name;
+}
+
+/**
+ @brief Start a new frame
+ @param view A const glm::mat4& containing the view matrix of the camera
+ @param projection A const glm::mat4& containing the projection matrix of the camera
+ */
+void CInstancedRenderer::Begin(const glm::mat4& view, const glm::mat4& projection)
+{
+	this->view = view;
+	this->projection = projection;
+
+	cFrustum.Update(view, projection);
+	cFrustum.ResetCounters();
+
+	std::map<SBatchKey, std::vector<glm::mat4> >::iterator it;
+	for (it = mapBatches.begin(); it != mapBatches.end(); ++it)
+		it->second.clear();
+}
+
+/**
+ @brief Add an entity to be drawn in this frame. Entities with the same mesh and texture are drawn together.
+		Entities whose colliders are outside the camera's view are skipped.
+ @param cEntity3D A const CEntity3D* which is to be drawn
+ */
+void CInstancedRenderer::Submit(const CEntity3D* cEntity3D)
+{
+	if ((bFrustumCulling) && (cEntity3D->IsVisible(cFrustum) == false))
+		return;
+
+	Submit(cEntity3D->GetVAO(), cEntity3D->GetIndexBufferSize(), cEntity3D->GetTextureID(),
+		   cEntity3D->GetModelMatrix());
+}
+
+/**
+ @brief Add a mesh to be drawn in this frame with a model matrix
+ @param VAO A const GLuint containing the vertex array object of the mesh
+ @param index_buffer_size A const GLuint containing the number of indices of the mesh
+ @param iTextureID A const GLuint containing the texture of the mesh
+ @param model A const glm::mat4& containing the model matrix of this instance
+ */
+void CInstancedRenderer::Submit(const GLuint VAO, const GLuint index_buffer_size, const GLuint iTextureID,
+								const glm::mat4& model)
+{
+	if ((VAO == 0) || (index_buffer_size == 0))
+		return;
+
+	SBatchKey sKey;
+	sKey.VAO = VAO;
+	sKey.index_buffer_size = index_buffer_size;
+	sKey.iTextureID = iTextureID;
+	mapBatches[sKey].push_back(model);
+}
+
+/**
+ @brief Draw all the entities which were submitted in this frame, with one draw call per mesh and texture
+ */
+void CInstancedRenderer::Render(void)
+{
+	uiNumDrawCalls = 0;
+	uiNumInstances = 0;
+
+	if ((cStreamingBuffer == NULL) && (Init() == false))
+		return;
+
+	// Gather the model matrices of all the batches, so that they are uploaded in one go
+	vInstanceMatrices.clear();
+	std::map<SBatchKey, std::vector<glm::mat4> >::iterator it;
+	for (it = mapBatches.begin(); it != mapBatches.end(); ++it)
+		vInstanceMatrices.insert(vInstanceMatrices.end(), it->second.begin(), it->second.end());
+	if (vInstanceMatrices.empty())
+		return;
+
+	// Upload the matrices into this frame's part of the streaming buffer
+	CStreamingBuffer::SAllocation sAllocation = cStreamingBuffer->Upload(&vInstanceMatrices[0],
+																		 vInstanceMatrices.size() * sizeof(glm::mat4));
+	if (sAllocation.buffer == 0)
+		return;
+	glBindBuffer(GL_ARRAY_BUFFER, sAllocation.buffer);
+
+	CShaderManager::GetInstance()->Use(sShaderName);
+	CShaderManager::GetInstance()->activeShader->setMat4("view", view);
+	CShaderManager::GetInstance()->activeShader->setMat4("projection", projection);
+	CShaderManager::GetInstance()->activeShader->setInt("texture_diffuse1", 0);
+	glActiveTexture(GL_TEXTURE0);
+
+	size_t uiFirstInstance = 0;
+	for (it = mapBatches.begin(); it != mapBatches.end(); ++it)
+	{
+		if (it->second.empty())
+			continue;
+
+		glBindTexture(GL_TEXTURE_2D, it->first.iTextureID);
+		glBindVertexArray(it->first.VAO);
+
+		// Point aInstanceMatrix at this batch's matrices. A mat4 attribute takes 4 vec4 locations.
+		for (GLuint i = 0; i < 4; i++)
+		{
+			glEnableVertexAttribArray(INSTANCE_MATRIX_LOCATION + i);
+			glVertexAttribPointer(	INSTANCE_MATRIX_LOCATION + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+									(void*)(sAllocation.offset + uiFirstInstance * sizeof(glm::mat4) + i * sizeof(glm::vec4)));
+			glVertexAttribDivisor(INSTANCE_MATRIX_LOCATION + i, 1);
+		}
+
+		glDrawElementsInstanced(GL_TRIANGLES, it->first.index_buffer_size, GL_UNSIGNED_INT, 0,
+								(GLsizei)it->second.size());
+
+		// Leave the VAO as it was, so that it can still be drawn without instancing
+		for (GLuint i = 0; i < 4; i++)
+		{
+			glVertexAttribDivisor(INSTANCE_MATRIX_LOCATION + i, 0);
+			glDisableVertexAttribArray(INSTANCE_MATRIX_LOCATION + i);
+		}
+
+		uiFirstInstance += it->second.size();
+		uiNumDrawCalls++;
+		uiNumInstances += (unsigned int)it->second.size();
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/**
+ @brief Forget all meshes, e.g. when changing scenes
+ */
+void CInstancedRenderer::Clear(void)
+{
+	mapBatches.clear();
+	vInstanceMatrices.clear();
+}
+
+/**
+ @brief Get the number of draw calls in the last frame
+ */
+unsigned int CInstancedRenderer::GetNumDrawCalls(void) const
+{
+	return uiNumDrawCalls;
+}
+
+/**
+ @brief Get the number of instances drawn in the last frame
+ */
+unsigned int CInstancedRenderer::GetNumInstances(void) const
+{
+	return uiNumInstances;
+}
+
+/**
+ @brief Enable or disable frustum culling
+ @param bFrustumCulling A const bool which is true if entities outside the camera's view are not to be drawn
+ */
+void CInstancedRenderer::SetFrustumCulling(const bool bFrustumCulling)
+{
+	this->bFrustumCulling = bFrustumCulling;
+}
+
+/**
+ @brief Get the frustum of this frame. Its counters hold the number of visible and culled entities.
+ */
+const CFrustum& CInstancedRenderer::GetFrustum(void) const
+{
+	return cFrustum;
+}
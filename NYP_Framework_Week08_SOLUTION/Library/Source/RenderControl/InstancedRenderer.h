@@ -0,0 +1,127 @@
+/**
+ CInstancedRenderer
+
+ Draws CEntity3D instances which share a mesh and a texture with one glDrawElementsInstanced call.
+ The model matrices are uploaded into an instance buffer once per frame, and read by
+ Shader/Instancing.vs through aInstanceMatrix at locations 3 to 6.
+ Entities whose colliders are outside the camera's view are culled in Submit.
+
+ The shader is not loaded here. Add it to the CShaderManager before Init, e.g.
+	CShaderManager::GetInstance()->Add("InstancingShader", "Shader//Instancing.vs", "Shader//Instancing.fs");
+ or pass the name of another shader with aInstanceMatrix to SetShader.
+
+ Usage, every frame:
+	cInstancedRenderer->Begin(view, projection);
+	cInstancedRenderer->Submit(cEntity3D);	// for each entity to draw
+	cInstancedRenderer->Render();
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include CEntity3D
+#include "../Primitives/Entity3D.h"
+
+// Include CFrustum
+#include "../Primitives/Frustum.h"
+
+// Include CStreamingBuffer
+#include "StreamingBuffer.h"
+
+#include <string>
+#include <vector>
+#include <map>
+
+class CInstancedRenderer : public CSingletonTemplate<CInstancedRenderer>
+{
+	friend CSingletonTemplate<CInstancedRenderer>;
+public:
+	// The attribute location of aInstanceMatrix in Instancing.vs. A mat4 uses 4 locations.
+	static const GLuint INSTANCE_MATRIX_LOCATION = 3;
+
+	// Init. The shader must have been added to the CShaderManager.
+	bool Init(void);
+
+	// Set the name of the shader which has aInstanceMatrix
+	void SetShader(const std::string& _name);
+
+	// Start a new frame
+	void Begin(const glm::mat4& view, const glm::mat4& projection);
+	// Add an entity to be drawn in this frame, unless it is culled
+	void Submit(const CEntity3D* cEntity3D);
+	// Add a mesh to be drawn in this frame with a model matrix
+	void Submit(const GLuint VAO, const GLuint index_buffer_size, const GLuint iTextureID, const glm::mat4& model);
+	// Draw all the entities which were submitted in this frame
+	void Render(void);
+
+	// Forget all meshes, e.g. when changing scenes
+	void Clear(void);
+
+	// Get the number of draw calls in the last frame
+	unsigned int GetNumDrawCalls(void) const;
+	// Get the number of instances drawn in the last frame
+	unsigned int GetNumInstances(void) const;
+
+	// Enable or disable frustum culling
+	void SetFrustumCulling(const bool bFrustumCulling);
+	// Get the frustum of this frame, which also counts the visible and culled entities
+	const CFrustum& GetFrustum(void) const;
+
+protected:
+	// The entities which share a mesh and a texture
+	struct SBatchKey
+	{
+		GLuint VAO;
+		GLuint index_buffer_size;
+		GLuint iTextureID;
+
+		bool operator<(const SBatchKey& other) const
+		{
+			if (VAO != other.VAO)
+				return VAO < other.VAO;
+			if (index_buffer_size != other.index_buffer_size)
+				return index_buffer_size < other.index_buffer_size;
+			return iTextureID < other.iTextureID;
+		}
+	};
+
+	// The model matrices of each batch. The vectors are kept between frames to reuse their memory.
+	std::map<SBatchKey, std::vector<glm::mat4> > mapBatches;
+	// All the model matrices of this frame, in the order that they are uploaded
+	std::vector<glm::mat4> vInstanceMatrices;
+
+	// The buffer which the model matrices are uploaded to every frame
+	CStreamingBuffer* cStreamingBuffer;
+
+	// Name of Shader Program instance
+	std::string sShaderName;
+
+	// The camera of this frame
+	glm::mat4 view;
+	glm::mat4 projection;
+
+	// The view volume of the camera
+	CFrustum cFrustum;
+	// True if entities outside cFrustum are not drawn
+	bool bFrustumCulling;
+
+	// Statistics of the last frame
+	unsigned int uiNumDrawCalls;
+	unsigned int uiNumInstances;
+
+	// Constructor
+	CInstancedRenderer(void);
+
+	// Destructor
+	virtual ~CInstancedRenderer(void);
+};
@@ -1,6 +1,9 @@
 #include "ShaderManager.h"
 #include <stdexcept>      // std::invalid_argument
 
+// Include CProfiler
+#include "../TimeControl/Profiler.h"
+
 /**
 @brief Constructor
 */
@@ -101,10 +104,12 @@ void CShaderManager::Add(	const std::string& _name,
 							const char* fragmentPath, 
 							const char* geometryPath)
 {
+	PROFILE_SCOPE("ShaderManager::Add");
+
 	if (Check(_name))
 	{
 		// Scene Exist, unable to proceed
-		throw std::exception("Duplicate shader name provided");
+		throw std::runtime_error("Duplicate shader name provided");
 	}
 
 	CShader* cNewShader = new CShader(vertexPath, fragmentPath);
@@ -125,7 +130,7 @@ void CShaderManager::Remove(const std::string& _name)
 	CShader* target = shaderMap[_name];
 	if (target == activeShader)
 	{
-		throw std::exception("Unable to remove active Shader");
+		throw std::runtime_error("Unable to remove active Shader");
 	}
 
 	// Delete and remove from our map
@@ -141,7 +146,7 @@ void CShaderManager::Use(const std::string& _name)
 	if (!Check(_name))
 	{
 		// Scene does not exist
-		throw std::exception("Shader does not exist");
+		throw std::runtime_error("Shader does not exist");
 	}
 
 	// if Shader exist, set the activeShader pointer to that Shader
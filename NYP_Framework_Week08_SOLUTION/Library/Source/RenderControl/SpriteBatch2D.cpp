@@ -0,0 +1,264 @@
+/**
+ CSpriteBatch2D
+ */
+#include "SpriteBatch2D.h"
+
+// Include ShaderManager
+#include "ShaderManager.h"
+
+#include <algorithm>
+
+/**
+ @brief Constructor
+ */
+CSpriteBatch2D::CSpriteBatch2D(void)
+	: VAO(0)
+	, IBO(0)
+	, uiCapacity(0)
+	, sShaderName("2DColorShader")
+	, uiNumDrawCalls(0)
+	, uiNumSprites(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CSpriteBatch2D::~CSpriteBatch2D(void)
+{
+	if (VAO != 0)
+		glDeleteVertexArrays(1, &VAO);
+	if (IBO != 0)
+		glDeleteBuffers(1, &IBO);
+	VAO = IBO = 0;
+}
+
+/**
+ @brief Initialise this instance. Requires a valid OpenGL context.
+ @return true if the initialisation is successful, else false
+ */
+bool CSpriteBatch2D::Init(void)
+{
+	if (VAO != 0)
+		return true;
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &IBO);
+
+	// The vertex attributes are pointed at this frame's vertices in Render
+	glBindVertexArray(VAO);
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+	glEnableVertexAttribArray(2);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+	glBindVertexArray(0);
+
+	Reserve(64);
+
+	return VAO != 0;
+}
+
+/**
+ @brief Set the name of the shader to be used. It must have the same inputs as Scene2DColor.vs.
+ @param _name The name of the Shader instance in the CShaderManager
+ */
+void CSpriteBatch2D::SetShader(const std::string& _name)
+{
+	this->sShaderName = _name;
+}
+
+/**
+ @brief Start a new frame
+ */
+void CSpriteBatch2D::Begin(void)
+{
+	vSprites.clear();
+}
+
+/**
+ @brief Add the current frame of an animated sprite to be drawn in this frame
+ @param iTextureID A const GLuint containing the sprite sheet of the sprite
+ @param cSpriteAnimation A const CSpriteAnimation* containing the frame to draw
+ @param transform A const glm::mat4& containing the transform of the sprite
+ @param color A const glm::vec4& containing the colour which the texture is multiplied by
+ */
+void CSpriteBatch2D::Submit(const GLuint iTextureID, const CSpriteAnimation* cSpriteAnimation,
+							const glm::mat4& transform, const glm::vec4& color)
+{
+	if (cSpriteAnimation == NULL)
+		return;
+
+	glm::vec2 vec2UVMin, vec2UVMax;
+	cSpriteAnimation->GetFrameUV(vec2UVMin, vec2UVMax);
+	Submit(iTextureID, cSpriteAnimation->GetFrameSize(), vec2UVMin, vec2UVMax, transform, color);
+}
+
+/**
+ @brief Add a part of a texture to be drawn on a quad in this frame. The quad is centred on the origin.
+ @param iTextureID A const GLuint containing the texture
+ @param vec2Size A const glm::vec2& containing the width and height of the quad
+ @param vec2UVMin A const glm::vec2& containing the bottom left texture coordinate
+ @param vec2UVMax A const glm::vec2& containing the top right texture coordinate
+ @param transform A const glm::mat4& containing the transform of the quad
+ @param color A const glm::vec4& containing the colour which the texture is multiplied by
+ */
+void CSpriteBatch2D::Submit(const GLuint iTextureID, const glm::vec2& vec2Size,
+							const glm::vec2& vec2UVMin, const glm::vec2& vec2UVMax,
+							const glm::mat4& transform, const glm::vec4& color)
+{
+	const glm::vec2 vec2Half = vec2Size * 0.5f;
+
+	SSprite sSprite;
+	sSprite.iTextureID = iTextureID;
+	sSprite.arrCorners[0] = glm::vec3(transform * glm::vec4(-vec2Half.x, -vec2Half.y, 0.0f, 1.0f));
+	sSprite.arrCorners[1] = glm::vec3(transform * glm::vec4( vec2Half.x, -vec2Half.y, 0.0f, 1.0f));
+	sSprite.arrCorners[2] = glm::vec3(transform * glm::vec4( vec2Half.x,  vec2Half.y, 0.0f, 1.0f));
+	sSprite.arrCorners[3] = glm::vec3(transform * glm::vec4(-vec2Half.x,  vec2Half.y, 0.0f, 1.0f));
+	sSprite.vec2UVMin = vec2UVMin;
+	sSprite.vec2UVMax = vec2UVMax;
+	sSprite.color = color;
+	vSprites.push_back(sSprite);
+}
+
+/**
+ @brief Draw all the sprites which were submitted in this frame, with one draw call per texture
+ */
+void CSpriteBatch2D::Render(void)
+{
+	uiNumDrawCalls = 0;
+	uiNumSprites = 0;
+
+	if (vSprites.empty())
+		return;
+	if (Init() == false)
+		return;
+
+	// Sort by texture. The sort is stable, so sprites with the same texture keep their order.
+	vOrder.resize(vSprites.size());
+	for (unsigned int i = 0; i < vOrder.size(); i++)
+		vOrder[i] = i;
+	std::stable_sort(vOrder.begin(), vOrder.end(), [this](const unsigned int a, const unsigned int b)
+	{
+		return vSprites[a].iTextureID < vSprites[b].iTextureID;
+	});
+
+	// Build the vertices in the sorted order
+	vVertices.resize(vSprites.size() * 4);
+	for (unsigned int i = 0; i < vOrder.size(); i++)
+	{
+		const SSprite& sSprite = vSprites[vOrder[i]];
+		Vertex* pVertex = &vVertices[i * 4];
+
+		pVertex[0].position = sSprite.arrCorners[0];
+		pVertex[0].texCoord = sSprite.vec2UVMin;
+		pVertex[1].position = sSprite.arrCorners[1];
+		pVertex[1].texCoord = glm::vec2(sSprite.vec2UVMax.x, sSprite.vec2UVMin.y);
+		pVertex[2].position = sSprite.arrCorners[2];
+		pVertex[2].texCoord = sSprite.vec2UVMax;
+		pVertex[3].position = sSprite.arrCorners[3];
+		pVertex[3].texCoord = glm::vec2(sSprite.vec2UVMin.x, sSprite.vec2UVMax.y);
+		for (int j = 0; j < 4; j++)
+			pVertex[j].color = sSprite.color;
+	}
+
+	// Upload the vertices into this frame's part of the streaming buffer
+	Reserve((unsigned int)vSprites.size());
+	CStreamingBuffer::SAllocation sAllocation = CStreamingBuffer::GetInstance()->Upload(&vVertices[0],
+																	vVertices.size() * sizeof(Vertex));
+	if (sAllocation.buffer == 0)
+		return;
+
+	// The transform and colour are already applied to the vertices
+	CShaderManager::GetInstance()->Use(sShaderName);
+	CShaderManager::GetInstance()->activeShader->setMat4("transform", glm::mat4(1.0f));
+	CShaderManager::GetInstance()->activeShader->setVec4("runtime_color", glm::vec4(1.0f));
+	CShaderManager::GetInstance()->activeShader->setInt("texture1", 0);
+	glActiveTexture(GL_TEXTURE0);
+
+	// Activate blending mode
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, sAllocation.buffer);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sAllocation.offset);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sAllocation.offset + sizeof(glm::vec3)));
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+						  (void*)(sAllocation.offset + sizeof(glm::vec3) + sizeof(glm::vec4)));
+
+	// Draw each run of sprites with the same texture
+	unsigned int uiFirst = 0;
+	while (uiFirst < vOrder.size())
+	{
+		const GLuint iTextureID = vSprites[vOrder[uiFirst]].iTextureID;
+		unsigned int uiLast = uiFirst + 1;
+		while ((uiLast < vOrder.size()) && (vSprites[vOrder[uiLast]].iTextureID == iTextureID))
+			uiLast++;
+
+		glBindTexture(GL_TEXTURE_2D, iTextureID);
+		glDrawElements(GL_TRIANGLES, (uiLast - uiFirst) * 6, GL_UNSIGNED_INT, (void*)(uiFirst * 6 * sizeof(GLuint)));
+
+		uiNumDrawCalls++;
+		uiFirst = uiLast;
+	}
+	uiNumSprites = (unsigned int)vSprites.size();
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// Disable blending
+	glDisable(GL_BLEND);
+}
+
+/**
+ @brief Get the number of draw calls in the last frame
+ */
+unsigned int CSpriteBatch2D::GetNumDrawCalls(void) const
+{
+	return uiNumDrawCalls;
+}
+
+/**
+ @brief Get the number of sprites drawn in the last frame
+ */
+unsigned int CSpriteBatch2D::GetNumSprites(void) const
+{
+	return uiNumSprites;
+}
+
+/**
+ @brief Make sure that IBO can hold a number of sprites. The indices of every
+		sprite follow the same pattern, so IBO is only rebuilt when the capacity grows.
+ @param uiNumSprites A const unsigned int containing the number of sprites
+ */
+void CSpriteBatch2D::Reserve(const unsigned int uiNumSprites)
+{
+	if (uiNumSprites <= uiCapacity)
+		return;
+
+	// Grow geometrically, so that a growing scene does not rebuild IBO every frame
+	unsigned int uiNewCapacity = (uiCapacity > 0) ? uiCapacity * 2 : 64;
+	while (uiNewCapacity < uiNumSprites)
+		uiNewCapacity *= 2;
+
+	// The same winding as CMeshBuilder::GenerateSpriteAnimation
+	std::vector<GLuint> vIndices(uiNewCapacity * 6);
+	for (unsigned int i = 0; i < uiNewCapacity; i++)
+	{
+		const GLuint offset = i * 4;
+		vIndices[i * 6 + 0] = offset + 3;
+		vIndices[i * 6 + 1] = offset + 0;
+		vIndices[i * 6 + 2] = offset + 2;
+		vIndices[i * 6 + 3] = offset + 1;
+		vIndices[i * 6 + 4] = offset + 2;
+		vIndices[i * 6 + 5] = offset + 0;
+	}
+
+	// IBO is part of the VAO's state, so bind the VAO before replacing its contents
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, vIndices.size() * sizeof(GLuint), &vIndices[0], GL_STATIC_DRAW);
+	glBindVertexArray(0);
+
+	uiCapacity = uiNewCapacity;
+}
@@ -0,0 +1,105 @@
+/**
+ CSpriteBatch2D
+
+ Draws the animated sprites of the 2D entities with as few draw calls as possible.
+ Each submitted sprite is transformed on the CPU into 4 vertices, which hold its colour and
+ the texture coordinates of its current frame. At the end of the frame, the sprites are sorted
+ by texture, all the vertices are streamed into CStreamingBuffer, and each texture is drawn
+ with a single glDrawElements call. Sprites with the same texture keep their submission order.
+ The vertices use the same layout as CMesh, so Shader/Scene2DColor.vs is used as-is.
+
+ Usage, every frame:
+	cSpriteBatch2D->Begin();
+	cSpriteBatch2D->Submit(iTextureID, animatedSprites, transform, currentColor);	// for each sprite
+	cSpriteBatch2D->Render();
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include CSpriteAnimation
+#include "../Primitives/SpriteAnimation.h"
+
+// Include CStreamingBuffer
+#include "StreamingBuffer.h"
+
+#include <string>
+#include <vector>
+
+class CSpriteBatch2D : public CSingletonTemplate<CSpriteBatch2D>
+{
+	friend CSingletonTemplate<CSpriteBatch2D>;
+public:
+	// Init
+	bool Init(void);
+
+	// Set the name of the shader to be used
+	void SetShader(const std::string& _name);
+
+	// Start a new frame
+	void Begin(void);
+	// Add the current frame of an animated sprite to be drawn in this frame
+	void Submit(const GLuint iTextureID, const CSpriteAnimation* cSpriteAnimation,
+				const glm::mat4& transform, const glm::vec4& color);
+	// Add a part of a texture to be drawn on a quad in this frame
+	void Submit(const GLuint iTextureID, const glm::vec2& vec2Size,
+				const glm::vec2& vec2UVMin, const glm::vec2& vec2UVMax,
+				const glm::mat4& transform, const glm::vec4& color);
+	// Draw all the sprites which were submitted in this frame
+	void Render(void);
+
+	// Get the number of draw calls in the last frame
+	unsigned int GetNumDrawCalls(void) const;
+	// Get the number of sprites drawn in the last frame
+	unsigned int GetNumSprites(void) const;
+
+protected:
+	// A sprite which was submitted in this frame
+	struct SSprite
+	{
+		GLuint iTextureID;
+		// The corners of the quad, in the order bottom left, bottom right, top right, top left
+		glm::vec3 arrCorners[4];
+		glm::vec2 vec2UVMin;
+		glm::vec2 vec2UVMax;
+		glm::vec4 color;
+	};
+
+	// The sprites of this frame in submission order
+	std::vector<SSprite> vSprites;
+	// The indices into vSprites, sorted by texture
+	std::vector<unsigned int> vOrder;
+	// The vertices of this frame. The vectors are kept between frames to reuse their memory.
+	std::vector<Vertex> vVertices;
+
+	// OpenGL objects. The vertices are uploaded to CStreamingBuffer.
+	GLuint VAO, IBO;
+	// The number of sprites which IBO can hold
+	unsigned int uiCapacity;
+
+	// Name of Shader Program instance
+	std::string sShaderName;
+
+	// Statistics of the last frame
+	unsigned int uiNumDrawCalls;
+	unsigned int uiNumSprites;
+
+	// Make sure that IBO can hold uiNumSprites sprites
+	void Reserve(const unsigned int uiNumSprites);
+
+	// Constructor
+	CSpriteBatch2D(void);
+
+	// Destructor
+	virtual ~CSpriteBatch2D(void);
+};
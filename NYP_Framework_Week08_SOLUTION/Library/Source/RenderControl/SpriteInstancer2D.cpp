@@ -0,0 +1,224 @@
+/**
+ CSpriteInstancer2D
+ */
+#include "SpriteInstancer2D.h"
+
+// Include ShaderManager
+#include "ShaderManager.h"
+
+// Include GLM
+#include <includes/gtc/matrix_transform.hpp>
+
+/**
+ @brief Constructor
+ */
+CSpriteInstancer2D::CSpriteInstancer2D(void)
+	: VAO(0)
+	, VBO(0)
+	, IBO(0)
+	, sShaderName("2DSpriteShader")
+	, uiNumDrawCalls(0)
+	, uiNumSprites(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CSpriteInstancer2D::~CSpriteInstancer2D(void)
+{
+	if (VAO != 0)
+		glDeleteVertexArrays(1, &VAO);
+	if (VBO != 0)
+		glDeleteBuffers(1, &VBO);
+	if (IBO != 0)
+		glDeleteBuffers(1, &IBO);
+	VAO = VBO = IBO = 0;
+}
+
+/**
+ @brief Initialise this instance. Requires a valid OpenGL context.
+ @return true if the initialisation is successful, else false
+ */
+bool CSpriteInstancer2D::Init(void)
+{
+	if (VAO != 0)
+		return true;
+
+	// A quad of 1 x 1 centred on the origin. Its texture coordinates are the position within a frame.
+	const GLfloat arrVertices[] = {
+		-0.5f, -0.5f, 0.0f,		0.0f, 0.0f,
+		 0.5f, -0.5f, 0.0f,		1.0f, 0.0f,
+		 0.5f,  0.5f, 0.0f,		1.0f, 1.0f,
+		-0.5f,  0.5f, 0.0f,		0.0f, 1.0f
+	};
+	// The same winding as CMeshBuilder::GenerateSpriteAnimation
+	const GLuint arrIndices[] = { 3, 0, 2, 1, 2, 0 };
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &IBO);
+
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(arrVertices), arrVertices, GL_STATIC_DRAW);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (void*)0);
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat)));
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(arrIndices), arrIndices, GL_STATIC_DRAW);
+
+	// The colour and the frame selection are per sprite. They are pointed at this frame's sprites in Render.
+	glEnableVertexAttribArray(1);
+	glVertexAttribDivisor(1, 1);
+	for (GLuint i = 0; i < 4; i++)
+	{
+		glEnableVertexAttribArray(CSpriteAnimation::SPRITE_TRANSFORM_LOCATION + i);
+		glVertexAttribDivisor(CSpriteAnimation::SPRITE_TRANSFORM_LOCATION + i, 1);
+	}
+	glEnableVertexAttribArray(CSpriteAnimation::SPRITE_SHEET_LOCATION);
+	glVertexAttribDivisor(CSpriteAnimation::SPRITE_SHEET_LOCATION, 1);
+	glEnableVertexAttribArray(CSpriteAnimation::SPRITE_TIME_LOCATION);
+	glVertexAttribDivisor(CSpriteAnimation::SPRITE_TIME_LOCATION, 1);
+	glEnableVertexAttribArray(CSpriteAnimation::SPRITE_ATLAS_LOCATION);
+	glVertexAttribDivisor(CSpriteAnimation::SPRITE_ATLAS_LOCATION, 1);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	return VAO != 0;
+}
+
+/**
+ @brief Set the name of the shader to be used. It must have the same inputs as Scene2DSprite.vs.
+ @param _name The name of the Shader instance in the CShaderManager
+ */
+void CSpriteInstancer2D::SetShader(const std::string& _name)
+{
+	this->sShaderName = _name;
+}
+
+/**
+ @brief Start a new frame
+ */
+void CSpriteInstancer2D::Begin(void)
+{
+	std::map<GLuint, std::vector<SInstance> >::iterator it;
+	for (it = mapBatches.begin(); it != mapBatches.end(); ++it)
+		it->second.clear();
+}
+
+/**
+ @brief Add an animated sprite to be drawn in this frame. Its current frame is selected by the vertex shader.
+ @param iTextureID A const GLuint containing the sprite sheet of the sprite
+ @param cSpriteAnimation A const CSpriteAnimation* containing the clip and time of the sprite
+ @param transform A const glm::mat4& containing the transform of the sprite
+ @param color A const glm::vec4& containing the colour which the texture is multiplied by
+ */
+void CSpriteInstancer2D::Submit(const GLuint iTextureID, const CSpriteAnimation* cSpriteAnimation,
+								const glm::mat4& transform, const glm::vec4& color)
+{
+	if (cSpriteAnimation == NULL)
+		return;
+
+	const glm::vec2 vec2Size = cSpriteAnimation->GetFrameSize();
+
+	SInstance sInstance;
+	sInstance.transform = glm::scale(transform, glm::vec3(vec2Size.x, vec2Size.y, 1.0f));
+	sInstance.color = color;
+	cSpriteAnimation->GetFrameSelection(sInstance.sheet, sInstance.time);
+	cSpriteAnimation->GetAtlasRegion(sInstance.atlas);
+	mapBatches[iTextureID].push_back(sInstance);
+}
+
+/**
+ @brief Draw all the sprites which were submitted in this frame, with one draw call per texture
+ */
+void CSpriteInstancer2D::Render(void)
+{
+	uiNumDrawCalls = 0;
+	uiNumSprites = 0;
+
+	// Gather the sprites of all the textures, so that they are uploaded in one go
+	vInstances.clear();
+	std::map<GLuint, std::vector<SInstance> >::iterator it;
+	for (it = mapBatches.begin(); it != mapBatches.end(); ++it)
+		vInstances.insert(vInstances.end(), it->second.begin(), it->second.end());
+	if (vInstances.empty())
+		return;
+	if (Init() == false)
+		return;
+
+	// Upload the sprites into this frame's part of the streaming buffer
+	CStreamingBuffer::SAllocation sAllocation = CStreamingBuffer::GetInstance()->Upload(&vInstances[0],
+																	vInstances.size() * sizeof(SInstance));
+	if (sAllocation.buffer == 0)
+		return;
+
+	// The transform of each sprite is in its attributes
+	CShaderManager::GetInstance()->Use(sShaderName);
+	CShaderManager::GetInstance()->activeShader->setMat4("transform", glm::mat4(1.0f));
+	CShaderManager::GetInstance()->activeShader->setVec4("runtime_color", glm::vec4(1.0f));
+	CShaderManager::GetInstance()->activeShader->setInt("texture1", 0);
+	glActiveTexture(GL_TEXTURE0);
+
+	// Activate blending mode
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, sAllocation.buffer);
+
+	size_t uiFirstInstance = 0;
+	for (it = mapBatches.begin(); it != mapBatches.end(); ++it)
+	{
+		if (it->second.empty())
+			continue;
+
+		// Point the per sprite attributes at this texture's sprites
+		const GLintptr offset = sAllocation.offset + uiFirstInstance * sizeof(SInstance);
+		for (GLuint i = 0; i < 4; i++)
+		{
+			glVertexAttribPointer(	CSpriteAnimation::SPRITE_TRANSFORM_LOCATION + i, 4, GL_FLOAT, GL_FALSE,
+									sizeof(SInstance), (void*)(offset + i * sizeof(glm::vec4)));
+		}
+		glVertexAttribPointer(	1, 4, GL_FLOAT, GL_FALSE, sizeof(SInstance),
+								(void*)(offset + sizeof(glm::mat4)));
+		glVertexAttribPointer(	CSpriteAnimation::SPRITE_SHEET_LOCATION, 4, GL_FLOAT, GL_FALSE, sizeof(SInstance),
+								(void*)(offset + sizeof(glm::mat4) + sizeof(glm::vec4)));
+		glVertexAttribPointer(	CSpriteAnimation::SPRITE_TIME_LOCATION, 2, GL_FLOAT, GL_FALSE, sizeof(SInstance),
+								(void*)(offset + sizeof(glm::mat4) + 2 * sizeof(glm::vec4)));
+		glVertexAttribPointer(	CSpriteAnimation::SPRITE_ATLAS_LOCATION, 4, GL_FLOAT, GL_FALSE, sizeof(SInstance),
+								(void*)(offset + sizeof(glm::mat4) + 2 * sizeof(glm::vec4) + sizeof(glm::vec2)));
+
+		glBindTexture(GL_TEXTURE_2D, it->first);
+		glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, (GLsizei)it->second.size());
+
+		uiFirstInstance += it->second.size();
+		uiNumDrawCalls++;
+	}
+	uiNumSprites = (unsigned int)vInstances.size();
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// Disable blending
+	glDisable(GL_BLEND);
+}
+
+/**
+ @brief Get the number of draw calls in the last frame
+ */
+unsigned int CSpriteInstancer2D::GetNumDrawCalls(void) const
+{
+	return uiNumDrawCalls;
+}
+
+/**
+ @brief Get the number of sprites drawn in the last frame
+ */
+unsigned int CSpriteInstancer2D::GetNumSprites(void) const
+{
+	return uiNumSprites;
+}
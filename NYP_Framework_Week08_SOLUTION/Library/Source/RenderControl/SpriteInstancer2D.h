@@ -0,0 +1,94 @@
+/**
+ CSpriteInstancer2D
+
+ Draws animated sprites whose frames are selected by the vertex shader, with one instanced draw
+ call per texture. All the sprites share a single quad. Each sprite only sends its transform,
+ colour, and the first frame, number of frames, sprite sheet size and time of its current clip,
+ and the region of its sprite sheet in a texture atlas, and Shader/Scene2DSprite.vs works out
+ the texture coordinates of the current frame.
+ The sprites must be created with CMeshBuilder::GenerateSpriteAnimation(..., true).
+
+ Usage, every frame:
+	cSpriteInstancer2D->Begin();
+	cSpriteInstancer2D->Submit(iTextureID, animatedSprites, transform, currentColor);	// for each sprite
+	cSpriteInstancer2D->Render();
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include CSpriteAnimation
+#include "../Primitives/SpriteAnimation.h"
+
+// Include CStreamingBuffer
+#include "StreamingBuffer.h"
+
+#include <string>
+#include <vector>
+#include <map>
+
+class CSpriteInstancer2D : public CSingletonTemplate<CSpriteInstancer2D>
+{
+	friend CSingletonTemplate<CSpriteInstancer2D>;
+public:
+	// Init
+	bool Init(void);
+
+	// Set the name of the shader to be used
+	void SetShader(const std::string& _name);
+
+	// Start a new frame
+	void Begin(void);
+	// Add an animated sprite to be drawn in this frame
+	void Submit(const GLuint iTextureID, const CSpriteAnimation* cSpriteAnimation,
+				const glm::mat4& transform, const glm::vec4& color);
+	// Draw all the sprites which were submitted in this frame
+	void Render(void);
+
+	// Get the number of draw calls in the last frame
+	unsigned int GetNumDrawCalls(void) const;
+	// Get the number of sprites drawn in the last frame
+	unsigned int GetNumSprites(void) const;
+
+protected:
+	// The attributes of a sprite, in the order of Shader/Scene2DSprite.vs
+	struct SInstance
+	{
+		glm::mat4 transform;
+		glm::vec4 color;
+		glm::vec4 sheet;
+		glm::vec2 time;
+		glm::vec4 atlas;
+	};
+
+	// The sprites of each texture. The vectors are kept between frames to reuse their memory.
+	std::map<GLuint, std::vector<SInstance> > mapBatches;
+	// All the sprites of this frame, in the order that they are uploaded
+	std::vector<SInstance> vInstances;
+
+	// OpenGL objects of the shared quad. The sprites are uploaded to CStreamingBuffer.
+	GLuint VAO, VBO, IBO;
+
+	// Name of Shader Program instance
+	std::string sShaderName;
+
+	// Statistics of the last frame
+	unsigned int uiNumDrawCalls;
+	unsigned int uiNumSprites;
+
+	// Constructor
+	CSpriteInstancer2D(void);
+
+	// Destructor
+	virtual ~CSpriteInstancer2D(void);
+};
@@ -0,0 +1,244 @@
+/**
+ CStreamingBuffer
+ */
+#include "StreamingBuffer.h"
+
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+// The definition of the constant, as it is bound to a reference by the conditional operator in Init
+const size_t CStreamingBuffer::DEFAULT_SEGMENT_SIZE;
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CStreamingBuffer::CStreamingBuffer(void)
+	: buffer(0)
+	, uiSegmentSize(0)
+	, iSegment(0)
+	, uiUsed(0)
+	, uiNumStalls(0)
+	, uiNumResizes(0)
+{
+	for (int i = 0; i < NUM_FRAMES; i++)
+		arrFences[i] = NULL;
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CStreamingBuffer::~CStreamingBuffer(void)
+{
+	DeleteFences();
+	if (buffer != 0)
+	{
+		glDeleteBuffers(1, &buffer);
+		buffer = 0;
+	}
+}
+
+/**
+ @brief Initialise this instance. Requires a valid OpenGL context.
+ @param uiSegmentSize A const size_t containing the number of bytes which can be allocated in a frame
+ @return true if the buffer was created, else false
+ */
+bool CStreamingBuffer::Init(const size_t uiSegmentSize)
+{
+	if (buffer == 0)
+		glGenBuffers(1, &buffer);
+	if (buffer == 0)
+	{
+		cout << "CStreamingBuffer: Unable to create the buffer" << endl;
+		return false;
+	}
+
+	Resize(uiSegmentSize > 0 ? uiSegmentSize : DEFAULT_SEGMENT_SIZE);
+	uiNumResizes = 0;
+	uiNumStalls = 0;
+	return true;
+}
+
+/**
+ @brief Start a new frame, and wait for the GPU if it is still reading the segment of this frame
+ */
+void CStreamingBuffer::BeginFrame(void)
+{
+	iSegment = (iSegment + 1) % NUM_FRAMES;
+	uiUsed = 0;
+
+	if (arrFences[iSegment] == NULL)
+		return;
+
+	// Check without waiting first, so that only real waits are counted as stalls
+	GLenum eResult = glClientWaitSync(arrFences[iSegment], GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+	if ((eResult == GL_TIMEOUT_EXPIRED) || (eResult == GL_WAIT_FAILED))
+	{
+		uiNumStalls++;
+		while (eResult == GL_TIMEOUT_EXPIRED)
+			eResult = glClientWaitSync(arrFences[iSegment], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+	}
+
+	glDeleteSync(arrFences[iSegment]);
+	arrFences[iSegment] = NULL;
+}
+
+/**
+ @brief End the frame after its draw calls. The segment of this frame is not reused until the GPU has finished them.
+ */
+void CStreamingBuffer::EndFrame(void)
+{
+	if (buffer == 0)
+		return;
+
+	if (arrFences[iSegment] != NULL)
+		glDeleteSync(arrFences[iSegment]);
+	arrFences[iSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/**
+ @brief Reserve space in this frame's segment and map it for writing. Call Commit before drawing with it,
+		and before the next call to Allocate.
+ @param uiSize A const size_t containing the number of bytes needed
+ @param uiAlignment A const size_t containing the alignment of the offset, which must be a power of 2
+ @return The allocation. pData is NULL if the allocation failed.
+ */
+CStreamingBuffer::SAllocation CStreamingBuffer::Allocate(const size_t uiSize, const size_t uiAlignment)
+{
+	SAllocation sAllocation;
+	sAllocation.buffer = buffer;
+	sAllocation.offset = 0;
+	sAllocation.pData = NULL;
+	sAllocation.uiSize = uiSize;
+
+	if (uiSize == 0)
+		return sAllocation;
+	if ((buffer == 0) && (Init() == false))
+		return sAllocation;
+
+	size_t uiOffset = (uiUsed + uiAlignment - 1) & ~(uiAlignment - 1);
+	if (uiOffset + uiSize > uiSegmentSize)
+	{
+		// This frame needs more space than a segment has, so grow the buffer
+		size_t uiNewSegmentSize = uiSegmentSize * 2;
+		while (uiNewSegmentSize < uiSize + uiAlignment)
+			uiNewSegmentSize *= 2;
+		Resize(uiNewSegmentSize);
+		uiOffset = 0;
+	}
+
+	sAllocation.buffer = buffer;
+	sAllocation.offset = (GLintptr)(iSegment * uiSegmentSize + uiOffset);
+
+	// The fences make sure that the GPU is not reading this range, so the driver does not need to check
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+	sAllocation.pData = glMapBufferRange(GL_COPY_WRITE_BUFFER, sAllocation.offset, uiSize,
+										 GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	if (sAllocation.pData != NULL)
+		uiUsed = uiOffset + uiSize;
+
+	return sAllocation;
+}
+
+/**
+ @brief Finish writing to an allocation, before it is drawn
+ @param sAllocation A SAllocation& which was returned by Allocate. Its pData is set to NULL.
+ */
+void CStreamingBuffer::Commit(SAllocation& sAllocation)
+{
+	if (sAllocation.pData == NULL)
+		return;
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, sAllocation.buffer);
+	glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	sAllocation.pData = NULL;
+}
+
+/**
+ @brief Copy data into a new allocation, which can be drawn with straight away
+ @param pData A const void* pointing to the data
+ @param uiSize A const size_t containing the number of bytes to copy
+ @param uiAlignment A const size_t containing the alignment of the offset, which must be a power of 2
+ @return The allocation. Its buffer is 0 if the allocation failed.
+ */
+CStreamingBuffer::SAllocation CStreamingBuffer::Upload(const void* pData, const size_t uiSize, const size_t uiAlignment)
+{
+	SAllocation sAllocation = Allocate(uiSize, uiAlignment);
+	if (sAllocation.pData == NULL)
+	{
+		sAllocation.buffer = 0;
+		return sAllocation;
+	}
+
+	memcpy(sAllocation.pData, pData, uiSize);
+	Commit(sAllocation);
+	return sAllocation;
+}
+
+/**
+ @brief Get the number of bytes allocated in this frame
+ */
+size_t CStreamingBuffer::GetBytesUsed(void) const
+{
+	return uiUsed;
+}
+
+/**
+ @brief Get the size of a segment in bytes
+ */
+size_t CStreamingBuffer::GetSegmentSize(void) const
+{
+	return uiSegmentSize;
+}
+
+/**
+ @brief Get the number of times that BeginFrame had to wait for the GPU
+ */
+unsigned int CStreamingBuffer::GetNumStalls(void) const
+{
+	return uiNumStalls;
+}
+
+/**
+ @brief Get the number of times that the buffer was grown
+ */
+unsigned int CStreamingBuffer::GetNumResizes(void) const
+{
+	return uiNumResizes;
+}
+
+/**
+ @brief Orphan the buffer and allocate a new one with larger segments. The old storage is released by
+		the driver once the GPU has finished with it, so none of the segments need to be waited for.
+ @param uiNewSegmentSize A const size_t containing the new size of a segment in bytes
+ */
+void CStreamingBuffer::Resize(const size_t uiNewSegmentSize)
+{
+	uiSegmentSize = uiNewSegmentSize;
+	uiUsed = 0;
+	uiNumResizes++;
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, uiSegmentSize * NUM_FRAMES, NULL, GL_STREAM_DRAW);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	DeleteFences();
+}
+
+/**
+ @brief Delete the fences
+ */
+void CStreamingBuffer::DeleteFences(void)
+{
+	for (int i = 0; i < NUM_FRAMES; i++)
+	{
+		if (arrFences[i] != NULL)
+		{
+			glDeleteSync(arrFences[i]);
+			arrFences[i] = NULL;
+		}
+	}
+}
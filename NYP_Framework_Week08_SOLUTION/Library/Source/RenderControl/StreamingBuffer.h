@@ -0,0 +1,109 @@
+/**
+ CStreamingBuffer
+
+ A shared buffer for vertex and index data which is rebuilt every frame, e.g. sprite batches,
+ text and instance matrices. The buffer is split into NUM_FRAMES segments which are used in turn,
+ one per frame. Each segment is written with an unsynchronised glMapBufferRange, so the driver
+ never waits for the GPU, and a fence is placed after the frame's draw calls. The fence is checked
+ before the segment is reused NUM_FRAMES frames later, so data which the GPU may still be reading
+ is never overwritten.
+
+ Usage:
+	cStreamingBuffer->BeginFrame();			// once per frame, before rendering
+	CStreamingBuffer::SAllocation sAllocation = cStreamingBuffer->Upload(pData, uiSize);
+	glBindBuffer(GL_ARRAY_BUFFER, sAllocation.buffer);
+	glVertexAttribPointer(..., (void*)sAllocation.offset);
+	glDraw...(...);							// draw before the next Allocate or Upload
+	cStreamingBuffer->EndFrame();			// once per frame, after rendering
+
+ If a frame needs more space than a segment has, the buffer is orphaned and grown. Allocations made
+ earlier in that frame are then no longer valid, so draw with each allocation before making the next.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+#include <cstddef>
+
+class CStreamingBuffer : public CSingletonTemplate<CStreamingBuffer>
+{
+	friend CSingletonTemplate<CStreamingBuffer>;
+public:
+	// The number of frames which can be in flight at the same time
+	static const int NUM_FRAMES = 3;
+	// The default size of a segment in bytes
+	static const size_t DEFAULT_SEGMENT_SIZE = 1024 * 1024;
+	// The default alignment of an allocation in bytes
+	static const size_t DEFAULT_ALIGNMENT = 16;
+
+	// A part of the buffer which can be written to in this frame
+	struct SAllocation
+	{
+		// The buffer to bind
+		GLuint buffer;
+		// The offset of the allocation in the buffer, in bytes
+		GLintptr offset;
+		// The memory to write to, until Commit is called
+		void* pData;
+		// The size of the allocation in bytes
+		size_t uiSize;
+	};
+
+	// Init
+	bool Init(const size_t uiSegmentSize = DEFAULT_SEGMENT_SIZE);
+
+	// Start a new frame, and wait for the GPU if it is still reading the segment of this frame
+	void BeginFrame(void);
+	// End the frame after its draw calls
+	void EndFrame(void);
+
+	// Reserve space in this frame's segment and map it for writing
+	SAllocation Allocate(const size_t uiSize, const size_t uiAlignment = DEFAULT_ALIGNMENT);
+	// Finish writing to an allocation, before it is drawn
+	void Commit(SAllocation& sAllocation);
+	// Copy data into a new allocation
+	SAllocation Upload(const void* pData, const size_t uiSize, const size_t uiAlignment = DEFAULT_ALIGNMENT);
+
+	// Get the number of bytes allocated in this frame
+	size_t GetBytesUsed(void) const;
+	// Get the size of a segment in bytes
+	size_t GetSegmentSize(void) const;
+	// Get the number of times that BeginFrame had to wait for the GPU
+	unsigned int GetNumStalls(void) const;
+	// Get the number of times that the buffer was grown
+	unsigned int GetNumResizes(void) const;
+
+protected:
+	// The OpenGL buffer
+	GLuint buffer;
+	// The size of each segment in bytes
+	size_t uiSegmentSize;
+	// The segment of this frame
+	int iSegment;
+	// The number of bytes used in the segment of this frame
+	size_t uiUsed;
+	// The fence after the last frame which used each segment
+	GLsync arrFences[NUM_FRAMES];
+
+	// Statistics
+	unsigned int uiNumStalls;
+	unsigned int uiNumResizes;
+
+	// Orphan the buffer and allocate a new one with larger segments
+	void Resize(const size_t uiNewSegmentSize);
+	// Delete the fences
+	void DeleteFences(void);
+
+	// Constructor
+	CStreamingBuffer(void);
+
+	// Destructor
+	virtual ~CStreamingBuffer(void);
+};
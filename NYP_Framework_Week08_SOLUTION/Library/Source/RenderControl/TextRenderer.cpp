@@ -6,9 +6,10 @@
 #include "TextRenderer.h"
 
  // Include Shader Manager
-#include "..\RenderControl\ShaderManager.h"
+#include "../RenderControl/ShaderManager.h"
 
 #include <iostream>
+#include <cstring>
 using namespace std;
 
 #include "../System/filesystem.h"
@@ -21,6 +22,7 @@ using namespace std;
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
 CTextRenderer::CTextRenderer(void)
+	: iAtlasTextureID(0)
 {
 }
 
@@ -34,6 +36,9 @@ CTextRenderer::~CTextRenderer(void)
 	glDeleteVertexArrays(1, &VAO);
 	glDeleteBuffers(1, &VBO);
 	glDeleteBuffers(1, &EBO);
+
+	for (int i = 0; i < (int)vStaticTexts.size(); i++)
+		DeleteStaticText(i);
 }
 
 /**
@@ -67,60 +72,62 @@ bool CTextRenderer::Init(void)
 	// Disable byte-alignment restriction
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-	// Load first 128 characters of ASCII set
-	for (GLubyte c = 0; c < 128; c++)
+	// Load first 128 characters of ASCII set and add their glyphs to the atlas
+	std::vector<unsigned char> vBitmap;
+	for (GLubyte c = 0; c < NUM_CHARACTERS; c++)
 	{
+		Characters[c].UVMin = Characters[c].UVMax = glm::vec2(0.0f);
+		Characters[c].Size = Characters[c].Bearing = glm::ivec2(0);
+		Characters[c].Advance = 0;
+
 		// Load character glyph 
 		if (FT_Load_Char(face, c, FT_LOAD_RENDER))
 		{
 			std::cout << "ERROR::FREETYTPE: Failed to load Glyph" << std::endl;
 			continue;
 		}
-		// Generate texture
-		GLuint texture;
-		glGenTextures(1, &texture);
-		glBindTexture(GL_TEXTURE_2D, texture);
-		glTexImage2D(
-			GL_TEXTURE_2D,
-			0,
-			GL_RED,
-			face->glyph->bitmap.width,
-			face->glyph->bitmap.rows,
-			0,
-			GL_RED,
-			GL_UNSIGNED_BYTE,
-			face->glyph->bitmap.buffer
-			);
-		// Set texture options
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		const FT_Bitmap& bitmap = face->glyph->bitmap;
+
 		// Now store character for later use
-		Character character = {
-			texture,
-			glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-			glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-			(GLuint)face->glyph->advance.x
-		};
-		Characters.insert(std::pair<GLchar, Character>(c, character));
+		Characters[c].Size = glm::ivec2(bitmap.width, bitmap.rows);
+		Characters[c].Bearing = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
+		Characters[c].Advance = (GLuint)face->glyph->advance.x;
+
+		// Glyphs such as the space have no bitmap
+		if ((bitmap.width == 0) || (bitmap.rows == 0))
+			continue;
+
+		// Copy the rows of the bitmap, as they may be padded
+		vBitmap.resize(bitmap.width * bitmap.rows);
+		for (unsigned int uiRow = 0; uiRow < bitmap.rows; uiRow++)
+			memcpy(&vBitmap[uiRow * bitmap.width], bitmap.buffer + uiRow * bitmap.pitch, bitmap.width);
+		cGlyphAtlas.AddImage(std::to_string(c), &vBitmap[0], bitmap.width, bitmap.rows, 1);
 	}
-	glBindTexture(GL_TEXTURE_2D, 0);
 	// Destroy FreeType once we're finished
 	FT_Done_Face(face);
 	FT_Done_FreeType(ft);
 
 
-	// Configure VAO/VBO for texture quads
+	// Pack the glyphs into one texture. The text shader only reads the red channel.
+	if ((cGlyphAtlas.Build() == false) || (cGlyphAtlas.GetNumPages() != 1) || (cGlyphAtlas.UploadToGPU() == false))
+	{
+		std::cout << "ERROR::FREETYPE: Failed to pack the glyphs into one texture" << std::endl;
+		return false;
+	}
+	iAtlasTextureID = cGlyphAtlas.GetTextureID(0);
+
+	// The bitmaps are stored from the top row, so the top of each glyph is at vec2UVMin.y
+	for (int c = 0; c < NUM_CHARACTERS; c++)
+	{
+		const CTextureAtlas::SRegion* sRegion = cGlyphAtlas.GetRegion(std::to_string(c));
+		if (sRegion == NULL)
+			continue;
+		Characters[c].UVMin = sRegion->vec2UVMin;
+		Characters[c].UVMax = sRegion->vec2UVMax;
+	}
+
+	// Configure VAO for texture quads. The vertices are streamed into CStreamingBuffer in Render.
 	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
-	glBindVertexArray(VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
 
 	return true;
 }
@@ -149,58 +156,174 @@ void CTextRenderer::PreRender(void)
 }
 
 /**
- @brief Render Render this instance
+ @brief Render a string with one draw call
+ @param text A const std::string& containing the string to draw
+ @param x A GLfloat containing the left of the string, in pixels
+ @param y A GLfloat containing the baseline of the string, in pixels
+ @param scale A GLfloat containing the scale of the glyphs
+ @param colour A glm::vec3 containing the colour of the string
  */
-void CTextRenderer::Render(std::string text, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 colour)
+void CTextRenderer::Render(const std::string& text, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 colour)
 {
+	BuildVertices(text, x, y, scale);
+	if (vVertices.empty())
+		return;
+
 	// Activate corresponding render state	
 	glUniform3f(glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "textColour"), 
 				colour.x, colour.y, colour.z);
 	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, iAtlasTextureID);
+
+	// Upload the whole string into this frame's part of the streaming buffer
+	CStreamingBuffer::SAllocation sAllocation = CStreamingBuffer::GetInstance()->Upload(&vVertices[0],
+																	sizeof(glm::vec4) * vVertices.size());
+	if (sAllocation.buffer == 0)
+		return;
 	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, sAllocation.buffer);
+	SetupVertexAttributes(sAllocation.offset);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// Render all the quads
+	glDrawArrays(GL_TRIANGLES, 0, (GLsizei)vVertices.size());
+
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/**
+ @brief PostRender Set up the OpenGL display environment after rendering.
+ */
+void CTextRenderer::PostRender(void)
+{
+	// Disable blending
+	glDisable(GL_BLEND);
+}
+
+/**
+ @brief Build the quads of a string which does not change, e.g. a label in the HUD
+ @param text A const std::string& containing the string
+ @param x A GLfloat containing the left of the string, in pixels
+ @param y A GLfloat containing the baseline of the string, in pixels
+ @param scale A GLfloat containing the scale of the glyphs
+ @return A handle to draw the string with RenderStaticText, or -1 if the string is empty
+ */
+int CTextRenderer::CreateStaticText(const std::string& text, GLfloat x, GLfloat y, GLfloat scale)
+{
+	BuildVertices(text, x, y, scale);
+	if (vVertices.empty())
+		return -1;
+
+	SStaticText sStaticText;
+	sStaticText.iNumVertices = (GLsizei)vVertices.size();
+	glGenVertexArrays(1, &sStaticText.VAO);
+	glGenBuffers(1, &sStaticText.VBO);
+	glBindVertexArray(sStaticText.VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, sStaticText.VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec4) * vVertices.size(), &vVertices[0], GL_STATIC_DRAW);
+	SetupVertexAttributes();
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+
+	// Reuse the slot of a deleted string
+	for (int i = 0; i < (int)vStaticTexts.size(); i++)
+	{
+		if (vStaticTexts[i].VAO == 0)
+		{
+			vStaticTexts[i] = sStaticText;
+			return i;
+		}
+	}
+	vStaticTexts.push_back(sStaticText);
+	return (int)vStaticTexts.size() - 1;
+}
+
+/**
+ @brief Draw a string which was built by CreateStaticText. Call PreRender first.
+ @param iHandle A const int containing the handle returned by CreateStaticText
+ @param colour A glm::vec3 containing the colour of the string
+ */
+void CTextRenderer::RenderStaticText(const int iHandle, glm::vec3 colour)
+{
+	if ((iHandle < 0) || (iHandle >= (int)vStaticTexts.size()) || (vStaticTexts[iHandle].VAO == 0))
+		return;
+
+	glUniform3f(glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "textColour"),
+				colour.x, colour.y, colour.z);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, iAtlasTextureID);
+	glBindVertexArray(vStaticTexts[iHandle].VAO);
+	glDrawArrays(GL_TRIANGLES, 0, vStaticTexts[iHandle].iNumVertices);
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/**
+ @brief Delete a string which was built by CreateStaticText
+ @param iHandle A const int containing the handle returned by CreateStaticText
+ */
+void CTextRenderer::DeleteStaticText(const int iHandle)
+{
+	if ((iHandle < 0) || (iHandle >= (int)vStaticTexts.size()) || (vStaticTexts[iHandle].VAO == 0))
+		return;
+
+	glDeleteVertexArrays(1, &vStaticTexts[iHandle].VAO);
+	glDeleteBuffers(1, &vStaticTexts[iHandle].VBO);
+	vStaticTexts[iHandle].VAO = 0;
+	vStaticTexts[iHandle].VBO = 0;
+	vStaticTexts[iHandle].iNumVertices = 0;
+}
+
+/**
+ @brief Build the quads of a string into vVertices, as <vec2 pos, vec2 tex> like text.vs expects
+ @param text A const std::string& containing the string
+ @param x A GLfloat containing the left of the string, in pixels
+ @param y A GLfloat containing the baseline of the string, in pixels
+ @param scale A GLfloat containing the scale of the glyphs
+ */
+void CTextRenderer::BuildVertices(const std::string& text, GLfloat x, GLfloat y, GLfloat scale)
+{
+	vVertices.clear();
 
 	// Iterate through all characters
 	std::string::const_iterator c;
 	for (c = text.begin(); c != text.end(); c++)
 	{
-		Character ch = Characters[*c];
-
-		GLfloat xpos = x + ch.Bearing.x * scale;
-		GLfloat ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
-
-		GLfloat w = ch.Size.x * scale;
-		GLfloat h = ch.Size.y * scale;
-		// Update VBO for each character
-		GLfloat vertices[6][4] = {
-			{ xpos, ypos + h, 0.0, 0.0 },
-			{ xpos, ypos, 0.0, 1.0 },
-			{ xpos + w, ypos, 1.0, 1.0 },
-
-			{ xpos, ypos + h, 0.0, 0.0 },
-			{ xpos + w, ypos, 1.0, 1.0 },
-			{ xpos + w, ypos + h, 1.0, 0.0 }
-		};
-		// Render glyph texture over quad
-		glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-		// Update content of VBO memory
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); // Be sure to use glBufferSubData and not glBufferData
-
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		// Render quad
-		glDrawArrays(GL_TRIANGLES, 0, 6);
+		// Skip characters which are not in the first 128 of the ASCII set
+		const unsigned char uc = (unsigned char)*c;
+		if (uc >= NUM_CHARACTERS)
+			continue;
+		const Character& ch = Characters[uc];
+
+		if ((ch.Size.x > 0) && (ch.Size.y > 0))
+		{
+			GLfloat xpos = x + ch.Bearing.x * scale;
+			GLfloat ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
+
+			GLfloat w = ch.Size.x * scale;
+			GLfloat h = ch.Size.y * scale;
+
+			vVertices.push_back(glm::vec4(xpos, ypos + h, ch.UVMin.x, ch.UVMin.y));
+			vVertices.push_back(glm::vec4(xpos, ypos, ch.UVMin.x, ch.UVMax.y));
+			vVertices.push_back(glm::vec4(xpos + w, ypos, ch.UVMax.x, ch.UVMax.y));
+
+			vVertices.push_back(glm::vec4(xpos, ypos + h, ch.UVMin.x, ch.UVMin.y));
+			vVertices.push_back(glm::vec4(xpos + w, ypos, ch.UVMax.x, ch.UVMax.y));
+			vVertices.push_back(glm::vec4(xpos + w, ypos + h, ch.UVMax.x, ch.UVMin.y));
+		}
+
 		// Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
 		x += (ch.Advance >> 6) * scale; // Bitshift by 6 to get value in pixels (2^6 = 64 (divide amount of 1/64th pixels by 64 to get amount of pixels))
 	}
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 /**
- @brief PostRender Set up the OpenGL display environment after rendering.
+ @brief Point attribute 0 of the bound VAO at the bound buffer
+ @param offset A const GLintptr containing the offset of the first vertex in the buffer, in bytes
  */
-void CTextRenderer::PostRender(void)
+void CTextRenderer::SetupVertexAttributes(const GLintptr offset)
 {
-	// Disable blending
-	glDisable(GL_BLEND);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (void*)offset);
 }
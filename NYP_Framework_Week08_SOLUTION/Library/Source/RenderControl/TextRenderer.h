@@ -2,6 +2,10 @@
  CTextRenderer
  By: Toh Da Jun
  Date: Mar 2020
+
+ The glyphs of the font are rasterised into one texture atlas at Init. Render builds the quads of a
+ whole string into one buffer and draws the string with one draw call. Strings which do not change,
+ e.g. labels in the HUD, can be built once with CreateStaticText and drawn with RenderStaticText.
  */
 #pragma once
 
@@ -22,8 +26,14 @@
 // Include CEntity2D
 #include "../Primitives/Entity2D.h"
 
+// Include CTextureAtlas
+#include "TextureAtlas.h"
+
+// Include CStreamingBuffer
+#include "StreamingBuffer.h"
+
 #include <string>
-#include <map>
+#include <vector>
 
 class CTextRenderer : public CSingletonTemplate<CTextRenderer>, public CEntity2D
 {
@@ -31,7 +41,8 @@ class CTextRenderer : public CSingletonTemplate<CTextRenderer>, public CEntity2D
 
 	// Holds all state information relevant to a character as loaded using FreeType
 	struct Character {
-		GLuint TextureID;   // ID handle of the glyph texture
+		glm::vec2 UVMin;    // Texture coordinates of the top left of the glyph in the atlas
+		glm::vec2 UVMax;    // Texture coordinates of the bottom right of the glyph in the atlas
 		glm::ivec2 Size;    // Size of glyph
 		glm::ivec2 Bearing;  // Offset from baseline to left/top of glyph
 		GLuint Advance;    // Horizontal offset to advance to next glyph
@@ -48,14 +59,46 @@ public:
 	void PreRender(void);
 
 	// Render
-	void Render(std::string text, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 colour);
+	void Render(const std::string& text, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 colour);
 
 	// PostRender
 	void PostRender(void);
 
+	// Build the quads of a string which does not change, and return a handle to draw it with
+	int CreateStaticText(const std::string& text, GLfloat x, GLfloat y, GLfloat scale);
+	// Draw a string which was built by CreateStaticText
+	void RenderStaticText(const int iHandle, glm::vec3 colour);
+	// Delete a string which was built by CreateStaticText
+	void DeleteStaticText(const int iHandle);
+
 protected:
-	// Map of characters
-	std::map<GLchar, Character> Characters;
+	// The number of characters which are loaded from the font
+	static const int NUM_CHARACTERS = 128;
+
+	// Array of characters, indexed by their ASCII code
+	Character Characters[NUM_CHARACTERS];
+	// The atlas which holds the glyphs of all the characters
+	CTextureAtlas cGlyphAtlas;
+	// The texture of the atlas
+	GLuint iAtlasTextureID;
+
+	// The vertices of the string being drawn. It is kept between calls to reuse its memory.
+	std::vector<glm::vec4> vVertices;
+
+	// A string which was built by CreateStaticText
+	struct SStaticText
+	{
+		GLuint VAO;
+		GLuint VBO;
+		GLsizei iNumVertices;
+	};
+	// The static strings. Deleted strings have a VAO of 0, and their slots are reused.
+	std::vector<SStaticText> vStaticTexts;
+
+	// Build the quads of a string into vVertices
+	void BuildVertices(const std::string& text, GLfloat x, GLfloat y, GLfloat scale);
+	// Point attribute 0 of the bound VAO at the bound buffer
+	void SetupVertexAttributes(const GLintptr offset = 0);
 
 	// Constructor
 	CTextRenderer(void);
@@ -0,0 +1,498 @@
+/**
+ CTextureAtlas
+ */
+#include "TextureAtlas.h"
+
+// Include ImageLoader
+#include "../System/ImageLoader.h"
+// Include BufferedWriter
+#include "../System/BufferedWriter.h"
+// Include filesystem to read files
+#include "../System/filesystem.h"
+// Include rapidcsv to read the regions
+#include "../System/rapidcsv.h"
+// Include CProfiler
+#include "../TimeControl/Profiler.h"
+
+// Include the rectangle packer of Dear ImGui. It is compiled as static functions in this file,
+// so that it does not clash with the copy in imgui_draw.cpp.
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "../GUI/imstb_rectpack.h"
+
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+/**
+ @brief Constructor
+ */
+CTextureAtlas::CTextureAtlas(void)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CTextureAtlas::~CTextureAtlas(void)
+{
+	Clear();
+}
+
+/**
+ @brief Add an image file to be packed
+ @param sName A const std::string& containing the name to look up the image with
+ @param filename A const char* containing the file name of the image
+ @return true if the image was loaded, else false
+ */
+bool CTextureAtlas::AddImage(const std::string& sName, const char* filename)
+{
+	int width, height, nrChannels;
+	unsigned char* data = CImageLoader::GetInstance()->Load(filename, width, height, nrChannels, true);
+	if (data == NULL)
+	{
+		std::cout << "CTextureAtlas: Unable to load " << filename << std::endl;
+		return false;
+	}
+
+	bool bResult = AddImage(sName, data, width, height, nrChannels);
+
+	// Free up the memory of the file data read in
+	free(data);
+
+	return bResult;
+}
+
+/**
+ @brief Add an image in memory to be packed. It is converted to RGBA.
+ @param sName A const std::string& containing the name to look up the image with
+ @param data A const unsigned char* containing the pixels, from the bottom row to the top row
+ @param width A const int containing the width of the image
+ @param height A const int containing the height of the image
+ @param nrChannels A const int containing the number of bytes per pixel, from 1 to 4
+ @return true if the image was added, else false
+ */
+bool CTextureAtlas::AddImage(const std::string& sName, const unsigned char* data,
+							 const int width, const int height, const int nrChannels)
+{
+	if ((data == NULL) || (width <= 0) || (height <= 0) || (nrChannels < 1) || (nrChannels > 4))
+		return false;
+
+	SImage& sImage = mapImages[sName];
+	sImage.width = width;
+	sImage.height = height;
+	sImage.vPixels.resize(width * height * 4);
+
+	for (int i = 0; i < width * height; i++)
+	{
+		const unsigned char* pIn = data + i * nrChannels;
+		unsigned char* pOut = &sImage.vPixels[i * 4];
+		if (nrChannels <= 2)
+		{
+			// Grey, with or without alpha
+			pOut[0] = pOut[1] = pOut[2] = pIn[0];
+			pOut[3] = (nrChannels == 2) ? pIn[1] : 255;
+		}
+		else
+		{
+			pOut[0] = pIn[0];
+			pOut[1] = pIn[1];
+			pOut[2] = pIn[2];
+			pOut[3] = (nrChannels == 4) ? pIn[3] : 255;
+		}
+	}
+
+	return true;
+}
+
+/**
+ @brief Add a sprite sheet file to be packed, with its frames rearranged into a grid of iNewCols columns.
+		The frames keep their order from left to right, then from top to bottom, so a sprite sheet of
+		iRows x iCols frames is animated as (iRows * iCols + iNewCols - 1) / iNewCols rows of iNewCols frames.
+		Any unused frames at the end of the last row are transparent.
+ @param sName A const std::string& containing the name to look up the sprite sheet with
+ @param filename A const char* containing the name of the sprite sheet file
+ @param iRows A const int containing the number of rows of frames in the file
+ @param iCols A const int containing the number of columns of frames in the file
+ @param iNewCols A const int containing the number of columns of frames in the atlas
+ @return true if the sprite sheet was added, else false
+ */
+bool CTextureAtlas::AddSpriteSheet(const std::string& sName, const char* filename,
+								   const int iRows, const int iCols, const int iNewCols)
+{
+	if ((iRows <= 0) || (iCols <= 0) || (iNewCols <= 0))
+		return false;
+
+	int width, height, nrChannels;
+	unsigned char* data = CImageLoader::GetInstance()->Load(filename, width, height, nrChannels, true);
+	if (data == NULL)
+	{
+		std::cout << "CTextureAtlas: Unable to load " << filename << std::endl;
+		return false;
+	}
+
+	const int iFrameWidth = width / iCols;
+	const int iFrameHeight = height / iRows;
+	const int iNumFrames = iRows * iCols;
+	const int iNewRows = (iNumFrames + iNewCols - 1) / iNewCols;
+	const int iNewWidth = iFrameWidth * iNewCols;
+	const int iNewHeight = iFrameHeight * iNewRows;
+	std::vector<unsigned char> vPixels(iNewWidth * iNewHeight * nrChannels, 0);
+
+	// Copy each frame. The rows of the images are stored from the bottom up, so the top row
+	// of frames is at the end of each image.
+	for (int iFrame = 0; iFrame < iNumFrames; iFrame++)
+	{
+		const int iSrcX = (iFrame % iCols) * iFrameWidth;
+		const int iSrcY = (iRows - 1 - iFrame / iCols) * iFrameHeight;
+		const int iDstX = (iFrame % iNewCols) * iFrameWidth;
+		const int iDstY = (iNewRows - 1 - iFrame / iNewCols) * iFrameHeight;
+		for (int y = 0; y < iFrameHeight; y++)
+		{
+			memcpy(	&vPixels[((iDstY + y) * iNewWidth + iDstX) * nrChannels],
+					data + ((iSrcY + y) * width + iSrcX) * nrChannels,
+					iFrameWidth * nrChannels);
+		}
+	}
+
+	// Free up the memory of the file data read in
+	free(data);
+
+	return AddImage(sName, &vPixels[0], iNewWidth, iNewHeight, nrChannels);
+}
+
+/**
+ @brief Pack all the added images into pages. Images which do not fit into a page are moved to the next page.
+ @param iPageSize A const int containing the width and height of a page in pixels
+ @param iPadding A const int containing the number of pixels around each image
+ @return true if all the images were packed, else false
+ */
+bool CTextureAtlas::Build(const int iPageSize, const int iPadding)
+{
+	PROFILE_SCOPE("TextureAtlas::Build");
+
+	DeleteTextures();
+	vPages.clear();
+	mapRegions.clear();
+
+	// stb_rect_pack stores coordinates as unsigned short
+	if ((iPageSize <= 0) || (iPageSize > 0xFFFF) || (iPadding < 0))
+		return false;
+
+	// Make a rectangle for each image, including its padding
+	std::vector<const std::string*> vNames;
+	std::vector<stbrp_rect> vRemaining;
+	std::map<std::string, SImage>::const_iterator it;
+	for (it = mapImages.begin(); it != mapImages.end(); ++it)
+	{
+		stbrp_rect sRect;
+		sRect.id = (int)vNames.size();
+		sRect.w = (stbrp_coord)(it->second.width + iPadding * 2);
+		sRect.h = (stbrp_coord)(it->second.height + iPadding * 2);
+		sRect.x = sRect.y = 0;
+		sRect.was_packed = 0;
+		if ((sRect.w > iPageSize) || (sRect.h > iPageSize))
+		{
+			std::cout << "CTextureAtlas: " << it->first << " is larger than a page" << std::endl;
+			return false;
+		}
+		vNames.push_back(&it->first);
+		vRemaining.push_back(sRect);
+	}
+
+	std::vector<stbrp_node> vNodes(iPageSize);
+	while (vRemaining.empty() == false)
+	{
+		stbrp_context sContext;
+		stbrp_init_target(&sContext, iPageSize, iPageSize, &vNodes[0], (int)vNodes.size());
+		stbrp_pack_rects(&sContext, &vRemaining[0], (int)vRemaining.size());
+
+		SPage sPage;
+		sPage.width = iPageSize;
+		sPage.height = iPageSize;
+		sPage.vPixels.assign(iPageSize * iPageSize * 4, 0);
+		sPage.iTextureID = 0;
+		vPages.push_back(sPage);
+		SPage& sNewPage = vPages.back();
+		const int iPage = (int)vPages.size() - 1;
+
+		// Copy the packed images into the page, and keep the rest for the next page
+		std::vector<stbrp_rect> vNotPacked;
+		for (size_t i = 0; i < vRemaining.size(); i++)
+		{
+			const stbrp_rect& sRect = vRemaining[i];
+			if (sRect.was_packed == 0)
+			{
+				vNotPacked.push_back(sRect);
+				continue;
+			}
+
+			const std::string& sName = *vNames[sRect.id];
+			const SImage& sImage = mapImages[sName];
+
+			SRegion sRegion;
+			sRegion.iPage = iPage;
+			sRegion.x = sRect.x + iPadding;
+			sRegion.y = sRect.y + iPadding;
+			sRegion.width = sImage.width;
+			sRegion.height = sImage.height;
+			sRegion.vec2UVMin = glm::vec2((float)sRegion.x / iPageSize, (float)sRegion.y / iPageSize);
+			sRegion.vec2UVMax = glm::vec2((float)(sRegion.x + sRegion.width) / iPageSize,
+										  (float)(sRegion.y + sRegion.height) / iPageSize);
+			mapRegions[sName] = sRegion;
+
+			Blit(sImage, sNewPage, sRegion.x, sRegion.y, iPadding);
+		}
+		vRemaining.swap(vNotPacked);
+	}
+
+	// The pixels are now in the pages
+	mapImages.clear();
+
+	return true;
+}
+
+/**
+ @brief Create an OpenGL texture for each page. Requires a valid OpenGL context.
+ @return true if all the textures were created, else false
+ */
+bool CTextureAtlas::UploadToGPU(void)
+{
+	DeleteTextures();
+
+	for (size_t i = 0; i < vPages.size(); i++)
+	{
+		SPage& sPage = vPages[i];
+		glGenTextures(1, &sPage.iTextureID);
+		if (sPage.iTextureID == 0)
+			return false;
+
+		glBindTexture(GL_TEXTURE_2D, sPage.iTextureID);
+		// Regions are not repeated, and the padding only covers bilinear filtering, so there are no mipmaps
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, sPage.width, sPage.height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+					 &sPage.vPixels[0]);
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	return true;
+}
+
+/**
+ @brief Write the pages as TGA files, <sPrefix>_<page>.tga, and the regions as a CSV file, <sPrefix>.csv
+ @param sPrefix A const std::string& containing the path and name of the files without an extension
+ @return true if all the files were written, else false
+ */
+bool CTextureAtlas::Save(const std::string& sPrefix) const
+{
+	for (size_t i = 0; i < vPages.size(); i++)
+	{
+		const SPage& sPage = vPages[i];
+		const std::string sFileName = sPrefix + "_" + std::to_string(i) + ".tga";
+
+		CBufferedWriter cBufferedWriter;
+		if (cBufferedWriter.Open(FileSystem::getPath(sFileName), 18 + sPage.vPixels.size()) == false)
+		{
+			std::cout << "CTextureAtlas: Unable to open " << sFileName << std::endl;
+			return false;
+		}
+
+		// An uncompressed 32-bit TGA. Its rows start from the bottom, like the pages.
+		unsigned char arrHeader[18];
+		memset(arrHeader, 0, sizeof(arrHeader));
+		arrHeader[2] = 2;
+		arrHeader[12] = (unsigned char)(sPage.width & 0xFF);
+		arrHeader[13] = (unsigned char)(sPage.width >> 8);
+		arrHeader[14] = (unsigned char)(sPage.height & 0xFF);
+		arrHeader[15] = (unsigned char)(sPage.height >> 8);
+		arrHeader[16] = 32;
+		arrHeader[17] = 8;
+		cBufferedWriter.WriteBytes(arrHeader, sizeof(arrHeader));
+
+		// TGA stores the pixels as BGRA
+		std::vector<unsigned char> vRow(sPage.width * 4);
+		for (int y = 0; y < sPage.height; y++)
+		{
+			const unsigned char* pIn = &sPage.vPixels[y * sPage.width * 4];
+			for (int x = 0; x < sPage.width; x++)
+			{
+				vRow[x * 4 + 0] = pIn[x * 4 + 2];
+				vRow[x * 4 + 1] = pIn[x * 4 + 1];
+				vRow[x * 4 + 2] = pIn[x * 4 + 0];
+				vRow[x * 4 + 3] = pIn[x * 4 + 3];
+			}
+			cBufferedWriter.WriteBytes(&vRow[0], vRow.size());
+		}
+
+		if (cBufferedWriter.Close() == false)
+			return false;
+	}
+
+	CBufferedWriter cBufferedWriter;
+	if (cBufferedWriter.Open(FileSystem::getPath(sPrefix + ".csv")) == false)
+	{
+		std::cout << "CTextureAtlas: Unable to open " << sPrefix << ".csv" << std::endl;
+		return false;
+	}
+	cBufferedWriter.WriteString("name,page,x,y,width,height\n");
+	std::map<std::string, SRegion>::const_iterator it;
+	for (it = mapRegions.begin(); it != mapRegions.end(); ++it)
+	{
+		int arrValues[5] = { it->second.iPage, it->second.x, it->second.y, it->second.width, it->second.height };
+		cBufferedWriter.WriteString(it->first);
+		cBufferedWriter.WriteChar(',');
+		cBufferedWriter.WriteRow(arrValues, 5);
+	}
+
+	return cBufferedWriter.Close();
+}
+
+/**
+ @brief Read an atlas which was written by Save, and upload it. Requires a valid OpenGL context.
+ @param sPrefix A const std::string& containing the path and name of the files without an extension
+ @return true if the atlas was loaded, else false
+ */
+bool CTextureAtlas::Load(const std::string& sPrefix)
+{
+	Clear();
+
+	rapidcsv::Document doc(FileSystem::getPath(sPrefix + ".csv"));
+	std::vector<std::string> vNames = doc.GetColumn<std::string>("name");
+	std::vector<int> vPageIndices = doc.GetColumn<int>("page");
+	std::vector<int> vX = doc.GetColumn<int>("x");
+	std::vector<int> vY = doc.GetColumn<int>("y");
+	std::vector<int> vWidth = doc.GetColumn<int>("width");
+	std::vector<int> vHeight = doc.GetColumn<int>("height");
+
+	// Load the pages which are used by the regions
+	int iNumPages = 0;
+	for (size_t i = 0; i < vPageIndices.size(); i++)
+		iNumPages = glm::max(iNumPages, vPageIndices[i] + 1);
+
+	vPages.resize(iNumPages);
+	for (int i = 0; i < iNumPages; i++)
+	{
+		const std::string sFileName = sPrefix + "_" + std::to_string(i) + ".tga";
+
+		int width, height, nrChannels;
+		unsigned char* data = CImageLoader::GetInstance()->Load(sFileName.c_str(), width, height, nrChannels, true);
+		if ((data == NULL) || (nrChannels != 4))
+		{
+			std::cout << "CTextureAtlas: Unable to load " << sFileName << std::endl;
+			free(data);
+			Clear();
+			return false;
+		}
+
+		vPages[i].width = width;
+		vPages[i].height = height;
+		vPages[i].vPixels.assign(data, data + width * height * 4);
+		vPages[i].iTextureID = 0;
+		free(data);
+	}
+
+	for (size_t i = 0; i < vNames.size(); i++)
+	{
+		const SPage& sPage = vPages[vPageIndices[i]];
+
+		SRegion sRegion;
+		sRegion.iPage = vPageIndices[i];
+		sRegion.x = vX[i];
+		sRegion.y = vY[i];
+		sRegion.width = vWidth[i];
+		sRegion.height = vHeight[i];
+		sRegion.vec2UVMin = glm::vec2((float)sRegion.x / sPage.width, (float)sRegion.y / sPage.height);
+		sRegion.vec2UVMax = glm::vec2((float)(sRegion.x + sRegion.width) / sPage.width,
+									  (float)(sRegion.y + sRegion.height) / sPage.height);
+		mapRegions[vNames[i]] = sRegion;
+	}
+
+	return UploadToGPU();
+}
+
+/**
+ @brief Delete the images, the pages and their textures
+ */
+void CTextureAtlas::Clear(void)
+{
+	DeleteTextures();
+	mapImages.clear();
+	mapRegions.clear();
+	vPages.clear();
+}
+
+/**
+ @brief Get the region of an image
+ @param sName A const std::string& containing the name of the image
+ @return The region of the image, or NULL if there is no image with that name
+ */
+const CTextureAtlas::SRegion* CTextureAtlas::GetRegion(const std::string& sName) const
+{
+	std::map<std::string, SRegion>::const_iterator it = mapRegions.find(sName);
+	if (it == mapRegions.end())
+		return NULL;
+	return &it->second;
+}
+
+/**
+ @brief Get the OpenGL texture of a page
+ @param iPage A const int containing the page number
+ @return The texture, or 0 if the page does not exist or has not been uploaded
+ */
+GLuint CTextureAtlas::GetTextureID(const int iPage) const
+{
+	if ((iPage < 0) || (iPage >= (int)vPages.size()))
+		return 0;
+	return vPages[iPage].iTextureID;
+}
+
+/**
+ @brief Get the number of pages
+ */
+int CTextureAtlas::GetNumPages(void) const
+{
+	return (int)vPages.size();
+}
+
+/**
+ @brief Copy an image into a page, and extend its edge pixels into the padding,
+		so that bilinear filtering at the edges of the image does not read its neighbours
+ @param sImage A const SImage& containing the image to copy
+ @param sPage A SPage& containing the page to copy into
+ @param x A const int containing the left of the image in the page
+ @param y A const int containing the bottom of the image in the page
+ @param iPadding A const int containing the number of pixels around the image
+ */
+void CTextureAtlas::Blit(const SImage& sImage, SPage& sPage, const int x, const int y, const int iPadding)
+{
+	for (int iRow = -iPadding; iRow < sImage.height + iPadding; iRow++)
+	{
+		const int iSrcRow = glm::clamp(iRow, 0, sImage.height - 1);
+		unsigned char* pOut = &sPage.vPixels[((y + iRow) * sPage.width + x) * 4];
+		const unsigned char* pIn = &sImage.vPixels[iSrcRow * sImage.width * 4];
+
+		for (int iCol = -iPadding; iCol < 0; iCol++)
+			memcpy(pOut + iCol * 4, pIn, 4);
+		memcpy(pOut, pIn, sImage.width * 4);
+		for (int iCol = sImage.width; iCol < sImage.width + iPadding; iCol++)
+			memcpy(pOut + iCol * 4, pIn + (sImage.width - 1) * 4, 4);
+	}
+}
+
+/**
+ @brief Delete the OpenGL textures of the pages
+ */
+void CTextureAtlas::DeleteTextures(void)
+{
+	for (size_t i = 0; i < vPages.size(); i++)
+	{
+		if (vPages[i].iTextureID != 0)
+		{
+			glDeleteTextures(1, &vPages[i].iTextureID);
+			vPages[i].iTextureID = 0;
+		}
+	}
+}
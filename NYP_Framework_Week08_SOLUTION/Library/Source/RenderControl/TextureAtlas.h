@@ -0,0 +1,123 @@
+/**
+ CTextureAtlas
+
+ Packs many small images, e.g. tiles, sprite sheets and inventory icons, into a few large
+ textures (pages), so that they can be drawn without switching textures. Each image is looked up
+ by name, and its region in the atlas is returned as a page number and a rectangle of UVs.
+ A sprite sheet which is wider or taller than a page, e.g. a long strip of frames, can be added
+ with AddSpriteSheet, which rearranges its frames into fewer columns and more rows.
+ The images are packed with the stb_rect_pack which is bundled with Dear ImGui.
+
+ An atlas can be built at runtime:
+	cTextureAtlas.AddImage("tree", "Image/Scene2D_TreeTile.tga");	// for each image
+	cTextureAtlas.Build();
+	cTextureAtlas.UploadToGPU();
+ or built offline with Save("Image/Atlas") and loaded at runtime with Load("Image/Atlas"),
+ which reads Image/Atlas.csv and the pages Image/Atlas_0.tga, Image/Atlas_1.tga, ...
+
+ All images are loaded upside down by CImageLoader, so row 0 of each page is the bottom row,
+ which matches the OpenGL texture coordinates.
+ */
+#pragma once
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include GLM
+#include <includes/glm.hpp>
+
+#include <string>
+#include <vector>
+#include <map>
+
+class CTextureAtlas
+{
+public:
+	// The default width and height of a page in pixels
+	static const int DEFAULT_PAGE_SIZE = 1024;
+	// The default number of pixels around each image, which are filled with its edge pixels
+	static const int DEFAULT_PADDING = 1;
+
+	// The place of an image in the atlas
+	struct SRegion
+	{
+		// The page which the image is in
+		int iPage;
+		// The position and size of the image in the page, in pixels, excluding the padding
+		int x, y, width, height;
+		// The texture coordinates of the bottom left and top right corners of the image
+		glm::vec2 vec2UVMin;
+		glm::vec2 vec2UVMax;
+
+		// Convert a texture coordinate in the original image, e.g. of a frame in a sprite sheet, to the atlas
+		glm::vec2 ToAtlasUV(const glm::vec2& vec2UV) const
+		{
+			return vec2UVMin + vec2UV * (vec2UVMax - vec2UVMin);
+		}
+	};
+
+	// Constructor
+	CTextureAtlas(void);
+	// Destructor
+	virtual ~CTextureAtlas(void);
+
+	// Add an image file to be packed
+	bool AddImage(const std::string& sName, const char* filename);
+	// Add an image in memory to be packed
+	bool AddImage(const std::string& sName, const unsigned char* data,
+				  const int width, const int height, const int nrChannels);
+	// Add a sprite sheet file to be packed, with its frames rearranged into iNewCols columns
+	bool AddSpriteSheet(const std::string& sName, const char* filename,
+						const int iRows, const int iCols, const int iNewCols);
+
+	// Pack all the added images into pages
+	bool Build(const int iPageSize = DEFAULT_PAGE_SIZE, const int iPadding = DEFAULT_PADDING);
+	// Create an OpenGL texture for each page
+	bool UploadToGPU(void);
+
+	// Write the pages as TGA files and the regions as a CSV file
+	bool Save(const std::string& sPrefix) const;
+	// Read an atlas which was written by Save, and upload it
+	bool Load(const std::string& sPrefix);
+
+	// Delete the images, the pages and their textures
+	void Clear(void);
+
+	// Get the region of an image, or NULL if there is no image with that name
+	const SRegion* GetRegion(const std::string& sName) const;
+	// Get the OpenGL texture of a page
+	GLuint GetTextureID(const int iPage) const;
+	// Get the number of pages
+	int GetNumPages(void) const;
+
+protected:
+	// An image which is waiting to be packed, in RGBA
+	struct SImage
+	{
+		int width, height;
+		std::vector<unsigned char> vPixels;
+	};
+
+	// A page of the atlas, in RGBA
+	struct SPage
+	{
+		int width, height;
+		std::vector<unsigned char> vPixels;
+		GLuint iTextureID;
+	};
+
+	// The images which were added, by name. They are released by Build.
+	std::map<std::string, SImage> mapImages;
+	// The regions of the packed images, by name
+	std::map<std::string, SRegion> mapRegions;
+	// The pages
+	std::vector<SPage> vPages;
+
+	// Copy an image into a page, and extend its edge pixels into the padding
+	static void Blit(const SImage& sImage, SPage& sPage, const int x, const int y, const int iPadding);
+	// Delete the OpenGL textures of the pages
+	void DeleteTextures(void);
+};
@@ -2,6 +2,9 @@
 #include <iostream>
 #include <fstream>
 
+// Include CProfiler
+#include "../TimeControl/Profiler.h"
+
 /**
  @brief Constructor
  */
@@ -57,6 +60,8 @@ bool CScriptManager::Init(	const std::string& filename,
 						const std::string& Writefilename, 
 						const bool bDisplayFileContent)
 {
+	PROFILE_SCOPE("ScriptManager::Init");
+
 	// Check if the Lua State is valid.
 	// Open the Lua State if not
 	if (pLuaState == NULL)
@@ -15,6 +15,11 @@ Date: Mar 2020
 #include <vector>
 #include <iostream>
 
+// sprintf_s of an array is only in the Microsoft C runtime
+#ifndef _MSC_VER
+	#define sprintf_s(buffer, ...) snprintf(buffer, sizeof(buffer), __VA_ARGS__)
+#endif
+
 using namespace std;
 
 // Include GLM
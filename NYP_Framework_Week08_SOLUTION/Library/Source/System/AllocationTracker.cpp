@@ -0,0 +1,321 @@
+/**
+ CAllocationTracker
+ */
+#include "AllocationTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <iostream>
+using namespace std;
+
+// The counters of the frame which is in progress. They are zero-initialised before any allocation happens.
+static atomic<unsigned int> arrCounts[CAllocationTracker::NUM_TAGS];
+static atomic<size_t> arrBytes[CAllocationTracker::NUM_TAGS];
+static atomic<unsigned int> uiUpdateCount;
+static atomic<size_t> uiUpdateBytes;
+static atomic<unsigned int> uiFrees;
+static atomic<bool> bInUpdate;
+
+// The counters of the last frame
+static unsigned int arrLastCounts[CAllocationTracker::NUM_TAGS];
+static size_t arrLastBytes[CAllocationTracker::NUM_TAGS];
+static unsigned int uiLastUpdateCount;
+static size_t uiLastUpdateBytes;
+static unsigned int uiLastFrees;
+
+// The counters of all the frames
+static unsigned long long arrTotalCounts[CAllocationTracker::NUM_TAGS];
+static unsigned long long arrTotalBytes[CAllocationTracker::NUM_TAGS];
+
+// The frames, and the warm-up
+static unsigned int uiNumFrames;
+static unsigned int uiNumFlaggedFrames;
+static unsigned int uiFramesSinceReset;
+static unsigned int uiWarmupFrames = CAllocationTracker::DEFAULT_WARMUP_FRAMES;
+
+// The tag of the allocations of each thread
+static thread_local int iCurrentTag = CAllocationTracker::UNTAGGED;
+
+// The names of the tags
+static const char* const arrTagNames[CAllocationTracker::NUM_TAGS] =
+{
+	"Untagged",
+	"Map",
+	"Entities",
+	"Spawner",
+	"GUI",
+	"Render",
+	"Sound"
+};
+
+/**
+ @brief Start a new frame. The allocations since the last frame ended, e.g. while loading, are not counted.
+ */
+void CAllocationTracker::BeginFrame(void)
+{
+	for (int i = 0; i < NUM_TAGS; i++)
+	{
+		arrCounts[i].store(0, memory_order_relaxed);
+		arrBytes[i].store(0, memory_order_relaxed);
+	}
+	uiUpdateCount.store(0, memory_order_relaxed);
+	uiUpdateBytes.store(0, memory_order_relaxed);
+	uiFrees.store(0, memory_order_relaxed);
+}
+
+/**
+ @brief End the frame, and store its counters. After the warm-up, a frame which allocated in its update is flagged and reported.
+ */
+void CAllocationTracker::EndFrame(void)
+{
+	for (int i = 0; i < NUM_TAGS; i++)
+	{
+		arrLastCounts[i] = arrCounts[i].load(memory_order_relaxed);
+		arrLastBytes[i] = arrBytes[i].load(memory_order_relaxed);
+		arrTotalCounts[i] += arrLastCounts[i];
+		arrTotalBytes[i] += arrLastBytes[i];
+	}
+	uiLastUpdateCount = uiUpdateCount.load(memory_order_relaxed);
+	uiLastUpdateBytes = uiUpdateBytes.load(memory_order_relaxed);
+	uiLastFrees = uiFrees.load(memory_order_relaxed);
+
+	if (IsSteady() && (uiLastUpdateCount > 0))
+	{
+		uiNumFlaggedFrames++;
+		if (uiNumFlaggedFrames <= MAX_REPORTS)
+		{
+			cout << "CAllocationTracker: Frame " << uiNumFrames << " allocated " << uiLastUpdateCount
+				<< " times (" << uiLastUpdateBytes << " bytes) in its update. This frame:";
+			for (int i = 0; i < NUM_TAGS; i++)
+			{
+				if (arrLastCounts[i] > 0)
+					cout << " " << arrTagNames[i] << " " << arrLastCounts[i] << " (" << arrLastBytes[i] << " bytes)";
+			}
+			cout << endl;
+			if (uiNumFlaggedFrames == MAX_REPORTS)
+				cout << "CAllocationTracker: Further flagged frames are only counted" << endl;
+		}
+	}
+
+	uiNumFrames++;
+	uiFramesSinceReset++;
+}
+
+/**
+ @brief Start the update of the scene
+ */
+void CAllocationTracker::BeginUpdate(void)
+{
+	bInUpdate.store(true, memory_order_relaxed);
+}
+
+/**
+ @brief End the update of the scene
+ */
+void CAllocationTracker::EndUpdate(void)
+{
+	bInUpdate.store(false, memory_order_relaxed);
+}
+
+/**
+ @brief Start the warm-up again, e.g. when a level is loaded, as the containers grow to fit the new level
+ */
+void CAllocationTracker::ResetSteadyState(void)
+{
+	uiFramesSinceReset = 0;
+}
+
+/**
+ @brief Set the number of frames after a reset before the update must stop allocating
+ @param uiWarmupFrames A const unsigned int containing the number of frames
+ */
+void CAllocationTracker::SetWarmupFrames(const unsigned int uiWarmupFrames)
+{
+	::uiWarmupFrames = uiWarmupFrames;
+}
+
+/**
+ @brief Check if the warm-up is over
+ */
+bool CAllocationTracker::IsSteady(void)
+{
+	return uiFramesSinceReset >= uiWarmupFrames;
+}
+
+/**
+ @brief Set the tag of the allocations of this thread
+ @param eTag A const TAG containing the new tag
+ @return The previous tag
+ */
+CAllocationTracker::TAG CAllocationTracker::SetTag(const TAG eTag)
+{
+	TAG ePreviousTag = (TAG)iCurrentTag;
+	iCurrentTag = eTag;
+	return ePreviousTag;
+}
+
+/**
+ @brief Get the name of a tag
+ @param eTag A const TAG containing the tag
+ */
+const char* CAllocationTracker::GetTagName(const TAG eTag)
+{
+	return arrTagNames[eTag];
+}
+
+/**
+ @brief Count an allocation under the tag of this thread
+ @param uiBytes A const size_t containing the number of bytes requested
+ */
+void CAllocationTracker::RecordAllocation(const size_t uiBytes)
+{
+	arrCounts[iCurrentTag].fetch_add(1, memory_order_relaxed);
+	arrBytes[iCurrentTag].fetch_add(uiBytes, memory_order_relaxed);
+	if (bInUpdate.load(memory_order_relaxed))
+	{
+		uiUpdateCount.fetch_add(1, memory_order_relaxed);
+		uiUpdateBytes.fetch_add(uiBytes, memory_order_relaxed);
+	}
+}
+
+/**
+ @brief Count a deallocation
+ */
+void CAllocationTracker::RecordFree(void)
+{
+	uiFrees.fetch_add(1, memory_order_relaxed);
+}
+
+/**
+ @brief Get the number of allocations of a tag in the last frame
+ @param eTag A const TAG containing the tag
+ */
+unsigned int CAllocationTracker::GetLastCount(const TAG eTag)
+{
+	return arrLastCounts[eTag];
+}
+
+/**
+ @brief Get the number of bytes allocated by a tag in the last frame
+ @param eTag A const TAG containing the tag
+ */
+size_t CAllocationTracker::GetLastBytes(const TAG eTag)
+{
+	return arrLastBytes[eTag];
+}
+
+/**
+ @brief Get the number of allocations in the update of the last frame
+ */
+unsigned int CAllocationTracker::GetLastUpdateCount(void)
+{
+	return uiLastUpdateCount;
+}
+
+/**
+ @brief Get the number of bytes allocated in the update of the last frame
+ */
+size_t CAllocationTracker::GetLastUpdateBytes(void)
+{
+	return uiLastUpdateBytes;
+}
+
+/**
+ @brief Get the number of deallocations in the last frame
+ */
+unsigned int CAllocationTracker::GetLastFrees(void)
+{
+	return uiLastFrees;
+}
+
+/**
+ @brief Get the number of frames which have ended
+ */
+unsigned int CAllocationTracker::GetNumFrames(void)
+{
+	return uiNumFrames;
+}
+
+/**
+ @brief Get the number of frames which allocated in their update after the warm-up
+ */
+unsigned int CAllocationTracker::GetNumFlaggedFrames(void)
+{
+	return uiNumFlaggedFrames;
+}
+
+/**
+ @brief Print the allocations of all the frames, by tag
+ */
+void CAllocationTracker::PrintSummary(void)
+{
+	if (uiNumFrames == 0)
+		return;
+
+	cout << "CAllocationTracker: " << uiNumFrames << " frames, " << uiNumFlaggedFrames
+		<< " of which allocated in their update after the warm-up" << endl;
+	for (int i = 0; i < NUM_TAGS; i++)
+	{
+		if (arrTotalCounts[i] == 0)
+			continue;
+		cout << "\t" << arrTagNames[i] << ": " << arrTotalCounts[i] << " allocations, " << arrTotalBytes[i]
+			<< " bytes, " << (double)arrTotalCounts[i] / uiNumFrames << " allocations per frame" << endl;
+	}
+}
+
+#ifndef DISABLE_ALLOCATION_TRACKER
+// Replace the global operator new and operator delete, so that every allocation is counted.
+// The other forms, e.g. the sized and nothrow operator delete, call these by default.
+void* operator new(size_t uiBytes)
+{
+	CAllocationTracker::RecordAllocation(uiBytes);
+	for (;;)
+	{
+		void* pMemory = malloc((uiBytes > 0) ? uiBytes : 1);
+		if (pMemory != NULL)
+			return pMemory;
+
+		// Let the new handler free some memory, as the default operator new does
+		new_handler pHandler = get_new_handler();
+		if (pHandler == NULL)
+			throw bad_alloc();
+		pHandler();
+	}
+}
+
+void* operator new[](size_t uiBytes)
+{
+	return operator new(uiBytes);
+}
+
+void* operator new(size_t uiBytes, const nothrow_t&) noexcept
+{
+	try
+	{
+		return operator new(uiBytes);
+	}
+	catch (...)
+	{
+		return NULL;
+	}
+}
+
+void* operator new[](size_t uiBytes, const nothrow_t&) noexcept
+{
+	return operator new(uiBytes, nothrow);
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	if (pMemory == NULL)
+		return;
+	CAllocationTracker::RecordFree();
+	free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+	operator delete(pMemory);
+}
+#endif
@@ -0,0 +1,189 @@
+/**
+ CAllocationTracker
+
+ Counts the heap allocations of each frame and the bytes that they request, by subsystem. The
+ global operator new and operator delete are replaced in AllocationTracker.cpp, so every
+ allocation through new, including those of the STL containers, is counted. An allocation is
+ counted under the tag of the innermost ALLOCATION_SCOPE, or as untagged outside of any scope.
+ A container which is used from many places, e.g. a member, should use CTaggedAllocator instead,
+ so that its allocations are counted under its own tag wherever it grows.
+
+ The update of the scene should not allocate once the game has settled, so the allocations
+ between BeginUpdate and EndUpdate are also counted separately. After the warm-up frames, a frame
+ which allocates in its update is flagged and reported, and counted in GetNumFlaggedFrames.
+
+ This class only has static members, as it is used inside operator new and so must not allocate.
+ The counters are atomic, as other threads may allocate too.
+
+ Usage:
+	CAllocationTracker::BeginFrame();				// once per frame, at the start
+	CAllocationTracker::BeginUpdate();
+	{
+		ALLOCATION_SCOPE(CAllocationTracker::MAP);	// count the allocations of this block under MAP
+		...
+	}
+	CTaggedVector<int, CAllocationTracker::MAP> vValues;	// always counted under MAP
+	CAllocationTracker::EndUpdate();
+	CAllocationTracker::EndFrame();					// once per frame, at the end
+
+ Define DISABLE_ALLOCATION_TRACKER to use the default operator new and compile the scopes out.
+ */
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+class CAllocationTracker
+{
+public:
+	// The subsystems which the allocations are counted under
+	enum TAG
+	{
+		UNTAGGED = 0,
+		MAP,
+		ENTITIES,
+		SPAWNER,
+		GUI,
+		RENDER,
+		SOUND,
+		NUM_TAGS
+	};
+
+	// The default number of frames after a reset before the update must stop allocating
+	static const unsigned int DEFAULT_WARMUP_FRAMES = 60;
+	// The number of flagged frames which are reported. Later ones are only counted.
+	static const unsigned int MAX_REPORTS = 10;
+
+	// Start a new frame
+	static void BeginFrame(void);
+	// End the frame, and flag it if it allocated in its update
+	static void EndFrame(void);
+
+	// Start the update of the scene
+	static void BeginUpdate(void);
+	// End the update of the scene
+	static void EndUpdate(void);
+
+	// Start the warm-up again, e.g. when a level is loaded
+	static void ResetSteadyState(void);
+	// Set the number of frames after a reset before the update must stop allocating
+	static void SetWarmupFrames(const unsigned int uiWarmupFrames);
+	// Check if the warm-up is over
+	static bool IsSteady(void);
+
+	// Set the tag of the allocations of this thread. Returns the previous tag.
+	static TAG SetTag(const TAG eTag);
+	// Get the name of a tag
+	static const char* GetTagName(const TAG eTag);
+
+	// Count an allocation. This is called by operator new.
+	static void RecordAllocation(const size_t uiBytes);
+	// Count a deallocation. This is called by operator delete.
+	static void RecordFree(void);
+
+	// Get the number of allocations of a tag in the last frame
+	static unsigned int GetLastCount(const TAG eTag);
+	// Get the number of bytes allocated by a tag in the last frame
+	static size_t GetLastBytes(const TAG eTag);
+	// Get the number of allocations in the update of the last frame
+	static unsigned int GetLastUpdateCount(void);
+	// Get the number of bytes allocated in the update of the last frame
+	static size_t GetLastUpdateBytes(void);
+	// Get the number of deallocations in the last frame
+	static unsigned int GetLastFrees(void);
+
+	// Get the number of frames which have ended
+	static unsigned int GetNumFrames(void);
+	// Get the number of frames which allocated in their update after the warm-up
+	static unsigned int GetNumFlaggedFrames(void);
+
+	// Print the allocations of all the frames, by tag
+	static void PrintSummary(void);
+};
+
+// Counts the allocations of the rest of the enclosing block under a tag. Use ALLOCATION_SCOPE instead of declaring this directly.
+class CAllocationScope
+{
+public:
+	// Constructor
+	explicit CAllocationScope(const CAllocationTracker::TAG eTag)
+		: ePreviousTag(CAllocationTracker::SetTag(eTag))
+	{
+	}
+
+	// Destructor
+	~CAllocationScope(void)
+	{
+		CAllocationTracker::SetTag(ePreviousTag);
+	}
+
+protected:
+	// The tag of the enclosing scope
+	CAllocationTracker::TAG ePreviousTag;
+};
+
+// An STL allocator which counts the allocations of a container under a tag, wherever it allocates
+template <typename T, CAllocationTracker::TAG eTag>
+class CTaggedAllocator
+{
+public:
+	typedef T value_type;
+
+	// The allocator of another type, which the containers use for their nodes. The tag is not a type,
+	// so the default rebind of std::allocator_traits does not work.
+	template <typename U>
+	struct rebind
+	{
+		typedef CTaggedAllocator<U, eTag> other;
+	};
+
+	// Constructor
+	CTaggedAllocator(void)
+	{
+	}
+
+	// Constructor for the allocator of another type
+	template <typename U>
+	CTaggedAllocator(const CTaggedAllocator<U, eTag>&)
+	{
+	}
+
+	// Allocate memory for n values, counted under the tag
+	T* allocate(const size_t n)
+	{
+		CAllocationScope cAllocationScope(eTag);
+		return static_cast<T*>(::operator new(n * sizeof(T)));
+	}
+
+	// Free the memory
+	void deallocate(T* pMemory, const size_t)
+	{
+		::operator delete(pMemory);
+	}
+};
+
+// All the CTaggedAllocators use operator new, so memory from one can be freed by another
+template <typename T, typename U, CAllocationTracker::TAG eTag1, CAllocationTracker::TAG eTag2>
+bool operator==(const CTaggedAllocator<T, eTag1>&, const CTaggedAllocator<U, eTag2>&)
+{
+	return true;
+}
+
+template <typename T, typename U, CAllocationTracker::TAG eTag1, CAllocationTracker::TAG eTag2>
+bool operator!=(const CTaggedAllocator<T, eTag1>&, const CTaggedAllocator<U, eTag2>&)
+{
+	return false;
+}
+
+// A vector whose allocations are counted under a tag
+template <typename T, CAllocationTracker::TAG eTag>
+using CTaggedVector = std::vector<T, CTaggedAllocator<T, eTag>>;
+
+#ifndef DISABLE_ALLOCATION_TRACKER
+#define ALLOCATION_CONCAT_INNER(a, b) a##b
+#define ALLOCATION_CONCAT(a, b) ALLOCATION_CONCAT_INNER(a, b)
+#define ALLOCATION_SCOPE(tag) CAllocationScope ALLOCATION_CONCAT(cAllocationScope, __LINE__)(tag)
+#else
+#define ALLOCATION_SCOPE(tag)
+#endif
@@ -0,0 +1,215 @@
+/**
+ CBufferedWriter
+ */
+#include "BufferedWriter.h"
+
+#include <cstring> // memcpy
+
+// The definition of the constant, as it is bound to a reference in Open and in CCSVWriter
+const size_t CBufferedWriter::DEFAULT_CAPACITY;
+
+/**
+ @brief Constructor
+ */
+CBufferedWriter::CBufferedWriter()
+	: uiSize(0)
+	, uiBytesFlushed(0)
+	, bStreaming(false)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CBufferedWriter::~CBufferedWriter()
+{
+	Close();
+}
+
+/**
+ @brief Open a file for writing
+ @param filename A string containing the name of the output file
+ @param uiCapacity A const size_t containing the initial size of the buffer
+ @param bStreaming A const bool which is true if the buffer is to be flushed whenever it is full
+ @return true if the file was opened, else false
+ */
+bool CBufferedWriter::Open(const string& filename, const size_t uiCapacity, const bool bStreaming)
+{
+	// Close any file which was previously opened
+	Close();
+
+	// Binary mode so that the bytes in the buffer are written as-is
+	myFile.open(filename, ios::out | ios::trunc | ios::binary);
+	if (!myFile.is_open())
+		return false;
+
+	this->bStreaming = bStreaming;
+	vBuffer.resize(uiCapacity > 0 ? uiCapacity : DEFAULT_CAPACITY);
+	uiSize = 0;
+	uiBytesFlushed = 0;
+
+	return true;
+}
+
+/**
+ @brief Flush the buffer and close the file
+ @return true if all the data was written, else false
+ */
+bool CBufferedWriter::Close(void)
+{
+	if (!myFile.is_open())
+		return false;
+
+	bool bResult = Flush();
+	myFile.close();
+
+	// Release the buffer
+	vector<char>().swap(vBuffer);
+
+	return bResult;
+}
+
+/**
+ @brief Check if a file is opened
+ */
+bool CBufferedWriter::IsOpen(void) const
+{
+	return myFile.is_open();
+}
+
+/**
+ @brief Append an integer in decimal notation
+ @param iValue A const int containing the value to write
+ */
+void CBufferedWriter::WriteInt(const int iValue)
+{
+	// An int has at most 10 digits and a sign
+	Reserve(11);
+
+	// Work on the magnitude as unsigned, so that INT_MIN does not overflow
+	unsigned int uiValue = (iValue < 0) ? 0u - (unsigned int)iValue : (unsigned int)iValue;
+
+	// Write the digits backwards into a small scratch area
+	char arrDigits[10];
+	int iNumDigits = 0;
+	do
+	{
+		arrDigits[iNumDigits++] = (char)('0' + uiValue % 10);
+		uiValue /= 10;
+	} while (uiValue != 0);
+
+	char* pOut = &vBuffer[uiSize];
+	if (iValue < 0)
+		*pOut++ = '-';
+	while (iNumDigits > 0)
+		*pOut++ = arrDigits[--iNumDigits];
+
+	uiSize = pOut - &vBuffer[0];
+}
+
+/**
+ @brief Append a single character
+ @param cValue A const char containing the character to write
+ */
+void CBufferedWriter::WriteChar(const char cValue)
+{
+	Reserve(1);
+	vBuffer[uiSize++] = cValue;
+}
+
+/**
+ @brief Append a string
+ @param sValue A const string& containing the text to write
+ */
+void CBufferedWriter::WriteString(const string& sValue)
+{
+	if (sValue.empty())
+		return;
+
+	Reserve(sValue.size());
+	memcpy(&vBuffer[uiSize], sValue.data(), sValue.size());
+	uiSize += sValue.size();
+}
+
+/**
+ @brief Append raw bytes, e.g. of a binary file
+ @param pData A const void* pointing to the bytes to write
+ @param uiCount A const size_t containing the number of bytes to write
+ */
+void CBufferedWriter::WriteBytes(const void* pData, const size_t uiCount)
+{
+	if (uiCount == 0)
+		return;
+
+	Reserve(uiCount);
+	memcpy(&vBuffer[uiSize], pData, uiCount);
+	uiSize += uiCount;
+}
+
+/**
+ @brief Append a row of integers, separated by cSeparator and ended with a newline
+ @param arrValues A const int* pointing to the values to write
+ @param uiCount A const size_t containing the number of values in arrValues
+ @param cSeparator A const char which is written between 2 values
+ */
+void CBufferedWriter::WriteRow(const int* arrValues, const size_t uiCount, const char cSeparator)
+{
+	for (size_t i = 0; i < uiCount; i++)
+	{
+		if (i != 0)
+			WriteChar(cSeparator);
+		WriteInt(arrValues[i]);
+	}
+	WriteChar('\n');
+}
+
+/**
+ @brief Write the contents of the buffer to the file
+ @return true if the write was successful, else false
+ */
+bool CBufferedWriter::Flush(void)
+{
+	if (!myFile.is_open())
+		return false;
+
+	if (uiSize > 0)
+	{
+		myFile.write(&vBuffer[0], uiSize);
+		uiBytesFlushed += uiSize;
+		uiSize = 0;
+	}
+
+	return myFile.good();
+}
+
+/**
+ @brief Get the total number of bytes written, including bytes still in the buffer
+ */
+size_t CBufferedWriter::GetBytesWritten(void) const
+{
+	return uiBytesFlushed + uiSize;
+}
+
+/**
+ @brief Make sure there are at least uiBytes free in the buffer
+ @param uiBytes A const size_t containing the number of bytes needed
+ */
+void CBufferedWriter::Reserve(const size_t uiBytes)
+{
+	if (uiSize + uiBytes <= vBuffer.size())
+		return;
+
+	// In streaming mode, empty the buffer into the file first
+	if (bStreaming)
+	{
+		Flush();
+		if (uiSize + uiBytes <= vBuffer.size())
+			return;
+	}
+
+	// Otherwise grow the buffer geometrically
+	size_t uiNewSize = vBuffer.size() * 2;
+	if (uiNewSize < uiSize + uiBytes)
+		uiNewSize = uiSize + uiBytes;
+	vBuffer.resize(uiNewSize);
+}
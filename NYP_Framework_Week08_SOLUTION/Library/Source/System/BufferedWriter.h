@@ -0,0 +1,67 @@
+/**
+ CBufferedWriter
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+using namespace std;
+
+class CBufferedWriter
+{
+public:
+	// The default size of the buffer, in bytes
+	const static size_t DEFAULT_CAPACITY = 64 * 1024;
+
+	// Constructor
+	CBufferedWriter();
+	// Destructor
+	virtual ~CBufferedWriter();
+
+	// Open a file for writing
+	bool Open(	const string& filename,
+				const size_t uiCapacity = DEFAULT_CAPACITY,
+				const bool bStreaming = false);
+	// Flush the buffer and close the file
+	bool Close(void);
+
+	// Check if a file is opened
+	bool IsOpen(void) const;
+
+	// Append an integer in decimal notation
+	void WriteInt(const int iValue);
+	// Append a single character
+	void WriteChar(const char cValue);
+	// Append a string
+	void WriteString(const string& sValue);
+	// Append raw bytes, e.g. of a binary file
+	void WriteBytes(const void* pData, const size_t uiCount);
+	// Append a row of integers, separated by cSeparator and ended with a newline
+	void WriteRow(const int* arrValues, const size_t uiCount, const char cSeparator = ',');
+
+	// Write the contents of the buffer to the file
+	bool Flush(void);
+
+	// Get the total number of bytes written, including bytes still in the buffer
+	size_t GetBytesWritten(void) const;
+
+protected:
+	// The output file
+	ofstream myFile;
+
+	// The buffer storing the formatted text
+	vector<char> vBuffer;
+	// The number of bytes used in vBuffer
+	size_t uiSize;
+	// The number of bytes already flushed to the file
+	size_t uiBytesFlushed;
+
+	// Boolean flag to indicate if the buffer is flushed whenever it is full.
+	// If false, the buffer grows and the file is written in a single call when it is closed.
+	bool bStreaming;
+
+	// Make sure there are at least uiBytes free in the buffer
+	void Reserve(const size_t uiBytes);
+};
@@ -10,6 +10,9 @@
 #include <sstream> // stringstream
 #include "filesystem.h"
 
+// Include CProfiler
+#include "../TimeControl/Profiler.h"
+
 /**
  @brief Constructor
  */
@@ -31,6 +34,8 @@ CCSVReader::~CCSVReader()
 */
 vector<pair<string, vector<int>>> CCSVReader::read_csv_with_columnname(string filename)
 {
+	PROFILE_SCOPE("CSVReader::read_csv_with_columnname");
+
 	// Reads a CSV file into a vector of <string, vector<int>> pairs where
 	// each pair represents <column name, column values>
 
@@ -108,6 +113,8 @@ vector<pair<string, vector<int>>> CCSVReader::read_csv_with_columnname(string fi
 vector<vector<int>> CCSVReader::read_csv(	string filename, 
 											const int NUM_TILES_XAXIS, const int NUM_TILES_YAXIS)
 {
+	PROFILE_SCOPE("CSVReader::read_csv");
+
 	// The result of this CSV reading attempt
 	bool bResult = true;
 
@@ -9,11 +9,13 @@
 #include <stdexcept> // runtime_error
 #include <sstream> // stringstream
 #include "filesystem.h"
+#include "BufferedWriter.h"
 
 /**
  @brief Constructor
  */
 CCSVWriter::CCSVWriter()
+	: bStreaming(false)
 {
 }
 
@@ -30,40 +32,32 @@ CCSVWriter::~CCSVWriter()
 @param vector<pair<string, vector<int>>> A vector containing pairs of string and vector which represents the tile map
 @return A vector<vector<int>> variable
 */
-bool CCSVWriter::write_csv_with_columnname(string filename, vector<pair<string, vector<int>>> vData)
+bool CCSVWriter::write_csv_with_columnname(const string& filename, const vector<pair<string, vector<int>>>& vData)
 {
-	// The result of this CSV reading attempt
-	bool bResult = false;
+	// Estimate the size of the output, so that the buffer does not need to grow
+	size_t uiEstimatedSize = 0;
+	for (size_t i = 0; i < vData.size(); i++)
+		uiEstimatedSize += vData[i].second.size() * ESTIMATED_BYTES_PER_VALUE + 1;
 
-	// Create an input filestream
-	ofstream myFile(filename, ios::out | ios::trunc);
+	// Create an output buffer
+	CBufferedWriter cBufferedWriter;
 
 	// Make sure the file is open
-	if (!myFile.is_open()) throw runtime_error("Could not create file");
+	if (!cBufferedWriter.Open(filename, GetBufferCapacity(uiEstimatedSize), bStreaming))
+		throw runtime_error("Could not create file");
 
 	// Write all data including the column names
-	if (myFile.good())
+	vector<pair<string, vector<int>>>::const_iterator iterRow;
+	for (iterRow = vData.begin(); iterRow != vData.end(); iterRow++)
 	{
-		vector<pair<string, vector<int>>>::iterator iterRow;
-		for (iterRow = vData.begin(); iterRow != vData.end(); iterRow++)
-		{
-			vector<int>::iterator iterColumn;
-			for (iterColumn = iterRow->second.begin(); iterColumn != iterRow->second.end(); iterColumn++)
-			{
-				myFile << *iterColumn;
-				if (iterColumn != iterRow->second.end())
-					myFile << ",";
-			}
-			myFile << endl;
-		}
-		// Set the result to true
-		bResult = true;
+		if (iterRow->second.empty())
+			cBufferedWriter.WriteChar('\n');
+		else
+			cBufferedWriter.WriteRow(&iterRow->second[0], iterRow->second.size());
 	}
 
-	// Close file
-	myFile.close();
-
-	return bResult;
+	// Write the buffer to the file and close it
+	return cBufferedWriter.Close();
 }
 
 /**
@@ -74,57 +68,65 @@ bool CCSVWriter::write_csv_with_columnname(string filename, vector<pair<string,
  @param vector<pair<string, vector<int>>> A vector containing pairs of string and vector which represents the tile map
  @return A vector<vector<int>> variable
  */
-bool CCSVWriter::write_csv(	string filename, 
+bool CCSVWriter::write_csv(	const string& filename, 
 							const int NUM_TILES_XAXIS, const int NUM_TILES_YAXIS, 
-							vector<vector<int>> vData)
+							const vector<vector<int>>& vData)
 {
-	// The result of this CSV reading attempt
-	bool bResult = false;
+	// Check if the number of rows in vData matches the declared value in NUM_TILES_YAXIS
+	if ((vData.size() != NUM_TILES_YAXIS) || (vData.empty()))
+		return false;
+
+	// Check if the number of columns in vData matches the declared value in NUM_TILES_XAXIS
+	if (vData[0].size() != NUM_TILES_XAXIS)
+		return false;
 
-	// Create an input filestream
-	ofstream myFile(filename, ios::out | ios::trunc);
+	// Create an output buffer
+	CBufferedWriter cBufferedWriter;
 
 	// Make sure the file is open
-	try {
-		if (!myFile.is_open())
-			throw runtime_error("Could not open file");
-	}
-	catch (runtime_error e)
-	{
-		//cout << "Runtime error: " << e.what();
+	size_t uiEstimatedSize = (size_t)NUM_TILES_YAXIS * (NUM_TILES_XAXIS * ESTIMATED_BYTES_PER_VALUE + 1);
+	if (!cBufferedWriter.Open(filename, GetBufferCapacity(uiEstimatedSize), bStreaming))
 		return false;
-	}
 
-	// Write all data including the column names
-	if (myFile.good())
+	// Write all data
+	vector<vector<int>>::const_iterator iterRow;
+	for (iterRow = vData.begin(); iterRow != vData.end(); iterRow++)
 	{
-		// Check if the number of rows in vData matches the declared value in NUM_TILES_YAXIS
-		if (vData.size() == NUM_TILES_YAXIS)
-		{
-			vector<vector<int>>::iterator iterRow = vData.begin();
-
-			// Check if the number of columns in vData matches the declared value in NUM_TILES_XAXIS
-			if ((*iterRow).size() == NUM_TILES_XAXIS)
-			{
-				for (iterRow = vData.begin(); iterRow != vData.end(); iterRow++)
-				{
-					vector<int>::iterator iterColumn;
-					for (iterColumn = (*iterRow).begin(); iterColumn != (*iterRow).end(); iterColumn++)
-					{
-						myFile << *iterColumn;
-						if (iterColumn != (*iterRow).end())
-							myFile << ",";
-					}
-					myFile << endl;
-				}
-				// Set the result to true
-				bResult = true;
-			}
-		}
+		if ((*iterRow).empty())
+			cBufferedWriter.WriteChar('\n');
+		else
+			cBufferedWriter.WriteRow(&(*iterRow)[0], (*iterRow).size());
 	}
 
-	// Close file
-	myFile.close();
+	// Write the buffer to the file and close it
+	return cBufferedWriter.Close();
+}
+
+/**
+ @brief Set if the output is flushed in chunks instead of in a single write
+ @param bStreaming A const bool which is true if the output is to be flushed in chunks
+ */
+void CCSVWriter::SetStreaming(const bool bStreaming)
+{
+	this->bStreaming = bStreaming;
+}
+
+/**
+ @brief Get if the output is flushed in chunks instead of in a single write
+ */
+bool CCSVWriter::GetStreaming(void) const
+{
+	return bStreaming;
+}
 
-	return bResult;
+/**
+ @brief Get the size of the buffer to use for an output of this size
+ @param uiEstimatedSize A const size_t containing the estimated number of bytes to write
+ */
+size_t CCSVWriter::GetBufferCapacity(const size_t uiEstimatedSize) const
+{
+	// In streaming mode, the buffer is only a window into the output
+	if (bStreaming)
+		return CBufferedWriter::DEFAULT_CAPACITY;
+	return (uiEstimatedSize > 0) ? uiEstimatedSize : CBufferedWriter::DEFAULT_CAPACITY;
 }
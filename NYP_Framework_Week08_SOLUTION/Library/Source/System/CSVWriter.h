@@ -20,9 +20,24 @@ public:
 	virtual ~CCSVWriter();
 
 	// Write to a CSV file which contains column names
-	bool write_csv_with_columnname(string filename, vector<pair<string, vector<int>>> vData);
+	bool write_csv_with_columnname(const string& filename, const vector<pair<string, vector<int>>>& vData);
 	// Write to a CSV file
-	bool write_csv(	string filename, 
+	bool write_csv(	const string& filename, 
 					const int NUM_TILES_XAXIS, const int NUM_TILES_YAXIS, 
-					vector<vector<int>> vData);
+					const vector<vector<int>>& vData);
+
+	// Set if the output is flushed in chunks instead of in a single write
+	void SetStreaming(const bool bStreaming);
+	// Get if the output is flushed in chunks instead of in a single write
+	bool GetStreaming(void) const;
+
+protected:
+	// The number of bytes per value used to size the buffer, e.g. "101,"
+	const static size_t ESTIMATED_BYTES_PER_VALUE = 4;
+
+	// Boolean flag to indicate if the output is flushed in chunks, for very large grids
+	bool bStreaming;
+
+	// Get the size of the buffer to use for an output of this size
+	size_t GetBufferCapacity(const size_t uiEstimatedSize) const;
 };
\ No newline at end of file
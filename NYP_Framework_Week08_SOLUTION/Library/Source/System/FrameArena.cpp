@@ -0,0 +1,120 @@
+/**
+ CFrameArena
+ */
+#include "FrameArena.h"
+
+#include <cstring>
+
+// The definition of the constant, in case it is bound to a reference
+const size_t CFrameArena::DEFAULT_CAPACITY;
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CFrameArena::CFrameArena(void)
+	: pBlock(NULL)
+	, uiCapacity(0)
+	, uiOffset(0)
+	, uiOverflowBytes(0)
+	, uiPeak(0)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CFrameArena::~CFrameArena(void)
+{
+	Reset();
+	delete[] pBlock;
+	pBlock = NULL;
+}
+
+/**
+ @brief Allocate the block. The memory of the frame is freed.
+ @param uiCapacity A const size_t containing the size of the block, in bytes
+ */
+void CFrameArena::Init(const size_t uiCapacity)
+{
+	Reset();
+	delete[] pBlock;
+	pBlock = new char[uiCapacity];
+	this->uiCapacity = uiCapacity;
+}
+
+/**
+ @brief Allocate memory which is valid until the end of the frame
+ @param uiBytes A const size_t containing the number of bytes
+ @param uiAlignment A const size_t containing the alignment of the memory. It must be a power of 2.
+ @return A pointer to the memory
+ */
+void* CFrameArena::Allocate(const size_t uiBytes, const size_t uiAlignment)
+{
+	size_t uiStart = (uiOffset + uiAlignment - 1) & ~(uiAlignment - 1);
+	if (uiStart + uiBytes <= uiCapacity)
+	{
+		uiOffset = uiStart + uiBytes;
+		return pBlock + uiStart;
+	}
+
+	// The block is full, so use the heap for the rest of this frame. operator new is aligned for any type.
+	char* pMemory = new char[uiBytes > 0 ? uiBytes : 1];
+	vOverflow.push_back(pMemory);
+	uiOverflowBytes += uiBytes + uiAlignment;
+	return pMemory;
+}
+
+/**
+ @brief Free all the memory of the frame. If the block was too small, it is grown to fit this frame.
+ */
+void CFrameArena::Reset(void)
+{
+	size_t uiUsed = GetUsed();
+	if (uiUsed > uiPeak)
+		uiPeak = uiUsed;
+
+	for (size_t i = 0; i < vOverflow.size(); i++)
+		delete[] vOverflow[i];
+	vOverflow.clear();
+
+	if (uiOverflowBytes > 0)
+	{
+		// Grow the block by half as much again, so that it does not grow a little every frame
+		size_t uiNewCapacity = uiUsed + uiUsed / 2;
+		delete[] pBlock;
+		pBlock = new char[uiNewCapacity];
+		uiCapacity = uiNewCapacity;
+		uiOverflowBytes = 0;
+	}
+
+#ifdef _DEBUG
+	// Overwrite the memory of the frame, so that a container which outlived its frame is noticed
+	if (pBlock != NULL)
+		memset(pBlock, 0xCD, uiOffset);
+#endif
+	uiOffset = 0;
+}
+
+/**
+ @brief Get the number of bytes allocated in this frame
+ */
+size_t CFrameArena::GetUsed(void) const
+{
+	return uiOffset + uiOverflowBytes;
+}
+
+/**
+ @brief Get the largest number of bytes allocated in a frame
+ */
+size_t CFrameArena::GetPeak(void) const
+{
+	return uiPeak;
+}
+
+/**
+ @brief Get the size of the block, in bytes
+ */
+size_t CFrameArena::GetCapacity(void) const
+{
+	return uiCapacity;
+}
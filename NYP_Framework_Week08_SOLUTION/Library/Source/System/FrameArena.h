@@ -0,0 +1,117 @@
+/**
+ CFrameArena
+
+ A linear allocator for the temporary data of a frame, e.g. the candidates of a random choice.
+ Allocating moves a pointer forward in a block of memory, freeing does nothing, and the whole
+ block is reused after Reset is called at the end of the frame. So the temporaries cost nothing
+ to free and do not fragment the heap.
+
+ If a frame needs more than the block, the rest is allocated from the heap, and the block is
+ grown to fit at the next Reset, so the heap is only used until the arena has warmed up.
+
+ CFrameAllocator lets the STL containers allocate from the arena, e.g. CFrameVector<int>. Their
+ memory must not be used after the frame ends, so they must not be stored in a member.
+ The arena is not thread-safe, and must only be used by the thread which runs the frames.
+
+ Usage:
+	CFrameVector<int> vValues;				// freed when the frame ends
+	vValues.push_back(1);
+	...
+	CFrameArena::GetInstance()->Reset();	// once per frame, at the end
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+#include <cstddef>
+#include <vector>
+
+class CFrameArena : public CSingletonTemplate<CFrameArena>
+{
+	friend CSingletonTemplate<CFrameArena>;
+public:
+	// The default size of the block, in bytes
+	static const size_t DEFAULT_CAPACITY = 256 * 1024;
+
+	// Allocate the block
+	void Init(const size_t uiCapacity = DEFAULT_CAPACITY);
+
+	// Allocate memory which is valid until the end of the frame
+	void* Allocate(const size_t uiBytes, const size_t uiAlignment);
+	// Free all the memory of the frame
+	void Reset(void);
+
+	// Get the number of bytes allocated in this frame
+	size_t GetUsed(void) const;
+	// Get the largest number of bytes allocated in a frame
+	size_t GetPeak(void) const;
+	// Get the size of the block, in bytes
+	size_t GetCapacity(void) const;
+
+protected:
+	// The block, and the number of bytes used in it
+	char* pBlock;
+	size_t uiCapacity;
+	size_t uiOffset;
+
+	// The memory which did not fit in the block in this frame, and its size
+	std::vector<char*> vOverflow;
+	size_t uiOverflowBytes;
+
+	// The largest number of bytes allocated in a frame
+	size_t uiPeak;
+
+	// Constructor
+	CFrameArena(void);
+
+	// Destructor
+	virtual ~CFrameArena(void);
+};
+
+// An STL allocator which allocates from the CFrameArena
+template <typename T>
+class CFrameAllocator
+{
+public:
+	typedef T value_type;
+
+	// Constructor
+	CFrameAllocator(void)
+	{
+	}
+
+	// Constructor for the allocator of another type, which the containers use for their nodes
+	template <typename U>
+	CFrameAllocator(const CFrameAllocator<U>&)
+	{
+	}
+
+	// Allocate memory for n values
+	T* allocate(const size_t n)
+	{
+		return static_cast<T*>(CFrameArena::GetInstance()->Allocate(n * sizeof(T), alignof(T)));
+	}
+
+	// The memory is freed when the frame ends
+	void deallocate(T*, const size_t)
+	{
+	}
+};
+
+// All the CFrameAllocators allocate from the same arena, so memory from one can be freed by another
+template <typename T, typename U>
+bool operator==(const CFrameAllocator<T>&, const CFrameAllocator<U>&)
+{
+	return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const CFrameAllocator<T>&, const CFrameAllocator<U>&)
+{
+	return false;
+}
+
+// A vector which allocates from the CFrameArena
+template <typename T>
+using CFrameVector = std::vector<T, CFrameAllocator<T>>;
@@ -18,6 +18,9 @@ using namespace std;
 #include <includes/stb_image.h>
 #include "filesystem.h"
 
+// Include CProfiler
+#include "../TimeControl/Profiler.h"
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
@@ -45,6 +48,8 @@ bool CImageLoader::Init(void)
 */
 unsigned char * CImageLoader::Load(const char* filename, int& width, int& height, int& nrChannels, const bool bInvert)
 {
+	PROFILE_SCOPE("ImageLoader::Load");
+
 	// tell stb_image.h to flip loaded texture's on the y-axis.
 	stbi_set_flip_vertically_on_load(bInvert);
 
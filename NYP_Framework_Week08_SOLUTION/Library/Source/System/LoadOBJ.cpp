@@ -1,8 +1,21 @@
 #include <iostream>
 #include <fstream>
 #include <map>
+#include <string>
+#include <thread>
+#include <cstring>
+#include <cmath>
 
 #include "LoadOBJ.h"
+#include "MappedFile.h"
+
+// sscanf_s is only in the Microsoft C runtime. The formats below read no strings, so sscanf is the same.
+#ifndef _MSC_VER
+	#define sscanf_s sscanf
+#endif
+
+// Include CProfiler
+#include "../TimeControl/Profiler.h"
 
 bool LoadOBJ(
 	const char *file_path, 
@@ -11,6 +24,8 @@ bool LoadOBJ(
 	std::vector<glm::vec3> & out_normals
 )
 {
+	PROFILE_SCOPE("LoadOBJ");
+
 	std::ifstream fileStream(file_path, std::ios::binary);
 	if(!fileStream.is_open())
 	{
@@ -120,6 +135,386 @@ bool LoadOBJ(
 	return true;
 }
 
+// The smallest part of an OBJ file which is worth parsing in its own thread
+static const size_t MIN_OBJ_CHUNK_SIZE = 64 * 1024;
+
+// The records parsed from one part of an OBJ file
+struct OBJChunk
+{
+	// The part of the file to parse
+	const char* pBegin;
+	const char* pEnd;
+
+	// The v, vt and vn records in this part
+	std::vector<glm::vec3> vertices;
+	std::vector<glm::vec2> uvs;
+	std::vector<glm::vec3> normals;
+	// The 1-based indices of the triangles in this part
+	std::vector<unsigned> vertexIndices, uvIndices, normalIndices;
+	// The v/vt/vn triplets of the face being parsed, kept here to reuse its memory
+	std::vector<unsigned> faceVertices;
+
+	// The line which could not be parsed, or NULL
+	const char* pErrorLine;
+	const char* pErrorLineEnd;
+	// True if an index is outside of the merged v, vt or vn records
+	bool bBadIndex;
+
+	OBJChunk() : pBegin(NULL), pEnd(NULL), pErrorLine(NULL), pErrorLineEnd(NULL), bBadIndex(false) {}
+};
+
+static void SkipBlanks(const char*& p, const char* pEnd)
+{
+	while ((p < pEnd) && ((*p == ' ') || (*p == '\t')))
+		++p;
+}
+
+static bool IsDigit(const char c)
+{
+	return (c >= '0') && (c <= '9');
+}
+
+// Parse an unsigned decimal number. This avoids sscanf_s, which is slow and needs a null-terminated line.
+static bool ParseUInt(const char*& p, const char* pEnd, unsigned int& uiValue)
+{
+	if ((p >= pEnd) || (!IsDigit(*p)))
+		return false;
+
+	uiValue = 0;
+	while ((p < pEnd) && (IsDigit(*p)))
+	{
+		uiValue = uiValue * 10 + (unsigned int)(*p - '0');
+		++p;
+	}
+	return true;
+}
+
+// Parse a floating point number such as 1, -0.5, .25 or 1.5e-3
+static bool ParseFloat(const char*& p, const char* pEnd, float& fValue)
+{
+	SkipBlanks(p, pEnd);
+
+	bool bNegative = false;
+	if ((p < pEnd) && ((*p == '-') || (*p == '+')))
+	{
+		bNegative = (*p == '-');
+		++p;
+	}
+
+	double dValue = 0.0;
+	bool bHasDigits = false;
+	while ((p < pEnd) && (IsDigit(*p)))
+	{
+		dValue = dValue * 10.0 + (*p - '0');
+		bHasDigits = true;
+		++p;
+	}
+	if ((p < pEnd) && (*p == '.'))
+	{
+		++p;
+		double dScale = 1.0;
+		while ((p < pEnd) && (IsDigit(*p)))
+		{
+			dValue = dValue * 10.0 + (*p - '0');
+			dScale *= 10.0;
+			bHasDigits = true;
+			++p;
+		}
+		dValue /= dScale;
+	}
+	if (!bHasDigits)
+		return false;
+
+	if ((p < pEnd) && ((*p == 'e') || (*p == 'E')))
+	{
+		++p;
+		bool bNegativeExponent = false;
+		if ((p < pEnd) && ((*p == '-') || (*p == '+')))
+		{
+			bNegativeExponent = (*p == '-');
+			++p;
+		}
+		unsigned int uiExponent = 0;
+		if (!ParseUInt(p, pEnd, uiExponent))
+			return false;
+		dValue *= pow(10.0, bNegativeExponent ? -(double)uiExponent : (double)uiExponent);
+	}
+
+	fValue = (float)(bNegative ? -dValue : dValue);
+	return true;
+}
+
+// Parse a v/vt/vn triplet of a face
+static bool ParseFaceVertex(const char*& p, const char* pEnd,
+							unsigned int& vertexIndex, unsigned int& uvIndex, unsigned int& normalIndex)
+{
+	SkipBlanks(p, pEnd);
+	if (!ParseUInt(p, pEnd, vertexIndex) || (p >= pEnd) || (*p++ != '/'))
+		return false;
+	if (!ParseUInt(p, pEnd, uvIndex) || (p >= pEnd) || (*p++ != '/'))
+		return false;
+	return ParseUInt(p, pEnd, normalIndex);
+}
+
+// Add a triangle made of 3 of the vertices in chunk.faceVertices
+static void AddOBJTriangle(OBJChunk& chunk, const unsigned int a, const unsigned int b, const unsigned int c)
+{
+	const unsigned int arrCorners[3] = { a, b, c };
+	for (int i = 0; i < 3; ++i)
+	{
+		chunk.vertexIndices.push_back(chunk.faceVertices[arrCorners[i] * 3]);
+		chunk.uvIndices    .push_back(chunk.faceVertices[arrCorners[i] * 3 + 1]);
+		chunk.normalIndices.push_back(chunk.faceVertices[arrCorners[i] * 3 + 2]);
+	}
+}
+
+// Parse one line of an OBJ file into a chunk
+static bool ParseOBJLine(const char* p, const char* pEnd, OBJChunk& chunk)
+{
+	SkipBlanks(p, pEnd);
+	if (pEnd - p < 2)
+		return true;
+
+	if ((p[0] == 'v') && ((p[1] == ' ') || (p[1] == '\t')))
+	{
+		glm::vec3 vertex;
+		p += 1;
+		if (!ParseFloat(p, pEnd, vertex.x) || !ParseFloat(p, pEnd, vertex.y) || !ParseFloat(p, pEnd, vertex.z))
+			return false;
+		chunk.vertices.push_back(vertex);
+	}
+	else if ((p[0] == 'v') && (p[1] == 't'))
+	{
+		glm::vec2 tc;
+		p += 2;
+		if (!ParseFloat(p, pEnd, tc.x) || !ParseFloat(p, pEnd, tc.y))
+			return false;
+		chunk.uvs.push_back(tc);
+	}
+	else if ((p[0] == 'v') && (p[1] == 'n'))
+	{
+		glm::vec3 normal;
+		p += 2;
+		if (!ParseFloat(p, pEnd, normal.x) || !ParseFloat(p, pEnd, normal.y) || !ParseFloat(p, pEnd, normal.z))
+			return false;
+		chunk.normals.push_back(normal);
+	}
+	else if ((p[0] == 'f') && ((p[1] == ' ') || (p[1] == '\t')))
+	{
+		p += 1;
+
+		// Read all the v/vt/vn triplets of the polygon
+		chunk.faceVertices.clear();
+		for (;;)
+		{
+			SkipBlanks(p, pEnd);
+			if (p >= pEnd)
+				break;
+
+			unsigned int vertexIndex, uvIndex, normalIndex;
+			if (!ParseFaceVertex(p, pEnd, vertexIndex, uvIndex, normalIndex))
+				return false;
+			chunk.faceVertices.push_back(vertexIndex);
+			chunk.faceVertices.push_back(uvIndex);
+			chunk.faceVertices.push_back(normalIndex);
+		}
+
+		unsigned int uiNumVertices = (unsigned int)chunk.faceVertices.size() / 3;
+		if (uiNumVertices < 3)
+			return false;
+
+		if (uiNumVertices == 3) //triangle
+		{
+			AddOBJTriangle(chunk, 0, 1, 2);
+		}
+		else //quad, split the same way as LoadOBJ. LoadOBJ only reads the first 4 vertices of a larger polygon, so do the same.
+		{
+			AddOBJTriangle(chunk, 0, 1, 2);
+			AddOBJTriangle(chunk, 2, 3, 0);
+		}
+	}
+	return true;
+}
+
+// Parse all the lines of a chunk. Runs in a worker thread.
+static void ParseOBJChunk(OBJChunk* pChunk)
+{
+	const char* p = pChunk->pBegin;
+	while (p < pChunk->pEnd)
+	{
+		const char* pLineEnd = (const char*)memchr(p, '\n', pChunk->pEnd - p);
+		if (pLineEnd == NULL)
+			pLineEnd = pChunk->pEnd;
+
+		// Ignore the \r of Windows line endings
+		const char* pContentEnd = pLineEnd;
+		if ((pContentEnd > p) && (*(pContentEnd - 1) == '\r'))
+			--pContentEnd;
+
+		if (!ParseOBJLine(p, pContentEnd, *pChunk))
+		{
+			pChunk->pErrorLine = p;
+			pChunk->pErrorLineEnd = pContentEnd;
+			return;
+		}
+		p = pLineEnd + 1;
+	}
+}
+
+// Look up the attributes of the triangles of a chunk and write them at uiOffset. Runs in a worker thread.
+static void ExpandOBJChunk(	OBJChunk* pChunk, const size_t uiOffset,
+							const std::vector<glm::vec3>* pAllVertices,
+							const std::vector<glm::vec2>* pAllUVs,
+							const std::vector<glm::vec3>* pAllNormals,
+							std::vector<glm::vec3>* pOutVertices,
+							std::vector<glm::vec2>* pOutUVs,
+							std::vector<glm::vec3>* pOutNormals)
+{
+	for (size_t i = 0; i < pChunk->vertexIndices.size(); ++i)
+	{
+		unsigned int vertexIndex = pChunk->vertexIndices[i];
+		unsigned int uvIndex = pChunk->uvIndices[i];
+		unsigned int normalIndex = pChunk->normalIndices[i];
+
+		if ((vertexIndex == 0) || (vertexIndex > pAllVertices->size()) ||
+			(uvIndex == 0) || (uvIndex > pAllUVs->size()) ||
+			(normalIndex == 0) || (normalIndex > pAllNormals->size()))
+		{
+			pChunk->bBadIndex = true;
+			return;
+		}
+
+		(*pOutVertices)[uiOffset + i] = (*pAllVertices)[vertexIndex - 1];
+		(*pOutUVs)[uiOffset + i] = (*pAllUVs)[uvIndex - 1];
+		(*pOutNormals)[uiOffset + i] = (*pAllNormals)[normalIndex - 1];
+	}
+}
+
+bool LoadOBJParallel(
+	const char *file_path,
+	std::vector<glm::vec3> & out_vertices,
+	std::vector<glm::vec2> & out_uvs,
+	std::vector<glm::vec3> & out_normals,
+	unsigned int uiNumThreads
+)
+{
+	// Only the calling thread is timed, as CProfiler is not thread-safe
+	PROFILE_SCOPE("LoadOBJParallel");
+
+	CMappedFile cMappedFile;
+	if (!cMappedFile.Open(file_path))
+	{
+		std::cout << "Impossible to open " << file_path << ". Are you in the right directory ?\n";
+		return false;
+	}
+	const char* pFileBegin = (const char*)cMappedFile.GetData();
+	const char* pFileEnd = pFileBegin + cMappedFile.GetSize();
+
+	// Decide how many threads to use. Small files are not worth splitting.
+	if (uiNumThreads == 0)
+		uiNumThreads = std::thread::hardware_concurrency();
+	size_t uiMaxChunks = cMappedFile.GetSize() / MIN_OBJ_CHUNK_SIZE;
+	if (uiNumThreads > uiMaxChunks)
+		uiNumThreads = (unsigned int)uiMaxChunks;
+	if (uiNumThreads == 0)
+		uiNumThreads = 1;
+
+	// Split the file into chunks of about the same size, which start at the beginning of a line
+	std::vector<OBJChunk> chunks(uiNumThreads);
+	const char* pChunkBegin = pFileBegin;
+	for (unsigned int i = 0; i < uiNumThreads; ++i)
+	{
+		const char* pChunkEnd = pFileEnd;
+		if (i + 1 < uiNumThreads)
+		{
+			pChunkEnd = pFileBegin + cMappedFile.GetSize() / uiNumThreads * (i + 1);
+			if (pChunkEnd < pChunkBegin)
+				pChunkEnd = pChunkBegin;
+			const char* pNewLine = (const char*)memchr(pChunkEnd, '\n', pFileEnd - pChunkEnd);
+			pChunkEnd = (pNewLine == NULL) ? pFileEnd : pNewLine + 1;
+		}
+		chunks[i].pBegin = pChunkBegin;
+		chunks[i].pEnd = pChunkEnd;
+		pChunkBegin = pChunkEnd;
+	}
+
+	// Parse the chunks concurrently. The calling thread parses the first chunk.
+	std::vector<std::thread> threads;
+	for (unsigned int i = 1; i < uiNumThreads; ++i)
+		threads.push_back(std::thread(ParseOBJChunk, &chunks[i]));
+	ParseOBJChunk(&chunks[0]);
+	for (unsigned int i = 0; i < threads.size(); ++i)
+		threads[i].join();
+	threads.clear();
+
+	for (unsigned int i = 0; i < uiNumThreads; ++i)
+	{
+		if (chunks[i].pErrorLine)
+		{
+			std::cout << "Error line: " << std::string(chunks[i].pErrorLine, chunks[i].pErrorLineEnd) << std::endl;
+			std::cout << "File can't be read by parser\n";
+			return false;
+		}
+	}
+
+	// Merge the v, vt and vn records in file order, so that the 1-based indices in the f records
+	// refer to the same records as they would in a single-threaded parse
+	size_t uiTotalVertices = 0, uiTotalUVs = 0, uiTotalNormals = 0;
+	std::vector<size_t> triangleOffsets(uiNumThreads);
+	size_t uiTotalIndices = 0;
+	for (unsigned int i = 0; i < uiNumThreads; ++i)
+	{
+		uiTotalVertices += chunks[i].vertices.size();
+		uiTotalUVs += chunks[i].uvs.size();
+		uiTotalNormals += chunks[i].normals.size();
+		triangleOffsets[i] = uiTotalIndices;
+		uiTotalIndices += chunks[i].vertexIndices.size();
+	}
+
+	std::vector<glm::vec3> temp_vertices;
+	std::vector<glm::vec2> temp_uvs;
+	std::vector<glm::vec3> temp_normals;
+	temp_vertices.reserve(uiTotalVertices);
+	temp_uvs.reserve(uiTotalUVs);
+	temp_normals.reserve(uiTotalNormals);
+	for (unsigned int i = 0; i < uiNumThreads; ++i)
+	{
+		temp_vertices.insert(temp_vertices.end(), chunks[i].vertices.begin(), chunks[i].vertices.end());
+		temp_uvs.insert(temp_uvs.end(), chunks[i].uvs.begin(), chunks[i].uvs.end());
+		temp_normals.insert(temp_normals.end(), chunks[i].normals.begin(), chunks[i].normals.end());
+	}
+
+	// Expand the triangles concurrently. Each chunk writes to its own range of the output.
+	size_t uiFirstOutput = out_vertices.size();
+	out_vertices.resize(uiFirstOutput + uiTotalIndices);
+	out_uvs.resize(uiFirstOutput + uiTotalIndices);
+	out_normals.resize(uiFirstOutput + uiTotalIndices);
+	for (unsigned int i = 1; i < uiNumThreads; ++i)
+		threads.push_back(std::thread(ExpandOBJChunk, &chunks[i], uiFirstOutput + triangleOffsets[i],
+									  &temp_vertices, &temp_uvs, &temp_normals,
+									  &out_vertices, &out_uvs, &out_normals));
+	ExpandOBJChunk(&chunks[0], uiFirstOutput + triangleOffsets[0],
+				   &temp_vertices, &temp_uvs, &temp_normals,
+				   &out_vertices, &out_uvs, &out_normals);
+	for (unsigned int i = 0; i < threads.size(); ++i)
+		threads[i].join();
+
+	for (unsigned int i = 0; i < uiNumThreads; ++i)
+	{
+		if (chunks[i].bBadIndex)
+		{
+			out_vertices.resize(uiFirstOutput);
+			out_uvs.resize(uiFirstOutput);
+			out_normals.resize(uiFirstOutput);
+			std::cout << "Invalid index in " << file_path << std::endl;
+			std::cout << "File can't be read by parser\n";
+			return false;
+		}
+	}
+
+	return true;
+}
+
 struct PackedVertex{
 	glm::vec3 position;
 	glm::vec2 uv;
@@ -131,10 +526,10 @@ struct PackedVertex{
 
 bool getSimilarVertexIndex_fast( 
 	PackedVertex & packed, 
-	std::map<PackedVertex, unsigned short> & VertexToOutIndex,
-	unsigned short & result
+	std::map<PackedVertex, unsigned> & VertexToOutIndex,
+	unsigned & result
 ){
-	std::map<PackedVertex, unsigned short>::iterator it = VertexToOutIndex.find(packed);
+	std::map<PackedVertex, unsigned>::iterator it = VertexToOutIndex.find(packed);
 	if(it == VertexToOutIndex.end())
 	{
 		return false;
@@ -152,10 +547,10 @@ void IndexVBO(
 	std::vector<glm::vec3> & in_normals,
 
 	std::vector<unsigned> & out_indices,
-	std::vector<Vertex> & out_vertices
+	std::vector<IndexedVertex> & out_vertices
 )
 {
-	std::map<PackedVertex,unsigned short> VertexToOutIndex;
+	std::map<PackedVertex,unsigned> VertexToOutIndex;
 
 	// For each input vertex
 	for(unsigned int i = 0; i < in_vertices.size(); ++i) 
@@ -164,7 +559,7 @@ void IndexVBO(
 		PackedVertex packed = {in_vertices[i], in_uvs[i], in_normals[i]};
 
 		// Try to find a similar vertex in out_XXXX
-		unsigned short index;
+		unsigned index;
 		bool found = getSimilarVertexIndex_fast( packed, VertexToOutIndex, index);
 
 		if ( found )
@@ -175,7 +570,7 @@ void IndexVBO(
 		else
 		{ 
 			// If not, it needs to be added in the output data.
-			Vertex v;
+			IndexedVertex v;
 			v.pos = glm::vec3(in_vertices[i].x, in_vertices[i].y, in_vertices[i].z);
 			v.texCoord = glm::vec2(in_uvs[i].x, in_uvs[i].y);
 			v.normal = glm::vec3(in_normals[i].x, in_normals[i].y, in_normals[i].z);
@@ -4,12 +4,12 @@
 #include <includes/glm.hpp>
 #include <vector>
 
-struct Vertex
+struct IndexedVertex
 {
 	glm::vec3 pos;
 	glm::vec3 normal;
 	glm::vec2 texCoord;
-	Vertex() {}
+	IndexedVertex() {}
 };
 
 bool LoadOBJ(
@@ -19,13 +19,24 @@ bool LoadOBJ(
 	std::vector<glm::vec3> & out_normals
 );
 
+// Parse an OBJ file with several threads. The output is the same as LoadOBJ, including
+// faces with more than 4 vertices, which are cut short to their first 4 vertices by both.
+// uiNumThreads is the maximum number of threads to use; 0 uses one per hardware thread.
+bool LoadOBJParallel(
+	const char *file_path,
+	std::vector<glm::vec3> & out_vertices,
+	std::vector<glm::vec2> & out_uvs,
+	std::vector<glm::vec3> & out_normals,
+	unsigned int uiNumThreads = 0
+);
+
 void IndexVBO(
 	std::vector<glm::vec3> & in_vertices,
 	std::vector<glm::vec2> & in_uvs,
 	std::vector<glm::vec3> & in_normals,
 
 	std::vector<unsigned> & out_indices,
-	std::vector<Vertex> & out_vertices
+	std::vector<IndexedVertex> & out_vertices
 );
 
 #endif
\ No newline at end of file
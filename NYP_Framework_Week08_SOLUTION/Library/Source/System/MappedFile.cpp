@@ -0,0 +1,143 @@
+/**
+ CMappedFile
+ */
+#include "MappedFile.h"
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+/**
+ @brief Constructor
+ */
+CMappedFile::CMappedFile(void)
+	: pData(NULL)
+	, uiSize(0)
+#ifdef _WIN32
+	, hFile(INVALID_HANDLE_VALUE)
+	, hMapping(NULL)
+#else
+	, iFileDescriptor(-1)
+#endif
+{
+}
+
+/**
+ @brief Destructor
+ */
+CMappedFile::~CMappedFile(void)
+{
+	Close();
+}
+
+/**
+ @brief Map a file into memory as read-only
+ @param file_path A const char* containing the name of the file
+ @return true if the file was mapped, else false
+ */
+bool CMappedFile::Open(const char* file_path)
+{
+	Close();
+
+#ifdef _WIN32
+	hFile = CreateFileA(file_path, GENERIC_READ, FILE_SHARE_READ, NULL,
+						OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER liSize;
+	if ((GetFileSizeEx(hFile, &liSize) == FALSE) || (liSize.QuadPart == 0))
+	{
+		Close();
+		return false;
+	}
+	uiSize = (size_t)liSize.QuadPart;
+
+	hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (hMapping == NULL)
+	{
+		Close();
+		return false;
+	}
+
+	pData = (const unsigned char*)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+#else
+	iFileDescriptor = open(file_path, O_RDONLY);
+	if (iFileDescriptor < 0)
+		return false;
+
+	struct stat sFileInfo;
+	if ((fstat(iFileDescriptor, &sFileInfo) != 0) || (sFileInfo.st_size == 0))
+	{
+		Close();
+		return false;
+	}
+	uiSize = (size_t)sFileInfo.st_size;
+
+	void* pMapping = mmap(NULL, uiSize, PROT_READ, MAP_PRIVATE, iFileDescriptor, 0);
+	pData = (pMapping == MAP_FAILED) ? NULL : (const unsigned char*)pMapping;
+#endif
+
+	if (pData == NULL)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ @brief Unmap the file
+ */
+void CMappedFile::Close(void)
+{
+#ifdef _WIN32
+	if (pData)
+		UnmapViewOfFile(pData);
+	if (hMapping)
+		CloseHandle(hMapping);
+	if (hFile != INVALID_HANDLE_VALUE)
+		CloseHandle(hFile);
+	hMapping = NULL;
+	hFile = INVALID_HANDLE_VALUE;
+#else
+	if (pData)
+		munmap((void*)pData, uiSize);
+	if (iFileDescriptor >= 0)
+		close(iFileDescriptor);
+	iFileDescriptor = -1;
+#endif
+
+	pData = NULL;
+	uiSize = 0;
+}
+
+/**
+ @brief Check if a file is mapped
+ */
+bool CMappedFile::IsOpen(void) const
+{
+	return pData != NULL;
+}
+
+/**
+ @brief Get the contents of the file
+ */
+const unsigned char* CMappedFile::GetData(void) const
+{
+	return pData;
+}
+
+/**
+ @brief Get the size of the file in bytes
+ */
+size_t CMappedFile::GetSize(void) const
+{
+	return uiSize;
+}
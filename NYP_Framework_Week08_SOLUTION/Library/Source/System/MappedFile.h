@@ -0,0 +1,47 @@
+/**
+ CMappedFile
+ */
+#pragma once
+
+#include <cstddef>
+
+class CMappedFile
+{
+public:
+	// Constructor
+	CMappedFile(void);
+	// Destructor
+	virtual ~CMappedFile(void);
+
+	// Map a file into memory as read-only
+	bool Open(const char* file_path);
+	// Unmap the file
+	void Close(void);
+
+	// Check if a file is mapped
+	bool IsOpen(void) const;
+
+	// Get the contents of the file
+	const unsigned char* GetData(void) const;
+	// Get the size of the file in bytes
+	size_t GetSize(void) const;
+
+protected:
+	// The start of the mapped file
+	const unsigned char* pData;
+	// The size of the mapped file in bytes
+	size_t uiSize;
+
+	// The handles to the file and its mapping
+#ifdef _WIN32
+	void* hFile;
+	void* hMapping;
+#else
+	int iFileDescriptor;
+#endif
+
+private:
+	// A mapped file cannot be copied
+	CMappedFile(const CMappedFile&);
+	CMappedFile& operator=(const CMappedFile&);
+};
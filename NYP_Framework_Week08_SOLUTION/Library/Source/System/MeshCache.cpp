@@ -0,0 +1,397 @@
+/**
+ CMeshCache
+ */
+#include "MeshCache.h"
+
+// Include MappedFile
+#include "MappedFile.h"
+// Include MeshSimplifier
+#include "MeshSimplifier.h"
+// Include CProfiler
+#include "../TimeControl/Profiler.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstddef>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+// The version of the cache file format. Increase this when SHeader, IndexedVertex or the simplifier changes.
+static const unsigned int MESH_CACHE_VERSION = 2;
+
+const char* const CMeshCache::CACHE_EXTENSION = ".mesh";
+
+/**
+ @brief Load an indexed mesh, from the cache file if it is up to date, else from the OBJ file
+ @param file_path A const char* containing the name of the OBJ file
+ @param out_vertices A std::vector<IndexedVertex>& which will receive the unique vertices
+ @param out_indices A std::vector<unsigned>& which will receive the triangle indices
+ @return true if the mesh was loaded, else false
+ */
+bool CMeshCache::Load(	const char* file_path,
+						std::vector<IndexedVertex>& out_vertices,
+						std::vector<unsigned>& out_indices)
+{
+	PROFILE_SCOPE("MeshCache::Load");
+
+	if (Read(file_path, GetCachePath(file_path), out_vertices, out_indices))
+		return true;
+
+	// The cache file is missing or out of date, so cook the OBJ file again
+	return Cook(file_path, out_vertices, out_indices);
+}
+
+/**
+ @brief Load an indexed mesh and upload it into new OpenGL buffers
+ @param file_path A const char* containing the name of the OBJ file
+ @param VAO A GLuint& which will receive the vertex array object
+ @param VBO A GLuint& which will receive the vertex buffer
+ @param IBO A GLuint& which will receive the index buffer
+ @param index_buffer_size A GLuint& which will receive the number of indices
+ @return true if the mesh was loaded, else false
+ */
+bool CMeshCache::LoadToGPU(	const char* file_path,
+							GLuint& VAO, GLuint& VBO, GLuint& IBO,
+							GLuint& index_buffer_size)
+{
+	SHeader sHeader;
+	if (MakeHeader(file_path, sHeader) == false)
+	{
+		std::cout << "Impossible to open " << file_path << ". Are you in the right directory ?\n";
+		return false;
+	}
+
+	// If the cache file is up to date, upload straight from the mapped file
+	CMappedFile cMappedFile;
+	if ((cMappedFile.Open(GetCachePath(file_path).c_str())) &&
+		(IsValid(sHeader, cMappedFile.GetData(), cMappedFile.GetSize())))
+	{
+		const SHeader* pHeader = (const SHeader*)cMappedFile.GetData();
+		const IndexedVertex* arrVertices = (const IndexedVertex*)(cMappedFile.GetData() + sizeof(SHeader));
+		const unsigned* arrIndices = (const unsigned*)(arrVertices + pHeader->uiNumVertices);
+
+		Upload(arrVertices, pHeader->uiNumVertices, arrIndices, pHeader->uiNumIndices, VAO, VBO, IBO);
+		index_buffer_size = pHeader->uiNumIndices;
+		return true;
+	}
+	cMappedFile.Close();
+
+	// Otherwise cook the OBJ file and upload the result
+	std::vector<IndexedVertex> vertices;
+	std::vector<unsigned> indices;
+	if (Cook(file_path, vertices, indices) == false)
+		return false;
+
+	Upload(	vertices.data(), (unsigned)vertices.size(),
+			indices.data(), (unsigned)indices.size(),
+			VAO, VBO, IBO);
+	index_buffer_size = (GLuint)indices.size();
+	return true;
+}
+
+/**
+ @brief Parse an OBJ file with LoadOBJParallel, weld its duplicate vertices and write the cache file
+ @param file_path A const char* containing the name of the OBJ file
+ @param out_vertices A std::vector<IndexedVertex>& which will receive the unique vertices
+ @param out_indices A std::vector<unsigned>& which will receive the triangle indices
+ @return true if the OBJ file was parsed, else false. Failing to write the cache is not an error.
+ */
+bool CMeshCache::Cook(	const char* file_path,
+						std::vector<IndexedVertex>& out_vertices,
+						std::vector<unsigned>& out_indices)
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<glm::vec2> uvs;
+	std::vector<glm::vec3> normals;
+	if (LoadOBJParallel(file_path, vertices, uvs, normals) == false)
+		return false;
+
+	out_vertices.clear();
+	out_indices.clear();
+	IndexVBO(vertices, uvs, normals, out_indices, out_vertices);
+
+	if (Write(file_path, GetCachePath(file_path), out_vertices, out_indices) == false)
+	{
+		std::cout << "Unable to write the mesh cache for " << file_path << std::endl;
+	}
+
+	return true;
+}
+
+/**
+ @brief Load a simplified mesh with about fRatio of the triangles of the OBJ file
+ @param file_path A const char* containing the name of the OBJ file
+ @param fRatio A const float containing the fraction of the triangles to keep
+ @param out_vertices A std::vector<IndexedVertex>& which will receive the unique vertices
+ @param out_indices A std::vector<unsigned>& which will receive the triangle indices
+ @param bUseCache A const bool which is true if the simplified mesh is to be read from and written to a cache file
+ @return true if the mesh was loaded, else false
+ */
+bool CMeshCache::LoadSimplified(const char* file_path, const float fRatio,
+								std::vector<IndexedVertex>& out_vertices,
+								std::vector<unsigned>& out_indices,
+								const bool bUseCache)
+{
+	std::string sCachePath = GetCachePath(file_path, fRatio);
+	if ((bUseCache) && (Read(file_path, sCachePath, out_vertices, out_indices)))
+		return true;
+
+	std::vector<IndexedVertex> vertices;
+	std::vector<unsigned> indices;
+	if (Load(file_path, vertices, indices) == false)
+		return false;
+
+	return Simplify(file_path, sCachePath, vertices, indices, fRatio, out_vertices, out_indices, bUseCache);
+}
+
+/**
+ @brief Load a simplified mesh with about fRatio of the triangles of a mesh which was already loaded from the OBJ file.
+		Use this instead of the other LoadSimplified when several levels are made from the same OBJ file.
+ @param file_path A const char* containing the name of the OBJ file, which is used to name and validate the cache file
+ @param in_vertices A const std::vector<IndexedVertex>& containing the unique vertices loaded by Load
+ @param in_indices A const std::vector<unsigned>& containing the triangle indices loaded by Load
+ @param fRatio A const float containing the fraction of the triangles to keep
+ @param out_vertices A std::vector<IndexedVertex>& which will receive the unique vertices
+ @param out_indices A std::vector<unsigned>& which will receive the triangle indices
+ @param bUseCache A const bool which is true if the simplified mesh is to be read from and written to a cache file
+ @return true if the mesh was loaded, else false
+ */
+bool CMeshCache::LoadSimplified(const char* file_path,
+								const std::vector<IndexedVertex>& in_vertices,
+								const std::vector<unsigned>& in_indices,
+								const float fRatio,
+								std::vector<IndexedVertex>& out_vertices,
+								std::vector<unsigned>& out_indices,
+								const bool bUseCache)
+{
+	std::string sCachePath = GetCachePath(file_path, fRatio);
+	if ((bUseCache) && (Read(file_path, sCachePath, out_vertices, out_indices)))
+		return true;
+
+	return Simplify(file_path, sCachePath, in_vertices, in_indices, fRatio, out_vertices, out_indices, bUseCache);
+}
+
+/**
+ @brief Load a simplified mesh and upload it into new OpenGL buffers
+ @param file_path A const char* containing the name of the OBJ file
+ @param fRatio A const float containing the fraction of the triangles to keep
+ @param VAO A GLuint& which will receive the vertex array object
+ @param VBO A GLuint& which will receive the vertex buffer
+ @param IBO A GLuint& which will receive the index buffer
+ @param index_buffer_size A GLuint& which will receive the number of indices
+ @param bUseCache A const bool which is true if the simplified mesh is to be read from and written to a cache file
+ @return true if the mesh was loaded, else false
+ */
+bool CMeshCache::LoadSimplifiedToGPU(	const char* file_path, const float fRatio,
+										GLuint& VAO, GLuint& VBO, GLuint& IBO,
+										GLuint& index_buffer_size,
+										const bool bUseCache)
+{
+	std::vector<IndexedVertex> vertices;
+	std::vector<unsigned> indices;
+	if (LoadSimplified(file_path, fRatio, vertices, indices, bUseCache) == false)
+		return false;
+
+	Upload(	vertices.data(), (unsigned)vertices.size(),
+			indices.data(), (unsigned)indices.size(),
+			VAO, VBO, IBO);
+	index_buffer_size = (GLuint)indices.size();
+	return true;
+}
+
+/**
+ @brief Get the name of the cache file for an OBJ file
+ @param file_path A const char* containing the name of the OBJ file
+ */
+std::string CMeshCache::GetCachePath(const char* file_path)
+{
+	return std::string(file_path) + CACHE_EXTENSION;
+}
+
+/**
+ @brief Get the name of the cache file for a simplified mesh, e.g. teapot.obj.lod50.mesh for half of the triangles
+ @param file_path A const char* containing the name of the OBJ file
+ @param fRatio A const float containing the fraction of the triangles to keep
+ */
+std::string CMeshCache::GetCachePath(const char* file_path, const float fRatio)
+{
+	int iPercent = (int)(fRatio * 100.0f + 0.5f);
+	return std::string(file_path) + ".lod" + std::to_string(iPercent) + CACHE_EXTENSION;
+}
+
+/**
+ @brief Upload an indexed mesh into new OpenGL buffers.
+		The attributes are at location 0 (position), 1 (normal) and 2 (texture coordinates).
+ */
+void CMeshCache::Upload(const IndexedVertex* arrVertices, const unsigned uiNumVertices,
+						const unsigned* arrIndices, const unsigned uiNumIndices,
+						GLuint& VAO, GLuint& VBO, GLuint& IBO)
+{
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &IBO);
+
+	glBindVertexArray(VAO);
+
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, uiNumVertices * sizeof(IndexedVertex), arrVertices, GL_STATIC_DRAW);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, uiNumIndices * sizeof(unsigned), arrIndices, GL_STATIC_DRAW);
+
+	// position attribute
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(IndexedVertex), (void*)offsetof(IndexedVertex, pos));
+	glEnableVertexAttribArray(0);
+	// normal attribute
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(IndexedVertex), (void*)offsetof(IndexedVertex, normal));
+	glEnableVertexAttribArray(1);
+	// texture coord attribute
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(IndexedVertex), (void*)offsetof(IndexedVertex, texCoord));
+	glEnableVertexAttribArray(2);
+
+	glBindVertexArray(0);
+}
+
+/**
+ @brief Fill in the header for an OBJ file
+ @param file_path A const char* containing the name of the OBJ file
+ @param sHeader A SHeader& which will receive the expected header
+ @return false if the OBJ file does not exist
+ */
+bool CMeshCache::MakeHeader(const char* file_path, SHeader& sHeader)
+{
+	struct stat sFileInfo;
+	if (stat(file_path, &sFileInfo) != 0)
+		return false;
+
+	memset(&sHeader, 0, sizeof(SHeader));
+	memcpy(sHeader.arrMagic, "NYPM", 4);
+	sHeader.uiVersion = MESH_CACHE_VERSION;
+	sHeader.uiVertexSize = sizeof(IndexedVertex);
+	sHeader.llSourceSize = (long long)sFileInfo.st_size;
+	sHeader.llSourceTime = (long long)sFileInfo.st_mtime;
+	return true;
+}
+
+/**
+ @brief Check if a cache file is valid for an OBJ file
+ @param sExpected A const SHeader& made by MakeHeader for the OBJ file
+ @param pData A const unsigned char* pointing to the contents of the cache file
+ @param uiSize A const size_t containing the size of the cache file
+ */
+bool CMeshCache::IsValid(const SHeader& sExpected, const unsigned char* pData, const size_t uiSize)
+{
+	if (uiSize < sizeof(SHeader))
+		return false;
+
+	const SHeader* pHeader = (const SHeader*)pData;
+	if ((memcmp(pHeader->arrMagic, sExpected.arrMagic, 4) != 0) ||
+		(pHeader->uiVersion != sExpected.uiVersion) ||
+		(pHeader->uiVertexSize != sExpected.uiVertexSize) ||
+		(pHeader->llSourceSize != sExpected.llSourceSize) ||
+		(pHeader->llSourceTime != sExpected.llSourceTime))
+		return false;
+
+	// Make sure the file was not truncated
+	size_t uiExpectedSize = sizeof(SHeader) +
+							(size_t)pHeader->uiNumVertices * sizeof(IndexedVertex) +
+							(size_t)pHeader->uiNumIndices * sizeof(unsigned);
+	return uiSize == uiExpectedSize;
+}
+
+/**
+ @brief Read a cache file if it is up to date
+ @param file_path A const char* containing the name of the OBJ file
+ @param cache_path A const std::string& containing the name of the cache file
+ @param out_vertices A std::vector<IndexedVertex>& which will receive the unique vertices
+ @param out_indices A std::vector<unsigned>& which will receive the triangle indices
+ @return true if the cache file was read, else false
+ */
+bool CMeshCache::Read(	const char* file_path, const std::string& cache_path,
+						std::vector<IndexedVertex>& out_vertices,
+						std::vector<unsigned>& out_indices)
+{
+	SHeader sHeader;
+	if (MakeHeader(file_path, sHeader) == false)
+		return false;
+
+	CMappedFile cMappedFile;
+	if ((cMappedFile.Open(cache_path.c_str()) == false) ||
+		(IsValid(sHeader, cMappedFile.GetData(), cMappedFile.GetSize()) == false))
+		return false;
+
+	const SHeader* pHeader = (const SHeader*)cMappedFile.GetData();
+	const IndexedVertex* arrVertices = (const IndexedVertex*)(cMappedFile.GetData() + sizeof(SHeader));
+	const unsigned* arrIndices = (const unsigned*)(arrVertices + pHeader->uiNumVertices);
+
+	out_vertices.assign(arrVertices, arrVertices + pHeader->uiNumVertices);
+	out_indices.assign(arrIndices, arrIndices + pHeader->uiNumIndices);
+	return true;
+}
+
+/**
+ @brief Simplify a mesh and write the result to a cache file
+ @param file_path A const char* containing the name of the OBJ file
+ @param cache_path A const std::string& containing the name of the cache file
+ @param in_vertices A const std::vector<IndexedVertex>& containing the unique vertices
+ @param in_indices A const std::vector<unsigned>& containing the triangle indices
+ @param fRatio A const float containing the fraction of the triangles to keep
+ @param out_vertices A std::vector<IndexedVertex>& which will receive the unique vertices
+ @param out_indices A std::vector<unsigned>& which will receive the triangle indices
+ @param bUseCache A const bool which is true if the simplified mesh is to be written to the cache file
+ @return true if the mesh was simplified, else false. Failing to write the cache is not an error.
+ */
+bool CMeshCache::Simplify(	const char* file_path, const std::string& cache_path,
+							const std::vector<IndexedVertex>& in_vertices,
+							const std::vector<unsigned>& in_indices,
+							const float fRatio,
+							std::vector<IndexedVertex>& out_vertices,
+							std::vector<unsigned>& out_indices,
+							const bool bUseCache)
+{
+	CMeshSimplifier cMeshSimplifier;
+	if (cMeshSimplifier.Simplify(in_vertices, in_indices, fRatio, out_vertices, out_indices) == false)
+	{
+		std::cout << "Unable to simplify " << file_path << std::endl;
+		return false;
+	}
+
+	if ((bUseCache) && (Write(file_path, cache_path, out_vertices, out_indices) == false))
+	{
+		std::cout << "Unable to write the mesh cache for " << file_path << std::endl;
+	}
+
+	return true;
+}
+
+/**
+ @brief Write a cache file
+ @param file_path A const char* containing the name of the OBJ file
+ @param cache_path A const std::string& containing the name of the cache file
+ @param vertices A const std::vector<IndexedVertex>& containing the unique vertices
+ @param indices A const std::vector<unsigned>& containing the triangle indices
+ @return true if the cache file was written, else false
+ */
+bool CMeshCache::Write(	const char* file_path, const std::string& cache_path,
+						const std::vector<IndexedVertex>& vertices,
+						const std::vector<unsigned>& indices)
+{
+	SHeader sHeader;
+	if (MakeHeader(file_path, sHeader) == false)
+		return false;
+	sHeader.uiNumVertices = (unsigned int)vertices.size();
+	sHeader.uiNumIndices = (unsigned int)indices.size();
+
+	std::ofstream fileStream(cache_path, std::ios::out | std::ios::trunc | std::ios::binary);
+	if (!fileStream.is_open())
+		return false;
+
+	fileStream.write((const char*)&sHeader, sizeof(SHeader));
+	if (!vertices.empty())
+		fileStream.write((const char*)vertices.data(), vertices.size() * sizeof(IndexedVertex));
+	if (!indices.empty())
+		fileStream.write((const char*)indices.data(), indices.size() * sizeof(unsigned));
+
+	return fileStream.good();
+}
@@ -0,0 +1,109 @@
+/**
+ CMeshCache
+
+ Cooks OBJ files into indexed meshes and stores them in a binary file next to the OBJ file,
+ e.g. OBJ/teapot.obj is cooked into OBJ/teapot.obj.mesh. The binary file is memory-mapped
+ and uploaded to OpenGL as-is on subsequent loads, so the OBJ file is only parsed once.
+ Simplified versions of the mesh are cached in the same way, e.g. OBJ/teapot.obj.lod50.mesh.
+ */
+#pragma once
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include LoadOBJ for the IndexedVertex structure
+#include "LoadOBJ.h"
+
+#include <string>
+#include <vector>
+
+class CMeshCache
+{
+public:
+	// The file extension which is appended to the OBJ file name
+	static const char* const CACHE_EXTENSION;
+
+	// Load an indexed mesh, from the cache file if it is up to date, else from the OBJ file
+	static bool Load(	const char* file_path,
+						std::vector<IndexedVertex>& out_vertices,
+						std::vector<unsigned>& out_indices);
+
+	// Load an indexed mesh and upload it into new OpenGL buffers
+	static bool LoadToGPU(	const char* file_path,
+							GLuint& VAO, GLuint& VBO, GLuint& IBO,
+							GLuint& index_buffer_size);
+
+	// Parse an OBJ file, weld its duplicate vertices and write the cache file
+	static bool Cook(	const char* file_path,
+						std::vector<IndexedVertex>& out_vertices,
+						std::vector<unsigned>& out_indices);
+
+	// Load a simplified mesh with about fRatio of the triangles of the OBJ file
+	static bool LoadSimplified(	const char* file_path, const float fRatio,
+								std::vector<IndexedVertex>& out_vertices,
+								std::vector<unsigned>& out_indices,
+								const bool bUseCache = true);
+	// Load a simplified mesh with about fRatio of the triangles of a mesh which was already loaded from the OBJ file
+	static bool LoadSimplified(	const char* file_path,
+								const std::vector<IndexedVertex>& in_vertices,
+								const std::vector<unsigned>& in_indices,
+								const float fRatio,
+								std::vector<IndexedVertex>& out_vertices,
+								std::vector<unsigned>& out_indices,
+								const bool bUseCache = true);
+
+	// Load a simplified mesh and upload it into new OpenGL buffers
+	static bool LoadSimplifiedToGPU(const char* file_path, const float fRatio,
+									GLuint& VAO, GLuint& VBO, GLuint& IBO,
+									GLuint& index_buffer_size,
+									const bool bUseCache = true);
+
+	// Get the name of the cache file for an OBJ file
+	static std::string GetCachePath(const char* file_path);
+	// Get the name of the cache file for a simplified mesh
+	static std::string GetCachePath(const char* file_path, const float fRatio);
+
+	// Upload an indexed mesh into new OpenGL buffers
+	static void Upload(	const IndexedVertex* arrVertices, const unsigned uiNumVertices,
+						const unsigned* arrIndices, const unsigned uiNumIndices,
+						GLuint& VAO, GLuint& VBO, GLuint& IBO);
+
+protected:
+	// The header at the start of a cache file
+	struct SHeader
+	{
+		char arrMagic[4];
+		unsigned int uiVersion;
+		unsigned int uiVertexSize;
+		unsigned int uiNumVertices;
+		unsigned int uiNumIndices;
+		unsigned int uiReserved;
+		// The size and modification time of the OBJ file when it was cooked
+		long long llSourceSize;
+		long long llSourceTime;
+	};
+
+	// Fill in the header for an OBJ file
+	static bool MakeHeader(const char* file_path, SHeader& sHeader);
+	// Check if a cache file is valid for an OBJ file
+	static bool IsValid(const SHeader& sExpected, const unsigned char* pData, const size_t uiSize);
+	// Read a cache file if it is up to date
+	static bool Read(	const char* file_path, const std::string& cache_path,
+						std::vector<IndexedVertex>& out_vertices,
+						std::vector<unsigned>& out_indices);
+	// Simplify a mesh and write the result to a cache file
+	static bool Simplify(	const char* file_path, const std::string& cache_path,
+							const std::vector<IndexedVertex>& in_vertices,
+							const std::vector<unsigned>& in_indices,
+							const float fRatio,
+							std::vector<IndexedVertex>& out_vertices,
+							std::vector<unsigned>& out_indices,
+							const bool bUseCache);
+	// Write a cache file
+	static bool Write(	const char* file_path, const std::string& cache_path,
+						const std::vector<IndexedVertex>& vertices,
+						const std::vector<unsigned>& indices);
+};
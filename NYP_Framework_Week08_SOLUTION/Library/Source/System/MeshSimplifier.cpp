@@ -0,0 +1,596 @@
+/**
+ CMeshSimplifier
+ */
+#include "MeshSimplifier.h"
+
+#include <map>
+#include <cstring>
+#include <algorithm>
+
+// The weight of the planes which keep open borders in place
+static const double BORDER_WEIGHT = 1000.0;
+// The weight of the difference in normals and texture coordinates when a collapse crosses a seam
+static const double SEAM_WEIGHT = 1.0;
+// The smallest cosine allowed between the normals of a triangle before and after a collapse
+static const double MIN_NORMAL_COSINE = 0.2;
+
+// Orders positions by their bits, so that only identical positions are welded
+struct PositionLess
+{
+	bool operator()(const glm::vec3& a, const glm::vec3& b) const
+	{
+		return memcmp(&a, &b, sizeof(glm::vec3)) < 0;
+	}
+};
+
+/**
+ @brief Constructor
+ */
+CMeshSimplifier::SQuadric::SQuadric(void)
+{
+	memset(a, 0, sizeof(a));
+}
+
+/**
+ @brief Add the squared distance to the plane dot(normal, p) + d = 0, multiplied by weight
+ */
+void CMeshSimplifier::SQuadric::AddPlane(const glm::dvec3& normal, const double d, const double weight)
+{
+	a[0] += weight * normal.x * normal.x;
+	a[1] += weight * normal.x * normal.y;
+	a[2] += weight * normal.x * normal.z;
+	a[3] += weight * normal.x * d;
+	a[4] += weight * normal.y * normal.y;
+	a[5] += weight * normal.y * normal.z;
+	a[6] += weight * normal.y * d;
+	a[7] += weight * normal.z * normal.z;
+	a[8] += weight * normal.z * d;
+	a[9] += weight * d * d;
+}
+
+/**
+ @brief Add another quadric to this quadric
+ */
+void CMeshSimplifier::SQuadric::Add(const SQuadric& other)
+{
+	for (int i = 0; i < 10; ++i)
+		a[i] += other.a[i];
+}
+
+/**
+ @brief Get the weighted sum of the squared distances of p to the planes of this quadric
+ */
+double CMeshSimplifier::SQuadric::Evaluate(const glm::vec3& p) const
+{
+	double x = p.x, y = p.y, z = p.z;
+	return	a[0] * x * x + 2.0 * a[1] * x * y + 2.0 * a[2] * x * z + 2.0 * a[3] * x +
+			a[4] * y * y + 2.0 * a[5] * y * z + 2.0 * a[6] * y +
+			a[7] * z * z + 2.0 * a[8] * z +
+			a[9];
+}
+
+/**
+ @brief Constructor
+ */
+CMeshSimplifier::CMeshSimplifier(void)
+	: pVertices(NULL)
+	, uiNumTriangles(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CMeshSimplifier::~CMeshSimplifier(void)
+{
+}
+
+/**
+ @brief Simplify an indexed mesh to about fTargetRatio of its triangles
+ @param in_vertices A const std::vector<IndexedVertex>& containing the vertices of the mesh
+ @param in_indices A const std::vector<unsigned>& containing the triangle indices of the mesh
+ @param fTargetRatio A const float containing the fraction of the triangles to keep, e.g. 0.5f keeps half
+ @param out_vertices A std::vector<IndexedVertex>& which will receive the vertices of the simplified mesh
+ @param out_indices A std::vector<unsigned>& which will receive the triangle indices of the simplified mesh
+ @return true if the mesh was simplified, else false
+ */
+bool CMeshSimplifier::Simplify(	const std::vector<IndexedVertex>& in_vertices,
+								const std::vector<unsigned>& in_indices,
+								const float fTargetRatio,
+								std::vector<IndexedVertex>& out_vertices,
+								std::vector<unsigned>& out_indices)
+{
+	out_vertices.clear();
+	out_indices.clear();
+
+	if ((in_indices.size() % 3 != 0) || (fTargetRatio <= 0.0f))
+		return false;
+	for (unsigned i = 0; i < in_indices.size(); ++i)
+	{
+		if (in_indices[i] >= in_vertices.size())
+			return false;
+	}
+
+	pVertices = &in_vertices;
+	Build(in_vertices, in_indices);
+	ComputeQuadrics();
+
+	unsigned uiTargetTriangles = (unsigned)(fTargetRatio * uiNumTriangles);
+
+	// Collapse the cheapest edge until there are few enough triangles left
+	for (unsigned i = 0; i < vPositions.size(); ++i)
+		PushCollapses(i);
+	while ((uiNumTriangles > uiTargetTriangles) && (!qCollapses.empty()))
+	{
+		SCollapse sCollapse = qCollapses.top();
+		qCollapses.pop();
+
+		// Skip collapses which were computed before one of the positions changed
+		if ((vRemoved[sCollapse.uiFrom]) || (vRemoved[sCollapse.uiTo]) ||
+			(sCollapse.uiFromVersion != vVersion[sCollapse.uiFrom]) ||
+			(sCollapse.uiToVersion != vVersion[sCollapse.uiTo]))
+			continue;
+
+		double dSeamError = 0.0;
+		if (CanCollapse(sCollapse.uiFrom, sCollapse.uiTo, dSeamError) == false)
+			continue;
+
+		// A collapse across a seam stretches the texture or the shading, so it is tried again later at a higher cost
+		if ((dSeamError > 0.0) && (sCollapse.bSeamCost == false))
+		{
+			double dEdgeLengthSquared = glm::dot(	vPositions[sCollapse.uiTo] - vPositions[sCollapse.uiFrom],
+													vPositions[sCollapse.uiTo] - vPositions[sCollapse.uiFrom]);
+			sCollapse.dCost += SEAM_WEIGHT * dSeamError * dEdgeLengthSquared * dEdgeLengthSquared;
+			sCollapse.bSeamCost = true;
+			qCollapses.push(sCollapse);
+			continue;
+		}
+
+		Collapse(sCollapse.uiFrom, sCollapse.uiTo);
+	}
+
+	// Copy the vertices which are still in use, in the order that they are first used
+	std::vector<unsigned> vNewIndex(in_vertices.size(), (unsigned)-1);
+	out_indices.reserve(uiNumTriangles * 3);
+	for (unsigned i = 0; i < vTriangles.size(); ++i)
+	{
+		if (vTriangles[i].bRemoved)
+			continue;
+
+		for (int j = 0; j < 3; ++j)
+		{
+			unsigned uiVertex = vTriangles[i].arrCorners[j];
+			if (vNewIndex[uiVertex] == (unsigned)-1)
+			{
+				vNewIndex[uiVertex] = (unsigned)out_vertices.size();
+				out_vertices.push_back(in_vertices[uiVertex]);
+			}
+			out_indices.push_back(vNewIndex[uiVertex]);
+		}
+	}
+
+	// Release the working memory
+	std::vector<glm::vec3>().swap(vPositions);
+	std::vector<unsigned>().swap(vVertexPosition);
+	std::vector<SQuadric>().swap(vQuadrics);
+	std::vector<std::vector<unsigned> >().swap(vPositionTriangles);
+	std::vector<unsigned>().swap(vVersion);
+	std::vector<bool>().swap(vRemoved);
+	std::vector<STriangle>().swap(vTriangles);
+	qCollapses = std::priority_queue<SCollapse, std::vector<SCollapse>, std::greater<SCollapse> >();
+	pVertices = NULL;
+
+	return true;
+}
+
+/**
+ @brief Build the positions and triangles from an indexed mesh.
+		Vertices with the same position but different normals or texture coordinates share a position.
+ */
+void CMeshSimplifier::Build(const std::vector<IndexedVertex>& in_vertices, const std::vector<unsigned>& in_indices)
+{
+	vPositions.clear();
+	vVertexPosition.resize(in_vertices.size());
+
+	std::map<glm::vec3, unsigned, PositionLess> PositionToIndex;
+	for (unsigned i = 0; i < in_vertices.size(); ++i)
+	{
+		std::map<glm::vec3, unsigned, PositionLess>::iterator it = PositionToIndex.find(in_vertices[i].pos);
+		if (it == PositionToIndex.end())
+		{
+			vVertexPosition[i] = (unsigned)vPositions.size();
+			PositionToIndex[in_vertices[i].pos] = (unsigned)vPositions.size();
+			vPositions.push_back(in_vertices[i].pos);
+		}
+		else
+		{
+			vVertexPosition[i] = it->second;
+		}
+	}
+
+	vPositionTriangles.assign(vPositions.size(), std::vector<unsigned>());
+	vVersion.assign(vPositions.size(), 0);
+	vRemoved.assign(vPositions.size(), false);
+
+	vTriangles.clear();
+	vTriangles.reserve(in_indices.size() / 3);
+	for (unsigned i = 0; i < in_indices.size(); i += 3)
+	{
+		STriangle triangle;
+		triangle.arrCorners[0] = in_indices[i];
+		triangle.arrCorners[1] = in_indices[i + 1];
+		triangle.arrCorners[2] = in_indices[i + 2];
+		triangle.bRemoved = false;
+
+		// Drop triangles which are already degenerate
+		unsigned a = vVertexPosition[triangle.arrCorners[0]];
+		unsigned b = vVertexPosition[triangle.arrCorners[1]];
+		unsigned c = vVertexPosition[triangle.arrCorners[2]];
+		if ((a == b) || (b == c) || (c == a))
+			continue;
+
+		unsigned uiTriangle = (unsigned)vTriangles.size();
+		vTriangles.push_back(triangle);
+		vPositionTriangles[a].push_back(uiTriangle);
+		vPositionTriangles[b].push_back(uiTriangle);
+		vPositionTriangles[c].push_back(uiTriangle);
+	}
+	uiNumTriangles = (unsigned)vTriangles.size();
+}
+
+/**
+ @brief Compute the error quadric of each position from the planes of its triangles,
+		plus planes which hold the open borders in place
+ */
+void CMeshSimplifier::ComputeQuadrics(void)
+{
+	vQuadrics.assign(vPositions.size(), SQuadric());
+
+	for (unsigned i = 0; i < vTriangles.size(); ++i)
+	{
+		unsigned arrPositions[3];
+		for (int j = 0; j < 3; ++j)
+			arrPositions[j] = GetCornerPosition(vTriangles[i], j);
+
+		glm::dvec3 p0(vPositions[arrPositions[0]]);
+		glm::dvec3 p1(vPositions[arrPositions[1]]);
+		glm::dvec3 p2(vPositions[arrPositions[2]]);
+		glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+		double dLength = glm::length(normal);
+		if (dLength <= 0.0)
+			continue;
+		normal /= dLength;
+
+		// Weigh each plane by the area of its triangle
+		SQuadric sQuadric;
+		sQuadric.AddPlane(normal, -glm::dot(normal, p0), dLength * 0.5);
+		for (int j = 0; j < 3; ++j)
+			vQuadrics[arrPositions[j]].Add(sQuadric);
+
+		// An edge which is used by only 1 triangle is on a border. Add a plane through the edge,
+		// perpendicular to the triangle, so that the border does not move inwards.
+		for (int j = 0; j < 3; ++j)
+		{
+			unsigned a = arrPositions[j];
+			unsigned b = arrPositions[(j + 1) % 3];
+			if (CountSharedTriangles(a, b) != 1)
+				continue;
+
+			glm::dvec3 pa(vPositions[a]);
+			glm::dvec3 edge = glm::dvec3(vPositions[b]) - pa;
+			glm::dvec3 borderNormal = glm::cross(edge, normal);
+			double dBorderLength = glm::length(borderNormal);
+			if (dBorderLength <= 0.0)
+				continue;
+			borderNormal /= dBorderLength;
+
+			SQuadric sBorder;
+			sBorder.AddPlane(borderNormal, -glm::dot(borderNormal, pa), BORDER_WEIGHT * glm::dot(edge, edge));
+			vQuadrics[a].Add(sBorder);
+			vQuadrics[b].Add(sBorder);
+		}
+	}
+}
+
+/**
+ @brief Add the collapses of the edges around a position to the queue, in both directions
+ */
+void CMeshSimplifier::PushCollapses(const unsigned uiPosition)
+{
+	GetNeighbours(uiPosition, vNeighboursFrom);
+	for (unsigned i = 0; i < vNeighboursFrom.size(); ++i)
+	{
+		PushCollapse(uiPosition, vNeighboursFrom[i]);
+		PushCollapse(vNeighboursFrom[i], uiPosition);
+	}
+}
+
+/**
+ @brief Add the collapse of uiFrom onto uiTo to the queue
+ */
+void CMeshSimplifier::PushCollapse(const unsigned uiFrom, const unsigned uiTo)
+{
+	SQuadric sQuadric = vQuadrics[uiFrom];
+	sQuadric.Add(vQuadrics[uiTo]);
+
+	SCollapse sCollapse;
+	sCollapse.dCost = sQuadric.Evaluate(vPositions[uiTo]);
+	sCollapse.uiFrom = uiFrom;
+	sCollapse.uiTo = uiTo;
+	sCollapse.uiFromVersion = vVersion[uiFrom];
+	sCollapse.uiToVersion = vVersion[uiTo];
+	sCollapse.bSeamCost = false;
+	qCollapses.push(sCollapse);
+}
+
+/**
+ @brief Get the position of a corner of a triangle
+ */
+unsigned CMeshSimplifier::GetCornerPosition(const STriangle& triangle, const int iCorner) const
+{
+	return vVertexPosition[triangle.arrCorners[iCorner]];
+}
+
+/**
+ @brief Check if a triangle uses a position
+ */
+bool CMeshSimplifier::HasPosition(const STriangle& triangle, const unsigned uiPosition) const
+{
+	return	(GetCornerPosition(triangle, 0) == uiPosition) ||
+			(GetCornerPosition(triangle, 1) == uiPosition) ||
+			(GetCornerPosition(triangle, 2) == uiPosition);
+}
+
+/**
+ @brief Get the positions which share a triangle with uiPosition
+ */
+void CMeshSimplifier::GetNeighbours(const unsigned uiPosition, std::vector<unsigned>& neighbours) const
+{
+	neighbours.clear();
+
+	const std::vector<unsigned>& triangles = vPositionTriangles[uiPosition];
+	for (unsigned i = 0; i < triangles.size(); ++i)
+	{
+		const STriangle& triangle = vTriangles[triangles[i]];
+		if (triangle.bRemoved)
+			continue;
+
+		for (int j = 0; j < 3; ++j)
+		{
+			unsigned uiNeighbour = GetCornerPosition(triangle, j);
+			if ((uiNeighbour != uiPosition) &&
+				(std::find(neighbours.begin(), neighbours.end(), uiNeighbour) == neighbours.end()))
+				neighbours.push_back(uiNeighbour);
+		}
+	}
+}
+
+/**
+ @brief Count the triangles which use both positions
+ */
+int CMeshSimplifier::CountSharedTriangles(const unsigned uiA, const unsigned uiB) const
+{
+	int iCount = 0;
+
+	const std::vector<unsigned>& triangles = vPositionTriangles[uiA];
+	for (unsigned i = 0; i < triangles.size(); ++i)
+	{
+		const STriangle& triangle = vTriangles[triangles[i]];
+		if ((!triangle.bRemoved) && (HasPosition(triangle, uiB)))
+			iCount++;
+	}
+	return iCount;
+}
+
+/**
+ @brief Get the difference between the normals and texture coordinates of 2 vertices
+ */
+double CMeshSimplifier::GetAttributeError(const unsigned uiVertexA, const unsigned uiVertexB) const
+{
+	const IndexedVertex& a = (*pVertices)[uiVertexA];
+	const IndexedVertex& b = (*pVertices)[uiVertexB];
+	return	glm::dot(glm::dvec3(a.normal - b.normal), glm::dvec3(a.normal - b.normal)) +
+			glm::dot(glm::dvec2(a.texCoord - b.texCoord), glm::dvec2(a.texCoord - b.texCoord));
+}
+
+/**
+ @brief Check if uiFrom can be collapsed onto uiTo without tearing or folding the mesh.
+		This also finds the vertex which replaces each vertex of uiFrom. A vertex of uiFrom which does not
+		share a collapsed triangle with uiTo, e.g. on the far side of a seam, is replaced by the vertex of uiTo
+		with the closest normal and texture coordinates. Open borders are kept in place by the border planes
+		in the quadrics instead of being locked.
+ @param dSeamError A double& which is set to the sum of the differences of the vertices which were replaced
+		that way, or 0 if their normals and texture coordinates match, e.g. along a seam which has matching
+		texture coordinates on both sides
+ */
+bool CMeshSimplifier::CanCollapse(const unsigned uiFrom, const unsigned uiTo, double& dSeamError)
+{
+	dSeamError = 0.0;
+
+	int iShared = CountSharedTriangles(uiFrom, uiTo);
+	if (iShared == 0)
+		return false;
+
+	// The positions may only share the neighbours opposite to their edge, else the mesh would pinch
+	GetNeighbours(uiFrom, vNeighboursFrom);
+	GetNeighbours(uiTo, vNeighboursTo);
+	int iCommon = 0;
+	for (unsigned i = 0; i < vNeighboursFrom.size(); ++i)
+	{
+		if (std::find(vNeighboursTo.begin(), vNeighboursTo.end(), vNeighboursFrom[i]) != vNeighboursTo.end())
+			iCommon++;
+	}
+	if (iCommon > iShared)
+		return false;
+
+	// Each vertex of uiFrom is replaced by the vertex of uiTo which it shares a collapsed triangle with.
+	// This keeps the texture coordinates on each side of a seam.
+	vRemapFrom.clear();
+	vRemapTo.clear();
+	const std::vector<unsigned>& triangles = vPositionTriangles[uiFrom];
+	for (unsigned i = 0; i < triangles.size(); ++i)
+	{
+		const STriangle& triangle = vTriangles[triangles[i]];
+		if ((triangle.bRemoved) || (!HasPosition(triangle, uiTo)))
+			continue;
+
+		unsigned uiVertexFrom = 0, uiVertexTo = 0;
+		for (int j = 0; j < 3; ++j)
+		{
+			if (GetCornerPosition(triangle, j) == uiFrom)
+				uiVertexFrom = triangle.arrCorners[j];
+			else if (GetCornerPosition(triangle, j) == uiTo)
+				uiVertexTo = triangle.arrCorners[j];
+		}
+		unsigned uiExisting;
+		if (!GetRemappedVertex(uiVertexFrom, uiExisting))
+		{
+			vRemapFrom.push_back(uiVertexFrom);
+			vRemapTo.push_back(uiVertexTo);
+		}
+	}
+
+	// Check the triangles which will remain after the collapse
+	const glm::dvec3 newPosition(vPositions[uiTo]);
+	for (unsigned i = 0; i < triangles.size(); ++i)
+	{
+		const STriangle& triangle = vTriangles[triangles[i]];
+		if ((triangle.bRemoved) || (HasPosition(triangle, uiTo)))
+			continue;
+
+		// Every vertex needs a replacement. Use the closest vertex of uiTo if none was found above.
+		unsigned uiRemapped;
+		for (int j = 0; j < 3; ++j)
+		{
+			if ((GetCornerPosition(triangle, j) != uiFrom) || (GetRemappedVertex(triangle.arrCorners[j], uiRemapped)))
+				continue;
+
+			double dError;
+			if (GetClosestVertex(uiTo, triangle.arrCorners[j], uiRemapped, dError) == false)
+				return false;
+			vRemapFrom.push_back(triangle.arrCorners[j]);
+			vRemapTo.push_back(uiRemapped);
+			dSeamError += dError;
+		}
+
+		// The triangle must not flip over
+		glm::dvec3 arrOld[3], arrNew[3];
+		for (int j = 0; j < 3; ++j)
+		{
+			arrOld[j] = glm::dvec3(vPositions[GetCornerPosition(triangle, j)]);
+			arrNew[j] = (GetCornerPosition(triangle, j) == uiFrom) ? newPosition : arrOld[j];
+		}
+		glm::dvec3 oldNormal = glm::cross(arrOld[1] - arrOld[0], arrOld[2] - arrOld[0]);
+		glm::dvec3 newNormal = glm::cross(arrNew[1] - arrNew[0], arrNew[2] - arrNew[0]);
+		double dOldLength = glm::length(oldNormal);
+		double dNewLength = glm::length(newNormal);
+		if ((dOldLength <= 0.0) || (dNewLength <= 0.0))
+			return false;
+		if (glm::dot(oldNormal, newNormal) < MIN_NORMAL_COSINE * dOldLength * dNewLength)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ @brief Collapse uiFrom onto uiTo. CanCollapse must have been called just before this.
+ */
+void CMeshSimplifier::Collapse(const unsigned uiFrom, const unsigned uiTo)
+{
+	std::vector<unsigned>& trianglesFrom = vPositionTriangles[uiFrom];
+	std::vector<unsigned>& trianglesTo = vPositionTriangles[uiTo];
+
+	for (unsigned i = 0; i < trianglesFrom.size(); ++i)
+	{
+		STriangle& triangle = vTriangles[trianglesFrom[i]];
+		if (triangle.bRemoved)
+			continue;
+
+		// The triangles on the collapsed edge disappear
+		if (HasPosition(triangle, uiTo))
+		{
+			triangle.bRemoved = true;
+			uiNumTriangles--;
+			continue;
+		}
+
+		// The other triangles now use the vertices of uiTo
+		for (int j = 0; j < 3; ++j)
+		{
+			if (GetCornerPosition(triangle, j) == uiFrom)
+				GetRemappedVertex(triangle.arrCorners[j], triangle.arrCorners[j]);
+		}
+		trianglesTo.push_back(trianglesFrom[i]);
+	}
+
+	// Forget the removed triangles of uiTo
+	unsigned uiKept = 0;
+	for (unsigned i = 0; i < trianglesTo.size(); ++i)
+	{
+		if (!vTriangles[trianglesTo[i]].bRemoved)
+			trianglesTo[uiKept++] = trianglesTo[i];
+	}
+	trianglesTo.resize(uiKept);
+	std::vector<unsigned>().swap(trianglesFrom);
+
+	vQuadrics[uiTo].Add(vQuadrics[uiFrom]);
+	vRemoved[uiFrom] = true;
+	vVersion[uiFrom]++;
+	vVersion[uiTo]++;
+
+	// The costs of the edges around uiTo have changed
+	PushCollapses(uiTo);
+}
+
+/**
+ @brief Find the vertex of a position with the closest normal and texture coordinates to a vertex
+ @param uiPosition A const unsigned containing the position
+ @param uiVertex A const unsigned containing the vertex to match
+ @param uiResult A unsigned& which is set to the closest vertex
+ @param dError A double& which is set to the difference between the vertices
+ @return true if the position has a vertex, else false
+ */
+bool CMeshSimplifier::GetClosestVertex(const unsigned uiPosition, const unsigned uiVertex, unsigned& uiResult, double& dError) const
+{
+	bool bFound = false;
+	const std::vector<unsigned>& triangles = vPositionTriangles[uiPosition];
+	for (unsigned i = 0; i < triangles.size(); ++i)
+	{
+		const STriangle& triangle = vTriangles[triangles[i]];
+		if (triangle.bRemoved)
+			continue;
+
+		for (int j = 0; j < 3; ++j)
+		{
+			if (GetCornerPosition(triangle, j) != uiPosition)
+				continue;
+
+			double dVertexError = GetAttributeError(uiVertex, triangle.arrCorners[j]);
+			if ((!bFound) || (dVertexError < dError))
+			{
+				uiResult = triangle.arrCorners[j];
+				dError = dVertexError;
+				bFound = true;
+			}
+		}
+	}
+	return bFound;
+}
+
+/**
+ @brief Find the vertex which replaces a vertex of the collapsed position
+ @return true if there is a replacement, else false
+ */
+bool CMeshSimplifier::GetRemappedVertex(const unsigned uiVertex, unsigned& uiResult) const
+{
+	for (unsigned i = 0; i < vRemapFrom.size(); ++i)
+	{
+		if (vRemapFrom[i] == uiVertex)
+		{
+			uiResult = vRemapTo[i];
+			return true;
+		}
+	}
+	return false;
+}
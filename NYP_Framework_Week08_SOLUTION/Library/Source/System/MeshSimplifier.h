@@ -0,0 +1,119 @@
+/**
+ CMeshSimplifier
+
+ Reduces the number of triangles of an indexed mesh by quadric error edge collapse
+ (Garland and Heckbert). Each collapse moves one vertex onto a neighbouring vertex, so no new
+ positions are created and the texture coordinates and normals of the remaining vertices are kept.
+ Open borders are held in place by their quadrics. A collapse which would stretch the texture or
+ the shading across a seam costs more, so seams are kept until the other edges have been used up.
+ */
+#pragma once
+
+// Include LoadOBJ for the IndexedVertex structure
+#include "LoadOBJ.h"
+
+#include <vector>
+#include <queue>
+#include <functional>
+
+class CMeshSimplifier
+{
+public:
+	// Constructor
+	CMeshSimplifier(void);
+	// Destructor
+	virtual ~CMeshSimplifier(void);
+
+	// Simplify an indexed mesh to about fTargetRatio of its triangles
+	bool Simplify(	const std::vector<IndexedVertex>& in_vertices,
+					const std::vector<unsigned>& in_indices,
+					const float fTargetRatio,
+					std::vector<IndexedVertex>& out_vertices,
+					std::vector<unsigned>& out_indices);
+
+protected:
+	// A symmetric 4x4 matrix which measures the squared distance of a point to a set of planes
+	struct SQuadric
+	{
+		double a[10];
+
+		SQuadric(void);
+		void AddPlane(const glm::dvec3& normal, const double d, const double weight);
+		void Add(const SQuadric& other);
+		double Evaluate(const glm::vec3& p) const;
+	};
+
+	// A triangle made of 3 indices into the input vertices
+	struct STriangle
+	{
+		unsigned arrCorners[3];
+		bool bRemoved;
+	};
+
+	// A candidate collapse of the position uiFrom onto the position uiTo
+	struct SCollapse
+	{
+		double dCost;
+		unsigned uiFrom, uiTo;
+		// The versions of both positions when the cost was computed
+		unsigned uiFromVersion, uiToVersion;
+		// True if the cost includes the difference of the vertices across a seam
+		bool bSeamCost;
+
+		bool operator>(const SCollapse& other) const { return dCost > other.dCost; }
+	};
+
+	// The vertices of the mesh which is being simplified
+	const std::vector<IndexedVertex>* pVertices;
+
+	// The unique positions of the mesh and the position of each input vertex
+	std::vector<glm::vec3> vPositions;
+	std::vector<unsigned> vVertexPosition;
+	// The error quadric of each position
+	std::vector<SQuadric> vQuadrics;
+	// The triangles which use each position. This may include removed triangles.
+	std::vector<std::vector<unsigned> > vPositionTriangles;
+	// Increased whenever a position changes, to discard outdated collapses
+	std::vector<unsigned> vVersion;
+	// True if the position was collapsed onto another position
+	std::vector<bool> vRemoved;
+
+	std::vector<STriangle> vTriangles;
+	unsigned uiNumTriangles;
+
+	// The candidate collapses, cheapest first
+	std::priority_queue<SCollapse, std::vector<SCollapse>, std::greater<SCollapse> > qCollapses;
+
+	// Scratch space which is reused between collapses
+	std::vector<unsigned> vNeighboursFrom, vNeighboursTo;
+	std::vector<unsigned> vRemapFrom, vRemapTo;
+
+	// Build the positions and triangles from an indexed mesh
+	void Build(const std::vector<IndexedVertex>& in_vertices, const std::vector<unsigned>& in_indices);
+	// Compute the error quadric of each position
+	void ComputeQuadrics(void);
+	// Add the collapses of the edges around a position to the queue
+	void PushCollapses(const unsigned uiPosition);
+	// Add the collapse of uiFrom onto uiTo to the queue
+	void PushCollapse(const unsigned uiFrom, const unsigned uiTo);
+
+	// Get the position of a corner of a triangle
+	unsigned GetCornerPosition(const STriangle& triangle, const int iCorner) const;
+	// Check if a triangle uses a position
+	bool HasPosition(const STriangle& triangle, const unsigned uiPosition) const;
+	// Get the positions which share a triangle with uiPosition
+	void GetNeighbours(const unsigned uiPosition, std::vector<unsigned>& neighbours) const;
+	// Count the triangles which use both positions
+	int CountSharedTriangles(const unsigned uiA, const unsigned uiB) const;
+	// Get the difference between the normals and texture coordinates of 2 vertices
+	double GetAttributeError(const unsigned uiVertexA, const unsigned uiVertexB) const;
+
+	// Check if uiFrom can be collapsed onto uiTo, and find the vertex which replaces each vertex of uiFrom
+	bool CanCollapse(const unsigned uiFrom, const unsigned uiTo, double& dSeamError);
+	// Collapse uiFrom onto uiTo
+	void Collapse(const unsigned uiFrom, const unsigned uiTo);
+	// Find the vertex of a position with the closest normal and texture coordinates to a vertex
+	bool GetClosestVertex(const unsigned uiPosition, const unsigned uiVertex, unsigned& uiResult, double& dError) const;
+	// Find the vertex which replaces a vertex of the collapsed position
+	bool GetRemappedVertex(const unsigned uiVertex, unsigned& uiResult) const;
+};
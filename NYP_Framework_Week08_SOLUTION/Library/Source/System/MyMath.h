@@ -185,6 +185,21 @@ Initialize Random Number Generator
 	{
 		srand (static_cast<unsigned> (time(0)));
 	}//end of InitRNG function
+
+/******************************************************************************/
+/*!
+\brief
+Initialize Random Number Generator with a seed, e.g. to repeat a recorded session
+
+\param seed - the seed
+ 
+\exception None
+\return None
+*/
+	inline void InitRNG(unsigned seed)
+	{
+		srand (seed);
+	}//end of InitRNG function
 	
 /******************************************************************************/
 /*!
@@ -1,13 +1,27 @@
 #include "FPSCounter.h"
+
+// Include CBufferedWriter
+#include "../System/BufferedWriter.h"
+
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 using namespace std;
 
+// The definition of the constant, as it is bound to a reference by the conditional operators below
+const unsigned int CFPSCounter::WINDOW_SIZE;
+
 CFPSCounter::CFPSCounter()
 	: dElapsedTime(0.0)
 	, nFrames(0)
 	, iFrameRate(0)
 	, dFrameTime(0.0)
+	, uiTotalFrames(0)
+	, dTotalTime(0.0)
+	, fSessionMin(0.0f)
+	, fSessionMax(0.0f)
 {
+	vSorted.reserve(WINDOW_SIZE);
 	Init();
 }
 
@@ -24,6 +38,15 @@ void CFPSCounter::Init(void)
 	nFrames = 0;
 	iFrameRate = 0;
 	dFrameTime = 60;
+
+	// Reset the statistics, but keep the hitch thresholds
+	fill(arrSamples, arrSamples + WINDOW_SIZE, 0.0f);
+	uiTotalFrames = 0;
+	dTotalTime = 0.0;
+	fSessionMin = 0.0f;
+	fSessionMax = 0.0f;
+	for (size_t i = 0; i < vHitchCounters.size(); i++)
+		vHitchCounters[i].uiCount = 0;
 }
 
 // Update the class instance
@@ -46,6 +69,23 @@ void CFPSCounter::Update(const double deltaTime)
 		nFrames = 0;
 		dElapsedTime = 0.0;
 	}
+
+	// Store the time of this frame in the window
+	float fTime = (float)(deltaTime * 1000.0);
+	arrSamples[uiTotalFrames % WINDOW_SIZE] = fTime;
+	if ((uiTotalFrames == 0) || (fTime < fSessionMin))
+		fSessionMin = fTime;
+	if ((uiTotalFrames == 0) || (fTime > fSessionMax))
+		fSessionMax = fTime;
+	dTotalTime += fTime;
+	uiTotalFrames++;
+
+	// Count the hitches
+	for (size_t i = 0; i < vHitchCounters.size(); i++)
+	{
+		if (fTime > vHitchCounters[i].dThreshold)
+			vHitchCounters[i].uiCount++;
+	}
 }
 
 // Get the current frame rate
@@ -65,3 +105,165 @@ double CFPSCounter::GetFrameTime(void) const
 {
 	return dFrameTime;
 }
+
+// Get the statistics of the frame times in the window, in milliseconds. The percentiles are nearest-rank.
+CFPSCounter::SStatistics CFPSCounter::GetStatistics(void) const
+{
+	SStatistics sStatistics = { 0, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+	unsigned int uiCount = (uiTotalFrames < WINDOW_SIZE) ? uiTotalFrames : WINDOW_SIZE;
+	if (uiCount == 0)
+		return sStatistics;
+
+	vSorted.assign(arrSamples, arrSamples + uiCount);
+	sort(vSorted.begin(), vSorted.end());
+
+	double dTotal = 0.0;
+	for (unsigned int i = 0; i < uiCount; i++)
+		dTotal += vSorted[i];
+
+	sStatistics.uiCount = uiCount;
+	sStatistics.fMin = vSorted[0];
+	sStatistics.fMax = vSorted[uiCount - 1];
+	sStatistics.fAverage = (float)(dTotal / uiCount);
+	sStatistics.fP50 = vSorted[(uiCount - 1) * 50 / 100];
+	sStatistics.fP95 = vSorted[(uiCount - 1) * 95 / 100];
+	sStatistics.fP99 = vSorted[(uiCount - 1) * 99 / 100];
+	return sStatistics;
+}
+
+// Get the times of the frames in the window, in milliseconds. There are WINDOW_SIZE of them, starting from GetSampleOffset.
+const float* CFPSCounter::GetSamples(void) const
+{
+	return arrSamples;
+}
+
+// Get the index of the oldest frame time in the window
+unsigned int CFPSCounter::GetSampleOffset(void) const
+{
+	return uiTotalFrames % WINDOW_SIZE;
+}
+
+// Get the number of frames since Init
+unsigned int CFPSCounter::GetTotalFrames(void) const
+{
+	return uiTotalFrames;
+}
+
+// Count the frames which take longer than a threshold, in milliseconds
+void CFPSCounter::AddHitchThreshold(const double dThreshold)
+{
+	SHitchCounter sHitchCounter;
+	sHitchCounter.dThreshold = dThreshold;
+	sHitchCounter.uiCount = 0;
+	vHitchCounters.push_back(sHitchCounter);
+}
+
+// Remove the hitch thresholds and their counts
+void CFPSCounter::ClearHitchThresholds(void)
+{
+	vHitchCounters.clear();
+}
+
+// Get the number of hitch thresholds
+unsigned int CFPSCounter::GetNumHitchThresholds(void) const
+{
+	return (unsigned int)vHitchCounters.size();
+}
+
+// Get a hitch threshold, in milliseconds
+double CFPSCounter::GetHitchThreshold(const unsigned int uiIndex) const
+{
+	return vHitchCounters[uiIndex].dThreshold;
+}
+
+// Get the number of frames since Init which took longer than a hitch threshold
+unsigned int CFPSCounter::GetHitchCount(const unsigned int uiIndex) const
+{
+	return vHitchCounters[uiIndex].uiCount;
+}
+
+// Save the statistics and the frame times in the window to a file. A file ending in .json is saved
+// as JSON, and any other file is saved as CSV with one frame time per row.
+bool CFPSCounter::SaveReport(const std::string& filename) const
+{
+	bool bResult;
+	if ((filename.size() >= 5) && (filename.compare(filename.size() - 5, 5, ".json") == 0))
+		bResult = SaveJSON(filename);
+	else
+		bResult = SaveCSV(filename);
+
+	if (bResult == false)
+		cout << "CFPSCounter: Unable to save the frame times to " << filename << endl;
+	return bResult;
+}
+
+// Save the frame times in the window as CSV, from the oldest frame
+bool CFPSCounter::SaveCSV(const std::string& filename) const
+{
+	CBufferedWriter cBufferedWriter;
+	if (cBufferedWriter.Open(filename) == false)
+		return false;
+
+	cBufferedWriter.WriteString("frame,time_ms\n");
+
+	unsigned int uiCount = (uiTotalFrames < WINDOW_SIZE) ? uiTotalFrames : WINDOW_SIZE;
+	unsigned int uiFirstFrame = uiTotalFrames - uiCount;
+	char sBuffer[48];
+	for (unsigned int i = 0; i < uiCount; i++)
+	{
+		unsigned int uiFrame = uiFirstFrame + i;
+		int iLength = snprintf(sBuffer, sizeof(sBuffer), "%u,%.3f\n", uiFrame, arrSamples[uiFrame % WINDOW_SIZE]);
+		if (iLength > 0)
+			cBufferedWriter.WriteBytes(sBuffer, (size_t)iLength);
+	}
+
+	return cBufferedWriter.Close();
+}
+
+// Save the statistics of the session and of the window, the hitch counts and the frame times in the window as JSON
+bool CFPSCounter::SaveJSON(const std::string& filename) const
+{
+	CBufferedWriter cBufferedWriter;
+	if (cBufferedWriter.Open(filename) == false)
+		return false;
+
+	SStatistics sStatistics = GetStatistics();
+	char sBuffer[256];
+	int iLength = snprintf(sBuffer, sizeof(sBuffer),
+						   "{\n\"session\":{\"frames\":%u,\"total_ms\":%.3f,\"min_ms\":%.3f,\"max_ms\":%.3f,\"average_ms\":%.3f},\n",
+						   uiTotalFrames, dTotalTime, fSessionMin, fSessionMax,
+						   (uiTotalFrames > 0) ? dTotalTime / uiTotalFrames : 0.0);
+	if (iLength > 0)
+		cBufferedWriter.WriteBytes(sBuffer, (size_t)iLength);
+
+	iLength = snprintf(sBuffer, sizeof(sBuffer),
+					   "\"window\":{\"frames\":%u,\"min_ms\":%.3f,\"max_ms\":%.3f,\"average_ms\":%.3f,\"p50_ms\":%.3f,\"p95_ms\":%.3f,\"p99_ms\":%.3f},\n",
+					   sStatistics.uiCount, sStatistics.fMin, sStatistics.fMax, sStatistics.fAverage,
+					   sStatistics.fP50, sStatistics.fP95, sStatistics.fP99);
+	if (iLength > 0)
+		cBufferedWriter.WriteBytes(sBuffer, (size_t)iLength);
+
+	cBufferedWriter.WriteString("\"hitches\":[");
+	for (size_t i = 0; i < vHitchCounters.size(); i++)
+	{
+		iLength = snprintf(sBuffer, sizeof(sBuffer), "%s{\"threshold_ms\":%.3f,\"frames\":%u}",
+						   (i > 0) ? "," : "", vHitchCounters[i].dThreshold, vHitchCounters[i].uiCount);
+		if (iLength > 0)
+			cBufferedWriter.WriteBytes(sBuffer, (size_t)iLength);
+	}
+	cBufferedWriter.WriteString("],\n\"frame_times_ms\":[");
+
+	// The frame times are written from the oldest frame
+	unsigned int uiFirstFrame = uiTotalFrames - sStatistics.uiCount;
+	for (unsigned int i = 0; i < sStatistics.uiCount; i++)
+	{
+		unsigned int uiFrame = uiFirstFrame + i;
+		iLength = snprintf(sBuffer, sizeof(sBuffer), "%s%.3f", (i > 0) ? "," : "", arrSamples[uiFrame % WINDOW_SIZE]);
+		if (iLength > 0)
+			cBufferedWriter.WriteBytes(sBuffer, (size_t)iLength);
+	}
+	cBufferedWriter.WriteString("]\n}\n");
+
+	return cBufferedWriter.Close();
+}
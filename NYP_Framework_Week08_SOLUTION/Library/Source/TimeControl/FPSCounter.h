@@ -1,7 +1,18 @@
 /**
-CKeyboardController
+CFPSCounter
 By: Toh Da Jun
 Date: Mar 2020
+
+Counts the frames in each second, and keeps the times of the last WINDOW_SIZE frames in a
+ring buffer to work out the minimum, maximum and percentiles of the frame time. An average
+hides stutter, so a frame which takes longer than a hitch threshold is also counted, over
+the whole session. The statistics can be saved to a CSV or JSON file, e.g. when the game exits.
+
+Usage:
+	cFPSCounter->Init();
+	cFPSCounter->AddHitchThreshold(50.0);		// count the frames longer than 50 ms
+	cFPSCounter->Update(dElapsedTime);			// once per frame, in seconds
+	cFPSCounter->SaveReport("FrameTimes.json");	// or a .csv file
 */
 #pragma once
 
@@ -9,12 +20,28 @@ Date: Mar 2020
 #include "../DesignPatterns/SingletonTemplate.h"
 
 #include <string>
+#include <vector>
 
 class CFPSCounter : public CSingletonTemplate<CFPSCounter>
 {
 	friend CSingletonTemplate<CFPSCounter>;
 
 public:
+	// The number of frames which are kept for the statistics
+	static const unsigned int WINDOW_SIZE = 1024;
+
+	// The statistics of the frame times in the window, in milliseconds
+	struct SStatistics
+	{
+		unsigned int uiCount;
+		float fMin;
+		float fMax;
+		float fAverage;
+		float fP50;
+		float fP95;
+		float fP99;
+	};
+
 	// Destructor
 	virtual ~CFPSCounter(void);
 
@@ -33,7 +60,37 @@ public:
 	// Get the current frame time
 	double GetFrameTime(void) const;
 
+	// Get the statistics of the frame times in the window
+	SStatistics GetStatistics(void) const;
+	// Get the times of the frames in the window, in milliseconds
+	const float* GetSamples(void) const;
+	// Get the index of the oldest frame time in the window
+	unsigned int GetSampleOffset(void) const;
+	// Get the number of frames since Init
+	unsigned int GetTotalFrames(void) const;
+
+	// Count the frames which take longer than a threshold, in milliseconds
+	void AddHitchThreshold(const double dThreshold);
+	// Remove the hitch thresholds and their counts
+	void ClearHitchThresholds(void);
+	// Get the number of hitch thresholds
+	unsigned int GetNumHitchThresholds(void) const;
+	// Get a hitch threshold, in milliseconds
+	double GetHitchThreshold(const unsigned int uiIndex) const;
+	// Get the number of frames since Init which took longer than a hitch threshold
+	unsigned int GetHitchCount(const unsigned int uiIndex) const;
+
+	// Save the statistics and the frame times in the window to a file
+	bool SaveReport(const std::string& filename) const;
+
 protected:
+	// A hitch threshold and the number of frames which took longer
+	struct SHitchCounter
+	{
+		double dThreshold;
+		unsigned int uiCount;
+	};
+
 	// Count the elapsed time since the last reset
 	double dElapsedTime;
 	// Count the number of frames for the current second
@@ -43,6 +100,26 @@ protected:
 	// Count the elapsed time since the last reset
 	double dFrameTime;
 
+	// The times of the last WINDOW_SIZE frames, in milliseconds
+	float arrSamples[WINDOW_SIZE];
+	// The number of frames since Init
+	unsigned int uiTotalFrames;
+	// The total time of the frames since Init, in milliseconds
+	double dTotalTime;
+	// The shortest and the longest frame since Init, in milliseconds
+	float fSessionMin;
+	float fSessionMax;
+	// The hitch thresholds, from the order that they were added
+	std::vector<SHitchCounter> vHitchCounters;
+
+	// Scratch space to sort the frame times for the percentiles
+	mutable std::vector<float> vSorted;
+
+	// Save the frame times in the window as CSV
+	bool SaveCSV(const std::string& filename) const;
+	// Save the statistics and the frame times in the window as JSON
+	bool SaveJSON(const std::string& filename) const;
+
 	// Constructor
 	CFPSCounter(void);
 };
@@ -0,0 +1,319 @@
+/**
+ CProfiler
+ */
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstring>
+
+// The definitions of the constants, as they are bound to references by the conditional operators below
+const unsigned int CProfiler::NUM_SAMPLES;
+const int CProfiler::ROOT;
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CProfiler::CProfiler(void)
+	: uiNumFrames(0)
+	, bInFrame(false)
+	, bEnabled(true)
+{
+	// The first node is the whole frame
+	SNode sRoot;
+	sRoot.sName = "Frame";
+	sRoot.iParent = -1;
+	sRoot.iDepth = 0;
+	sRoot.dTime = 0.0;
+	sRoot.uiCalls = 0;
+	sRoot.fLastTime = 0.0f;
+	sRoot.uiLastCalls = 0;
+	std::fill(sRoot.arrSamples, sRoot.arrSamples + NUM_SAMPLES, 0.0f);
+	vNodes.push_back(sRoot);
+
+	vEvents.reserve(MAX_EVENTS);
+	vLastEvents.reserve(MAX_EVENTS);
+	vSorted.reserve(NUM_SAMPLES);
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CProfiler::~CProfiler(void)
+{
+}
+
+/**
+ @brief Enable or disable the measurements. When they are disabled, the scopes only check this flag.
+ @param bEnabled A const bool which is true to enable the measurements
+ */
+void CProfiler::SetEnabled(const bool bEnabled)
+{
+	// Finish the frame which is being measured, so that no scope is left open
+	if ((bEnabled == false) && bInFrame)
+		EndFrame();
+
+	this->bEnabled = bEnabled;
+}
+
+/**
+ @brief Check if the measurements are enabled
+ */
+bool CProfiler::IsEnabled(void) const
+{
+	return bEnabled;
+}
+
+/**
+ @brief Start a new frame
+ */
+void CProfiler::BeginFrame(void)
+{
+	if (bEnabled == false)
+		return;
+	if (bInFrame)
+		EndFrame();
+
+	vEvents.clear();
+	vStack.clear();
+	tFrameStart = Clock::now();
+	bInFrame = true;
+}
+
+/**
+ @brief End the frame, and store the times of its nodes in the ring buffer
+ */
+void CProfiler::EndFrame(void)
+{
+	if (bInFrame == false)
+		return;
+
+	// Close the scopes which are still open, e.g. if a scope's block was left with a jump
+	while (vStack.empty() == false)
+		End();
+
+	Clock::time_point tFrameEnd = Clock::now();
+	std::chrono::duration<double, std::milli> dFrameTime = tFrameEnd - tFrameStart;
+	vNodes[ROOT].dTime = dFrameTime.count();
+	vNodes[ROOT].uiCalls = 1;
+
+	unsigned int uiSample = uiNumFrames % NUM_SAMPLES;
+	for (size_t i = 0; i < vNodes.size(); i++)
+	{
+		SNode& sNode = vNodes[i];
+		sNode.fLastTime = (float)sNode.dTime;
+		sNode.uiLastCalls = sNode.uiCalls;
+		sNode.arrSamples[uiSample] = sNode.fLastTime;
+		sNode.dTime = 0.0;
+		sNode.uiCalls = 0;
+	}
+
+	vLastEvents.swap(vEvents);
+	uiNumFrames++;
+	bInFrame = false;
+
+	// Record the frame around its scopes
+	CTraceRecorder* cTraceRecorder = CTraceRecorder::GetInstance();
+	if (cTraceRecorder->IsRecording())
+		cTraceRecorder->AddEvent(vNodes[ROOT].sName, tFrameStart, tFrameEnd);
+}
+
+/**
+ @brief Start timing a scope. The scope is a child of the scope which was started last.
+ @param sName A const char* containing the name of the scope. It must not be freed, e.g. a string literal.
+ @return true if the scope is timed and End must be called, else false
+ */
+bool CProfiler::Begin(const char* sName)
+{
+	if ((bEnabled == false) || (bInFrame == false))
+		return false;
+
+	SOpenScope sScope;
+	sScope.iNode = GetChild(vStack.empty() ? ROOT : vStack.back().iNode, sName);
+	sScope.iEvent = -1;
+	sScope.tStart = Clock::now();
+
+	if (vEvents.size() < MAX_EVENTS)
+	{
+		std::chrono::duration<float, std::milli> fStart = sScope.tStart - tFrameStart;
+		SEvent sEvent;
+		sEvent.iNode = sScope.iNode;
+		sEvent.fStart = fStart.count();
+		sEvent.fDuration = 0.0f;
+		sScope.iEvent = (int)vEvents.size();
+		vEvents.push_back(sEvent);
+	}
+
+	vStack.push_back(sScope);
+	return true;
+}
+
+/**
+ @brief Stop timing the last scope which was started
+ */
+void CProfiler::End(void)
+{
+	if (vStack.empty())
+		return;
+
+	const SOpenScope& sScope = vStack.back();
+	std::chrono::duration<double, std::milli> dTime = Clock::now() - sScope.tStart;
+
+	SNode& sNode = vNodes[sScope.iNode];
+	sNode.dTime += dTime.count();
+	sNode.uiCalls++;
+
+	if (sScope.iEvent >= 0)
+		vEvents[sScope.iEvent].fDuration = (float)dTime.count();
+
+	vStack.pop_back();
+}
+
+/**
+ @brief Get the number of nodes
+ */
+int CProfiler::GetNumNodes(void) const
+{
+	return (int)vNodes.size();
+}
+
+/**
+ @brief Get the name of a node
+ @param iNode A const int containing the index of the node
+ */
+const char* CProfiler::GetName(const int iNode) const
+{
+	return vNodes[iNode].sName;
+}
+
+/**
+ @brief Get the depth of a node. The frame is at depth 0.
+ @param iNode A const int containing the index of the node
+ */
+int CProfiler::GetDepth(const int iNode) const
+{
+	return vNodes[iNode].iDepth;
+}
+
+/**
+ @brief Get the children of a node, in the order that they were first timed
+ @param iNode A const int containing the index of the node
+ */
+const std::vector<int>& CProfiler::GetChildren(const int iNode) const
+{
+	return vNodes[iNode].vChildren;
+}
+
+/**
+ @brief Get the time of a node in the last frame, in milliseconds. If it was timed more than once, this is the total.
+ @param iNode A const int containing the index of the node
+ */
+float CProfiler::GetLastTime(const int iNode) const
+{
+	return vNodes[iNode].fLastTime;
+}
+
+/**
+ @brief Get the number of times that a node was timed in the last frame
+ @param iNode A const int containing the index of the node
+ */
+unsigned int CProfiler::GetLastCalls(const int iNode) const
+{
+	return vNodes[iNode].uiLastCalls;
+}
+
+/**
+ @brief Get the statistics of a node over the frames in the ring buffer
+ @param iNode A const int containing the index of the node
+ @return The average, the 50th, 95th and 99th percentiles, and the maximum of the times, in milliseconds
+ */
+CProfiler::SStatistics CProfiler::GetStatistics(const int iNode) const
+{
+	SStatistics sStatistics = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+	unsigned int uiCount = (uiNumFrames < NUM_SAMPLES) ? uiNumFrames : NUM_SAMPLES;
+	if (uiCount == 0)
+		return sStatistics;
+
+	const float* arrSamples = vNodes[iNode].arrSamples;
+	vSorted.assign(arrSamples, arrSamples + uiCount);
+	std::sort(vSorted.begin(), vSorted.end());
+
+	double dTotal = 0.0;
+	for (unsigned int i = 0; i < uiCount; i++)
+		dTotal += vSorted[i];
+
+	// Nearest-rank percentiles
+	sStatistics.fAverage = (float)(dTotal / uiCount);
+	sStatistics.fP50 = vSorted[(uiCount - 1) * 50 / 100];
+	sStatistics.fP95 = vSorted[(uiCount - 1) * 95 / 100];
+	sStatistics.fP99 = vSorted[(uiCount - 1) * 99 / 100];
+	sStatistics.fMax = vSorted[uiCount - 1];
+	return sStatistics;
+}
+
+/**
+ @brief Get the times of a node in the ring buffer, in milliseconds. There are NUM_SAMPLES of them,
+		starting from GetSampleOffset.
+ @param iNode A const int containing the index of the node
+ */
+const float* CProfiler::GetSamples(const int iNode) const
+{
+	return vNodes[iNode].arrSamples;
+}
+
+/**
+ @brief Get the index of the oldest sample in the ring buffer
+ */
+unsigned int CProfiler::GetSampleOffset(void) const
+{
+	return uiNumFrames % NUM_SAMPLES;
+}
+
+/**
+ @brief Get the number of frames which have been measured
+ */
+unsigned int CProfiler::GetNumFrames(void) const
+{
+	return uiNumFrames;
+}
+
+/**
+ @brief Get the scopes of the last frame, in the order that they started
+ */
+const std::vector<CProfiler::SEvent>& CProfiler::GetLastFrameEvents(void) const
+{
+	return vLastEvents;
+}
+
+/**
+ @brief Get the child of a node with a name, and add it if it does not exist
+ @param iParent A const int containing the index of the parent node
+ @param sName A const char* containing the name of the child
+ @return The index of the child node
+ */
+int CProfiler::GetChild(const int iParent, const char* sName)
+{
+	// The names are usually string literals, so the pointers are compared before the strings
+	const std::vector<int>& vChildren = vNodes[iParent].vChildren;
+	for (size_t i = 0; i < vChildren.size(); i++)
+	{
+		const char* sChildName = vNodes[vChildren[i]].sName;
+		if ((sChildName == sName) || (strcmp(sChildName, sName) == 0))
+			return vChildren[i];
+	}
+
+	SNode sNode;
+	sNode.sName = sName;
+	sNode.iParent = iParent;
+	sNode.iDepth = vNodes[iParent].iDepth + 1;
+	sNode.dTime = 0.0;
+	sNode.uiCalls = 0;
+	sNode.fLastTime = 0.0f;
+	sNode.uiLastCalls = 0;
+	std::fill(sNode.arrSamples, sNode.arrSamples + NUM_SAMPLES, 0.0f);
+
+	int iNode = (int)vNodes.size();
+	vNodes.push_back(sNode);
+	vNodes[iParent].vChildren.push_back(iNode);
+	return iNode;
+}
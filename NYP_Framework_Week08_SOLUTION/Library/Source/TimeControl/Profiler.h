@@ -0,0 +1,205 @@
+/**
+ CProfiler
+
+ Measures how long each phase of a frame takes, e.g. updating the entities or rendering the map.
+ A phase is timed with PROFILE_SCOPE, which times the rest of the enclosing block. Scopes inside
+ other scopes become their children, so the phases form a tree with the whole frame at its root.
+ The time of each phase in each of the last NUM_SAMPLES frames is kept in a ring buffer, from which
+ the average, percentiles and maximum are worked out. The scopes of the last frame are also kept
+ in the order that they started, to draw the frame as a timeline.
+
+ Usage:
+	cProfiler->BeginFrame();		// once per frame, at the start
+	{
+		PROFILE_SCOPE("Update");	// the name must be a string literal
+		...
+	}
+	cProfiler->EndFrame();			// once per frame, at the end
+
+ While CTraceRecorder is recording, each scope is also written to its trace file.
+ Define DISABLE_PROFILER to compile the scopes out.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include CTraceRecorder
+#include "TraceRecorder.h"
+
+#include <chrono>
+#include <vector>
+
+class CProfiler : public CSingletonTemplate<CProfiler>
+{
+	friend CSingletonTemplate<CProfiler>;
+public:
+	// The clock which the time is measured with
+	typedef std::chrono::steady_clock Clock;
+
+	// The number of frames which are kept for the statistics
+	static const unsigned int NUM_SAMPLES = 256;
+	// The maximum number of scopes which are kept for the timeline of a frame
+	static const unsigned int MAX_EVENTS = 4096;
+	// The node of the whole frame
+	static const int ROOT = 0;
+
+	// A scope in the last frame
+	struct SEvent
+	{
+		// The node of the scope
+		int iNode;
+		// The time from the start of the frame to the start of the scope, in milliseconds
+		float fStart;
+		// The duration of the scope, in milliseconds
+		float fDuration;
+	};
+
+	// The statistics of a node over the last frames, in milliseconds
+	struct SStatistics
+	{
+		float fAverage;
+		float fP50;
+		float fP95;
+		float fP99;
+		float fMax;
+	};
+
+	// Enable or disable the measurements
+	void SetEnabled(const bool bEnabled);
+	// Check if the measurements are enabled
+	bool IsEnabled(void) const;
+
+	// Start a new frame
+	void BeginFrame(void);
+	// End the frame, and store the times of its nodes
+	void EndFrame(void);
+
+	// Start timing a scope. Returns false if the scope is not timed.
+	bool Begin(const char* sName);
+	// Stop timing the last scope which was started
+	void End(void);
+
+	// Get the number of nodes
+	int GetNumNodes(void) const;
+	// Get the name of a node
+	const char* GetName(const int iNode) const;
+	// Get the depth of a node. The frame is at depth 0.
+	int GetDepth(const int iNode) const;
+	// Get the children of a node, in the order that they were first timed
+	const std::vector<int>& GetChildren(const int iNode) const;
+
+	// Get the time of a node in the last frame, in milliseconds
+	float GetLastTime(const int iNode) const;
+	// Get the number of times that a node was timed in the last frame
+	unsigned int GetLastCalls(const int iNode) const;
+	// Get the statistics of a node over the last frames
+	SStatistics GetStatistics(const int iNode) const;
+	// Get the times of a node in the ring buffer, in milliseconds
+	const float* GetSamples(const int iNode) const;
+	// Get the index of the oldest sample in the ring buffer
+	unsigned int GetSampleOffset(void) const;
+	// Get the number of frames which have been measured
+	unsigned int GetNumFrames(void) const;
+
+	// Get the scopes of the last frame, in the order that they started
+	const std::vector<SEvent>& GetLastFrameEvents(void) const;
+
+protected:
+	// A scope, identified by its name and its parent
+	struct SNode
+	{
+		const char* sName;
+		int iParent;
+		int iDepth;
+		std::vector<int> vChildren;
+
+		// The time and the number of calls in this frame
+		double dTime;
+		unsigned int uiCalls;
+		// The time and the number of calls in the last frame
+		float fLastTime;
+		unsigned int uiLastCalls;
+
+		// The times of the last NUM_SAMPLES frames
+		float arrSamples[NUM_SAMPLES];
+	};
+
+	// A scope which has started but not ended
+	struct SOpenScope
+	{
+		int iNode;
+		int iEvent;
+		Clock::time_point tStart;
+	};
+
+	// The nodes. The frame is the first node.
+	std::vector<SNode> vNodes;
+	// The scopes which are being timed, from the outermost one
+	std::vector<SOpenScope> vStack;
+	// The scopes of this frame and the last frame. The vectors are swapped to reuse their memory.
+	std::vector<SEvent> vEvents;
+	std::vector<SEvent> vLastEvents;
+
+	// The start of this frame
+	Clock::time_point tFrameStart;
+	// The number of frames which have been measured
+	unsigned int uiNumFrames;
+	// Whether a frame has started
+	bool bInFrame;
+	// Whether the measurements are enabled
+	bool bEnabled;
+
+	// Scratch space to sort the samples for the percentiles
+	mutable std::vector<float> vSorted;
+
+	// Get the child of a node with a name, and add it if it does not exist
+	int GetChild(const int iParent, const char* sName);
+
+	// Constructor
+	CProfiler(void);
+
+	// Destructor
+	virtual ~CProfiler(void);
+};
+
+// Times the rest of the enclosing block. Use PROFILE_SCOPE instead of declaring this directly.
+class CProfileScope
+{
+public:
+	// Constructor
+	explicit CProfileScope(const char* sName)
+		: sName(sName)
+		, bActive(CProfiler::GetInstance()->Begin(sName))
+		, bTraced(CTraceRecorder::GetInstance()->IsRecording())
+	{
+		if (bTraced)
+			tStart = CTraceRecorder::Clock::now();
+	}
+
+	// Destructor
+	~CProfileScope(void)
+	{
+		if (bActive)
+			CProfiler::GetInstance()->End();
+		if (bTraced)
+			CTraceRecorder::GetInstance()->AddEvent(sName, tStart, CTraceRecorder::Clock::now());
+	}
+
+protected:
+	// The name of the scope
+	const char* sName;
+	// Whether the scope is being timed
+	bool bActive;
+	// Whether the scope is being recorded, and when it started
+	bool bTraced;
+	CTraceRecorder::Clock::time_point tStart;
+};
+
+#ifndef DISABLE_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) CProfileScope PROFILE_CONCAT(cProfileScope, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name)
+#endif
@@ -1,23 +1,37 @@
 #include "StopWatch.h"
 
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
 #define TARGET_RESOLUTION 1         // 1-millisecond target resolution
 
 /**
 @brief Constructor
 */
 CStopWatch::CStopWatch(void)
+	: dSleepEstimate(5e-3)
+	, dSleepMean(5e-3)
+	, dSleepM2(0.0)
+	, llSleepCount(1)
+	, dLastWakeError(0.0)
+	, dMaxWakeError(0.0)
+	, uiTimerRes(0)
 {
-	QueryPerformanceFrequency(&frequency);
+	prevTime = nextFrameTime = Clock::now();
 
+#ifdef _WIN32
+	// Ask Windows to wake sleeping threads every 1 ms instead of every 15.6 ms
 	TIMECAPS tc;
-
-	if (timeGetDevCaps(&tc, sizeof(TIMECAPS)) != TIMERR_NOERROR)
+	if (timeGetDevCaps(&tc, sizeof(TIMECAPS)) == TIMERR_NOERROR)
 	{
-		// Error; application can't continue.
+		uiTimerRes = min(max(tc.wPeriodMin, TARGET_RESOLUTION), tc.wPeriodMax);
+		timeBeginPeriod(uiTimerRes);
 	}
-
-	wTimerRes = min(max(tc.wPeriodMin, TARGET_RESOLUTION), tc.wPeriodMax);
-	timeBeginPeriod(wTimerRes);
+#endif
 }
 
 /**
@@ -31,9 +45,9 @@ CStopWatch::~CStopWatch(void)
 /**
 @brief Initialise this class instance
 */
-void Init(void)
+void CStopWatch::Init(void)
 {
-
+	ResetWakeErrors();
 }
 
 /**
@@ -41,7 +55,7 @@ void Init(void)
 */ 
 void CStopWatch::StartTimer(void)
 {
-	QueryPerformanceCounter(&prevTime);
+	prevTime = nextFrameTime = Clock::now();
 }
 
 
@@ -50,7 +64,13 @@ void CStopWatch::StartTimer(void)
  */
 void CStopWatch::StopTimer(void)
 {
-	timeEndPeriod(wTimerRes);
+#ifdef _WIN32
+	if (uiTimerRes != 0)
+	{
+		timeEndPeriod(uiTimerRes);
+		uiTimerRes = 0;
+	}
+#endif
 }
 
 /**
@@ -58,37 +78,103 @@ void CStopWatch::StopTimer(void)
  */ 
 double CStopWatch::GetElapsedTime(void)
 {
-	LARGE_INTEGER time;
-	QueryPerformanceCounter(&currTime);
-	time.QuadPart = currTime.QuadPart - prevTime.QuadPart;
+	Clock::time_point currTime = Clock::now();
+	std::chrono::duration<double> time = currTime - prevTime;
 	prevTime = currTime;
-	return LIToSecs(time);
+	return time.count();
 }
 
 /**
  @brief Wait until this time in milliseconds has passed
+ @param llTime A const long long containing the time in milliseconds since the last call to GetElapsedTime
  */
 void CStopWatch::WaitUntil(const long long llTime)
 {
-	LARGE_INTEGER nowTime;
-	LONGLONG timeElapsed;
-	while (true)
+	if (llTime <= 0)
+		return;
+
+	WaitUntilTime(prevTime + std::chrono::milliseconds(llTime));
+}
+
+/**
+ @brief Wait until the next frame is due. The deadlines are dFrameTime apart from StartTimer, so the
+		error of one frame does not add up over the next frames. If a frame took longer than dFrameTime,
+		the next frame starts straight away, and the deadlines restart from now.
+ @param dFrameTime A const double containing the time of a frame in seconds
+ */
+void CStopWatch::WaitForNextFrame(const double dFrameTime)
+{
+	nextFrameTime += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(dFrameTime));
+
+	Clock::time_point now = Clock::now();
+	if (nextFrameTime <= now)
 	{
-		QueryPerformanceCounter(&nowTime);
-		timeElapsed = ((nowTime.QuadPart - prevTime.QuadPart) * 1000 / frequency.QuadPart);
-		if (timeElapsed > llTime)
-			return;
-		else if (llTime - timeElapsed > 1)
-			Sleep(1);
+		nextFrameTime = now;
+		dLastWakeError = 0.0;
+		return;
 	}
+
+	WaitUntilTime(nextFrameTime);
+}
+
+/**
+ @brief Get how late the last wait woke up
+ @return The time in seconds between the deadline and the end of the last wait
+ */
+double CStopWatch::GetLastWakeError(void) const
+{
+	return dLastWakeError;
+}
+
+/**
+ @brief Get how late the latest wait woke up since ResetWakeErrors
+ @return The largest time in seconds between a deadline and the end of its wait
+ */
+double CStopWatch::GetMaxWakeError(void) const
+{
+	return dMaxWakeError;
 }
 
 /**
- @brief Convert from Large Integer to seconds in double
- @param L A LARGE_INTEGER & containing the time value
- @return The time in seconds unit and in double data type
+ @brief Reset the wake-up errors
  */
-double CStopWatch::LIToSecs(LARGE_INTEGER & L)
+void CStopWatch::ResetWakeErrors(void)
 {
-	return ((double)L.QuadPart / (double)frequency.QuadPart);
+	dLastWakeError = 0.0;
+	dMaxWakeError = 0.0;
+}
+
+/**
+ @brief Sleep in steps of 1 ms while there is more time left than a sleep is expected to take,
+		then spin until the deadline. The expected time of a sleep is learnt from the sleeps so far.
+ @param deadline A const Clock::time_point& containing the time to wait until
+ */
+void CStopWatch::WaitUntilTime(const Clock::time_point& deadline)
+{
+	while (true)
+	{
+		Clock::time_point start = Clock::now();
+		std::chrono::duration<double> remaining = deadline - start;
+		if (remaining.count() <= dSleepEstimate)
+			break;
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(TARGET_RESOLUTION));
+
+		// Update the mean and standard deviation of the sleep time with Welford's method
+		std::chrono::duration<double> observed = Clock::now() - start;
+		++llSleepCount;
+		double dDelta = observed.count() - dSleepMean;
+		dSleepMean += dDelta / llSleepCount;
+		dSleepM2 += dDelta * (observed.count() - dSleepMean);
+		dSleepEstimate = dSleepMean + std::sqrt(dSleepM2 / (llSleepCount - 1));
+	}
+
+	// Spin for the rest of the time, letting other threads run
+	while (Clock::now() < deadline)
+		std::this_thread::yield();
+
+	std::chrono::duration<double> error = Clock::now() - deadline;
+	dLastWakeError = error.count();
+	if (dLastWakeError > dMaxWakeError)
+		dMaxWakeError = dLastWakeError;
 }
@@ -2,14 +2,22 @@
  CStopWatch
  By: Toh Da Jun
  Date: Mar 2020
+
+ Measures the time between frames with std::chrono::steady_clock, and paces the frames.
+ WaitForNextFrame sleeps until shortly before the next frame is due, then spins for the
+ last part, so that the deadline is met closely without keeping a core busy. The time which
+ is left for spinning is estimated from how late the recent sleeps woke up.
  */
 #pragma once
 
-#include <windows.h>
+#include <chrono>
 
 class CStopWatch
 {
 public:
+	// The clock which the time is measured with
+	typedef std::chrono::steady_clock Clock;
+
 	// Constructor
 	CStopWatch(void);
 
@@ -31,11 +39,36 @@ public:
 	// Wait until this time in milliseconds has passed
 	void WaitUntil(const long long llTime);
 
+	// Wait until the next frame is due, where the frames are dFrameTime seconds apart
+	void WaitForNextFrame(const double dFrameTime);
+
+	// Get how late the last wait woke up, in seconds
+	double GetLastWakeError(void) const;
+	// Get how late the latest wait woke up since ResetWakeErrors, in seconds
+	double GetMaxWakeError(void) const;
+	// Reset the wake-up errors
+	void ResetWakeErrors(void);
+
 protected:
-	LARGE_INTEGER frequency;
-	LARGE_INTEGER prevTime, currTime;
-	UINT     wTimerRes;
+	// The time of the last call to StartTimer or GetElapsedTime
+	Clock::time_point prevTime;
+	// The time when the next frame is due
+	Clock::time_point nextFrameTime;
+
+	// The estimated time that a 1 ms sleep takes, which is the mean plus one standard deviation
+	double dSleepEstimate;
+	// The running mean and sum of squared differences of the sleep times
+	double dSleepMean;
+	double dSleepM2;
+	long long llSleepCount;
+
+	// How late the waits woke up, in seconds
+	double dLastWakeError;
+	double dMaxWakeError;
+
+	// The timer resolution which was requested from Windows, in ms, or 0 if none
+	unsigned int uiTimerRes;
 
-	// Convert from Large Integer to seconds in double
-	double LIToSecs(LARGE_INTEGER & L);
+	// Sleep and then spin until a time
+	void WaitUntilTime(const Clock::time_point& deadline);
 };
@@ -0,0 +1,137 @@
+/**
+ CTraceRecorder
+ */
+#include "TraceRecorder.h"
+
+#include <cstdio>
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CTraceRecorder::CTraceRecorder(void)
+	: tEpoch(Clock::now())
+	, uiNumEvents(0)
+	, bRecording(false)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CTraceRecorder::~CTraceRecorder(void)
+{
+	Stop();
+}
+
+/**
+ @brief Start recording into a file. A recording which is in progress is stopped first.
+ @param filename A const std::string& containing the name of the file
+ @return true if the file was opened, else false
+ */
+bool CTraceRecorder::Start(const std::string& filename)
+{
+	Stop();
+
+	if (cBufferedWriter.Open(filename, BUFFER_SIZE, true) == false)
+	{
+		cout << "CTraceRecorder: Unable to open " << filename << endl;
+		return false;
+	}
+
+	sFilename = filename;
+	uiNumEvents = 0;
+
+	// The game runs on one thread, so all the events are on thread 1 of process 1
+	cBufferedWriter.WriteString("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	cBufferedWriter.WriteString("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"NYP Framework\"}},\n");
+	cBufferedWriter.WriteString("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Main\"}}");
+
+	bRecording = true;
+	cout << "CTraceRecorder: Recording to " << sFilename << endl;
+	return true;
+}
+
+/**
+ @brief Stop recording and complete the file
+ @return true if the file was written, else false
+ */
+bool CTraceRecorder::Stop(void)
+{
+	if (bRecording == false)
+		return false;
+
+	bRecording = false;
+	cBufferedWriter.WriteString("\n]}\n");
+	bool bResult = cBufferedWriter.Close();
+
+	cout << "CTraceRecorder: Recorded " << uiNumEvents << " events to " << sFilename << endl;
+	return bResult;
+}
+
+/**
+ @brief Record a scope which has ended
+ @param sName A const char* containing the name of the scope
+ @param tStart A const Clock::time_point containing the time that the scope started
+ @param tEnd A const Clock::time_point containing the time that the scope ended
+ */
+void CTraceRecorder::AddEvent(const char* sName, const Clock::time_point tStart, const Clock::time_point tEnd)
+{
+	if (bRecording == false)
+		return;
+
+	std::chrono::duration<double, std::micro> dStart = tStart - tEpoch;
+	std::chrono::duration<double, std::micro> dDuration = tEnd - tStart;
+
+	cBufferedWriter.WriteString(",\n{\"name\":");
+	WriteJSONString(sName);
+
+	char sBuffer[96];
+	int iLength = snprintf(sBuffer, sizeof(sBuffer), ",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+						   dStart.count(), dDuration.count());
+	if (iLength > 0)
+		cBufferedWriter.WriteBytes(sBuffer, (size_t)iLength);
+
+	uiNumEvents++;
+}
+
+/**
+ @brief Get the name of the file which is being recorded into, or which was recorded into last
+ */
+const std::string& CTraceRecorder::GetFilename(void) const
+{
+	return sFilename;
+}
+
+/**
+ @brief Get the number of events which have been recorded into the file
+ */
+unsigned int CTraceRecorder::GetNumEvents(void) const
+{
+	return uiNumEvents;
+}
+
+/**
+ @brief Append a string to the file as a JSON string, with quotes, backslashes and control characters escaped
+ @param sValue A const char* containing the string
+ */
+void CTraceRecorder::WriteJSONString(const char* sValue)
+{
+	cBufferedWriter.WriteChar('"');
+	for (const char* pChar = sValue; *pChar != '\0'; pChar++)
+	{
+		if ((unsigned char)*pChar < 0x20)
+		{
+			// JSON strings cannot contain control characters, so write their code instead
+			char sEscape[8];
+			int iLength = snprintf(sEscape, sizeof(sEscape), "\\u%04x", (unsigned int)(unsigned char)*pChar);
+			cBufferedWriter.WriteBytes(sEscape, (size_t)iLength);
+			continue;
+		}
+		if ((*pChar == '"') || (*pChar == '\\'))
+			cBufferedWriter.WriteChar('\\');
+		cBufferedWriter.WriteChar(*pChar);
+	}
+	cBufferedWriter.WriteChar('"');
+}
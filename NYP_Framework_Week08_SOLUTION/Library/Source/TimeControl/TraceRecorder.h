@@ -0,0 +1,78 @@
+/**
+ CTraceRecorder
+
+ Records the scopes marked with PROFILE_SCOPE into a file in the Chrome trace event format,
+ which can be opened in chrome://tracing or https://ui.perfetto.dev to look at a session later.
+ Each scope is written as a complete ("X") event with its start time and duration in microseconds.
+ Unlike CProfiler, the recorder also records the scopes outside of the frames, e.g. loading the maps.
+
+ The recording is started and stopped at runtime. While it is stopped, a scope only checks
+ IsRecording. While it is recording, the events are formatted into a buffer which is written
+ to the file whenever it is full, so a session of any length can be recorded.
+
+ Usage:
+	cTraceRecorder->Start("trace.json");
+	...									// the scopes are recorded
+	cTraceRecorder->Stop();				// completes the file
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include CBufferedWriter
+#include "../System/BufferedWriter.h"
+
+#include <chrono>
+#include <string>
+
+class CTraceRecorder : public CSingletonTemplate<CTraceRecorder>
+{
+	friend CSingletonTemplate<CTraceRecorder>;
+public:
+	// The clock which the time is measured with
+	typedef std::chrono::steady_clock Clock;
+
+	// The size of the buffer which the events are formatted into, in bytes
+	static const size_t BUFFER_SIZE = 1024 * 1024;
+
+	// Start recording into a file
+	bool Start(const std::string& filename);
+	// Stop recording and complete the file
+	bool Stop(void);
+
+	// Check if the scopes are being recorded
+	bool IsRecording(void) const
+	{
+		return bRecording;
+	}
+
+	// Record a scope which has ended
+	void AddEvent(const char* sName, const Clock::time_point tStart, const Clock::time_point tEnd);
+
+	// Get the name of the file which is being recorded into, or which was recorded into last
+	const std::string& GetFilename(void) const;
+	// Get the number of events which have been recorded into the file
+	unsigned int GetNumEvents(void) const;
+
+protected:
+	// The output file
+	CBufferedWriter cBufferedWriter;
+	// The name of the output file
+	std::string sFilename;
+	// The time which the time stamps are measured from
+	Clock::time_point tEpoch;
+	// The number of events in the file
+	unsigned int uiNumEvents;
+	// Whether the scopes are being recorded
+	bool bRecording;
+
+	// Append a string to the file as a JSON string
+	void WriteJSONString(const char* sValue);
+
+	// Constructor
+	CTraceRecorder(void);
+
+	// Destructor
+	virtual ~CTraceRecorder(void);
+};